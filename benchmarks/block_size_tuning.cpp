@@ -0,0 +1,109 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE block_size_tuning_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <mp++/integer.hpp>
+
+#include <piranha/kronecker_monomial.hpp>
+#include <piranha/monomial.hpp>
+#include <piranha/polynomial.hpp>
+#include <piranha/rational.hpp>
+#include <piranha/settings.hpp>
+#include <piranha/tuning.hpp>
+
+using namespace piranha;
+
+// Autotuning of the multiplication block size. For a few combinations of coefficient and key types,
+// compute f * (f+1), where f = (1+x+y+z+t)**12, with all the admissible power-of-two block sizes
+// and with the automatic tiling, and report the best block size found on the host. The optional first
+// command-line argument sets the number of threads.
+
+// Best timing (in ms) of a few runs of the multiplication.
+template <typename PType>
+static inline long long best_timing(const PType &f, const PType &g)
+{
+    long long retval = std::numeric_limits<long long>::max();
+    for (int i = 0; i < 3; ++i) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        const auto res = f * g;
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start)
+                  .count();
+        BOOST_CHECK_EQUAL(res.size(), 20475u);
+        retval = std::min<long long>(retval, elapsed);
+    }
+    return retval;
+}
+
+template <typename Cf, typename Key>
+static inline void tune(const std::string &name)
+{
+    using p_type = polynomial<Cf, Key>;
+    p_type x("x"), y("y"), z("z"), t("t");
+    const auto f = (x + y + z + t + 1).pow(12);
+    const auto g = f + 1;
+    std::cout << name << ":\n";
+    std::pair<unsigned long, long long> best(0u, std::numeric_limits<long long>::max());
+    for (unsigned long bsize = 16u; bsize <= 4096u; bsize *= 2u) {
+        tuning::set_multiplication_block_size(bsize);
+        const auto timing = best_timing(f, g);
+        std::cout << "  block size " << bsize << ": " << timing << "ms\n";
+        if (timing < best.second) {
+            best = std::make_pair(bsize, timing);
+        }
+    }
+    tuning::reset_multiplication_block_size();
+    std::cout << "  automatic tiling: " << best_timing(f, g) << "ms\n";
+    std::cout << "  best block size: " << best.first << " (" << best.second << "ms)\n";
+}
+
+BOOST_AUTO_TEST_CASE(block_size_tuning_test)
+{
+    settings::set_thread_binding(true);
+    if (boost::unit_test::framework::master_test_suite().argc > 1) {
+        settings::set_n_threads(
+            boost::lexical_cast<unsigned>(boost::unit_test::framework::master_test_suite().argv[1u]));
+    }
+    tune<mppp::integer<1>, kronecker_monomial<>>("integer, kronecker_monomial");
+    tune<mppp::integer<1>, monomial<signed char>>("integer, monomial");
+    tune<rational, kronecker_monomial<>>("rational, kronecker_monomial");
+    tune<double, kronecker_monomial<>>("double, kronecker_monomial");
+    tune<double, monomial<signed char>>("double, monomial");
+}
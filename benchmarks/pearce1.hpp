@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PIRANHA_PEARCE1_HPP
 
 #include <piranha/polynomial.hpp>
+#include <piranha/series_multiplier.hpp>
 
 #include "simple_timer.hpp"
 
@@ -59,6 +60,27 @@ inline polynomial<Cf, Key> pearce1(unsigned long long factor = 1u)
         return f * g;
     }
 }
+
+// Same as above, but using the heap-based multiplication.
+template <typename Cf, typename Key>
+inline polynomial<Cf, Key> pearce1_heap()
+{
+    typedef polynomial<Cf, Key> p_type;
+    p_type x("x"), y("y"), z("z"), t("t"), u("u");
+
+    auto f = (x + y + z * z * 2 + t * t * t * 3 + u * u * u * u * u * 5 + 1);
+    auto tmp_f(f);
+    auto g = (u + t + z * z * 2 + y * y * y * 3 + x * x * x * x * x * 5 + 1);
+    auto tmp_g(g);
+    for (int i = 1; i < 12; ++i) {
+        f *= tmp_f;
+        g *= tmp_g;
+    }
+    {
+        simple_timer t;
+        return series_multiplier<p_type>(f, g)._heap_multiplication();
+    }
+}
 }
 
 #endif
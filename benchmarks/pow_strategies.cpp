@@ -0,0 +1,115 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE pow_strategies_test
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include <boost/lexical_cast.hpp>
+
+#include <mp++/integer.hpp>
+
+#include <piranha/kronecker_monomial.hpp>
+#include <piranha/monomial.hpp>
+#include <piranha/polynomial.hpp>
+#include <piranha/rational.hpp>
+#include <piranha/settings.hpp>
+#include <piranha/tuning.hpp>
+
+using namespace piranha;
+
+// Comparison of the exponentiation strategies. For a few combinations of coefficient and key types,
+// compute (1+x+y+z+t)**n for increasing values of n with each strategy, starting from an empty cache
+// of natural powers, and report the timings. The optional first command-line argument sets the number of threads.
+
+// Number of terms of (1+x+y+z+t)**n, i.e., binomial(n+4,4).
+static inline std::size_t n_terms(std::size_t n)
+{
+    return (n + 1u) * (n + 2u) * (n + 3u) * (n + 4u) / 24u;
+}
+
+// Best timing (in ms) of a few runs of the exponentiation.
+template <typename PType>
+static inline long long best_timing(const PType &f, unsigned n)
+{
+    long long retval = std::numeric_limits<long long>::max();
+    for (int i = 0; i < 3; ++i) {
+        PType::clear_pow_cache();
+        const auto start = std::chrono::high_resolution_clock::now();
+        const auto res = f.pow(n);
+        const auto elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start)
+                  .count();
+        BOOST_CHECK_EQUAL(res.size(), n_terms(n));
+        retval = std::min<long long>(retval, elapsed);
+    }
+    return retval;
+}
+
+template <typename Cf, typename Key>
+static inline void compare(const std::string &name)
+{
+    using p_type = polynomial<Cf, Key>;
+    p_type x("x"), y("y"), z("z"), t("t");
+    const auto f = x + y + z + t + 1;
+    const std::pair<pow_strategy, std::string> strategies[] = {{pow_strategy::cached, "cached"},
+                                                               {pow_strategy::binary, "binary"},
+                                                               {pow_strategy::multinomial, "multinomial"},
+                                                               {pow_strategy::automatic, "automatic"}};
+    std::cout << name << ":\n";
+    for (unsigned n = 5u; n <= 30u; n += 5u) {
+        std::cout << "  n = " << n << ":";
+        for (const auto &s : strategies) {
+            tuning::set_pow_strategy(s.first);
+            std::cout << ' ' << s.second << ' ' << best_timing(f, n) << "ms";
+        }
+        std::cout << '\n';
+    }
+    tuning::reset_pow_strategy();
+    p_type::clear_pow_cache();
+}
+
+BOOST_AUTO_TEST_CASE(pow_strategies_test)
+{
+    settings::set_thread_binding(true);
+    if (boost::unit_test::framework::master_test_suite().argc > 1) {
+        settings::set_n_threads(
+            boost::lexical_cast<unsigned>(boost::unit_test::framework::master_test_suite().argv[1u]));
+    }
+    compare<mppp::integer<1>, kronecker_monomial<>>("integer, kronecker_monomial");
+    compare<mppp::integer<1>, monomial<signed char>>("integer, monomial");
+    compare<rational, kronecker_monomial<>>("rational, kronecker_monomial");
+    compare<double, kronecker_monomial<>>("double, kronecker_monomial");
+}
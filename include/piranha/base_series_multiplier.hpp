@@ -48,8 +48,9 @@ see https://www.gnu.org/licenses/. */
 
 #include <piranha/config.hpp>
 #include <piranha/detail/atomic_flag_array.hpp>
-#include <piranha/detail/atomic_lock_guard.hpp>
+#include <piranha/detail/cf_recycler.hpp>
 #include <piranha/detail/init.hpp>
+#include <piranha/estimation_log.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/key_is_multipliable.hpp>
@@ -57,6 +58,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/math/gcd3.hpp>
 #include <piranha/math/is_one.hpp>
 #include <piranha/rational.hpp>
+#include <piranha/runtime_info.hpp>
 #include <piranha/safe_cast.hpp>
 #include <piranha/series.hpp>
 #include <piranha/settings.hpp>
@@ -71,6 +73,41 @@ namespace piranha
 namespace detail
 {
 
+// A small cache mapping the sizes and the hashes of the keys of the operands of a series multiplication
+// to the actual size of the result. When full, the oldest entry is evicted.
+struct series_size_cache {
+    using key_type = std::array<std::size_t, 4u>;
+    // NOTE: this is a tuning parameter. The lookup is linear, so this should be kept small.
+    static const std::size_t max_size = 64u;
+    bool find(const key_type &k, std::size_t &out)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                                     [&k](const std::pair<key_type, std::size_t> &p) { return p.first == k; });
+        if (it == m_entries.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+    void insert(const key_type &k, std::size_t value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                                     [&k](const std::pair<key_type, std::size_t> &p) { return p.first == k; });
+        if (it != m_entries.end()) {
+            it->second = value;
+            return;
+        }
+        if (m_entries.size() == max_size) {
+            m_entries.erase(m_entries.begin());
+        }
+        m_entries.emplace_back(k, value);
+    }
+    std::mutex m_mutex;
+    std::vector<std::pair<key_type, std::size_t>> m_entries;
+};
+
 template <typename Series, typename Derived, typename = void>
 struct base_series_multiplier_impl {
     using term_type = typename Series::term_type;
@@ -165,35 +202,30 @@ struct base_series_multiplier_impl<
     void fill_term_pointers(const container_type &c1, const container_type &c2, std::vector<term_type const *> &v1,
                             std::vector<term_type const *> &v2)
     {
-        // Compute the least common multiplier.
-        m_lcm = 1;
-        auto it_f = c1.end();
-        int_type g;
-        for (auto it = c1.begin(); it != it_f; ++it) {
-            piranha::gcd3(g, m_lcm, it->m_cf.get_den());
-            math::mul3(m_lcm, m_lcm, it->m_cf.get_den());
-            divexact(m_lcm, m_lcm, g);
-        }
-        it_f = c2.end();
-        for (auto it = c2.begin(); it != it_f; ++it) {
-            piranha::gcd3(g, m_lcm, it->m_cf.get_den());
-            math::mul3(m_lcm, m_lcm, it->m_cf.get_den());
-            divexact(m_lcm, m_lcm, g);
-        }
-        // Double check that the gcd is positive.
-        piranha_assert(m_lcm.sgn() == 1);
-        // Copy over the terms and renormalise to lcm.
-        it_f = c1.end();
-        for (auto it = c1.begin(); it != it_f; ++it) {
-            // NOTE: these divisions are exact, we could take advantage of that.
-            m_terms1.push_back(
-                term_type(rat_type(m_lcm / it->m_cf.get_den() * it->m_cf.get_num(), int_type(1)), it->m_key));
-        }
-        it_f = c2.end();
-        for (auto it = c2.begin(); it != it_f; ++it) {
-            m_terms2.push_back(
-                term_type(rat_type(m_lcm / it->m_cf.get_den() * it->m_cf.get_num(), int_type(1)), it->m_key));
-        }
+        // Lift the coefficients of an operand to integral values: compute the least common multiplier of the
+        // denominators, and copy over the terms renormalised to it.
+        auto lift = [](const container_type &c, std::vector<term_type> &terms) {
+            int_type lcm(1), g;
+            const auto it_f = c.end();
+            for (auto it = c.begin(); it != it_f; ++it) {
+                piranha::gcd3(g, lcm, it->m_cf.get_den());
+                math::mul3(lcm, lcm, it->m_cf.get_den());
+                divexact(lcm, lcm, g);
+            }
+            // Double check that the lcm is positive.
+            piranha_assert(lcm.sgn() == 1);
+            terms.reserve(c.size());
+            for (auto it = c.begin(); it != it_f; ++it) {
+                // NOTE: these divisions are exact, we could take advantage of that.
+                terms.push_back(
+                    term_type(rat_type(lcm / it->m_cf.get_den() * it->m_cf.get_num(), int_type(1)), it->m_key));
+            }
+            return lcm;
+        };
+        // NOTE: each operand is lifted by its own lcm, so that the common denominator of the product
+        // is the product of the two lcms.
+        m_lcm = lift(c1, m_terms1);
+        math::mul3(m_lcm, m_lcm, lift(c2, m_terms2));
         // Copy over the pointers.
         std::transform(m_terms1.begin(), m_terms1.end(), std::back_inserter(v1), [](const term_type &t) { return &t; });
         std::transform(m_terms2.begin(), m_terms2.end(), std::back_inserter(v2), [](const term_type &t) { return &t; });
@@ -271,6 +303,201 @@ private:
     {
         return Term{std::move(t.m_cf), t.m_key};
     }
+    // Multiply the two series into retval, inserting only the terms for which filter returns true. retval
+    // is expected to be already rehashed, and the terms are inserted via the low-level interface of hash_set. In
+    // multithreaded mode, the buckets of retval are protected by spinlocks. retval will have to be sanitised
+    // afterwards, and it must be cleared in case of errors.
+    template <typename LimitFunctor, typename Filter>
+    void filtered_multiplication(Series &retval, const LimitFunctor &lf, const Filter &filter) const
+    {
+        using term_type = typename Series::term_type;
+        using key_type = typename term_type::key_type;
+        const size_type n_threads = piranha::safe_cast<size_type>(m_n_threads);
+        if (n_threads == 1u) {
+            std::array<term_type, key_type::multiply_arity> tmp_t;
+            typename container_type::template _pipeline<cf_adder> pipeline(
+                retval._container(), cf_adder{},
+                piranha::safe_cast<bucket_size_type>(tuning::get_prefetch_distance()));
+            auto f = [&tmp_t, this, &pipeline, &retval, &filter](const size_type &i, const size_type &j) {
+                key_type::multiply(tmp_t, *(this->m_v1[i]), *(this->m_v2[j]), retval.get_symbol_set());
+                for (std::size_t n = 0u; n < key_type::multiply_arity; ++n) {
+                    auto &tmp_term = tmp_t[n];
+                    if (!filter(tmp_term)) {
+                        continue;
+                    }
+                    // NOTE: move the term into the ring buffer of the pipeline, tmp_term will be
+                    // overwritten by the next multiplication.
+                    pipeline.push(std::move(term_insertion(tmp_term)));
+                }
+            };
+            blocked_multiplication(f, 0u, m_v1.size(), lf);
+            pipeline.flush();
+            return;
+        }
+        // Init the vector of spinlocks.
+        detail::atomic_flag_array sl_array(n_bucket_locks(retval._container().bucket_count()));
+        // Init the future list.
+        future_list<void> f_list;
+        // Thread block size.
+        const auto block_size = m_v1.size() / n_threads;
+        try {
+            for (size_type idx = 0u; idx < n_threads; ++idx) {
+                // Thread functor.
+                auto tf = [idx, this, block_size, n_threads, &sl_array, &retval, &lf, &filter]() {
+                    // Used to store the result of term multiplication.
+                    std::array<term_type, key_type::multiply_arity> tmp_t;
+                    // Block functor.
+                    // NOTE: this is very similar to the plain functor, but it uses the concurrent
+                    // insertion of hash_set.
+                    auto f = [&tmp_t, this, &retval, &sl_array, &filter](const size_type &i, const size_type &j) {
+                        // Run the term multiplication.
+                        key_type::multiply(tmp_t, *(this->m_v1[i]), *(this->m_v2[j]), retval.get_symbol_set());
+                        for (std::size_t n = 0u; n < key_type::multiply_arity; ++n) {
+                            auto &container = retval._container();
+                            auto &tmp_term = tmp_t[n];
+                            if (!filter(tmp_term)) {
+                                continue;
+                            }
+                            const auto bucket_idx = container._bucket(tmp_term);
+                            container._concurrent_insert(term_insertion(tmp_term), bucket_idx, sl_array, cf_adder{});
+                        }
+                    };
+                    // Thread block limit.
+                    const auto e1
+                        = (idx == n_threads - 1u) ? this->m_v1.size() : static_cast<size_type>((idx + 1u) * block_size);
+                    this->blocked_multiplication(f, static_cast<size_type>(idx * block_size), e1, lf);
+                };
+                f_list.push_back(thread_pool::enqueue(static_cast<unsigned>(idx), tf));
+            }
+            f_list.wait_all();
+            f_list.get_all();
+        } catch (...) {
+            f_list.wait_all();
+            throw;
+        }
+    }
+    // Accumulate the coefficient of a term into an equivalent term already present in a series.
+    struct cf_adder {
+        template <typename Term>
+        void operator()(const Term &t, const Term &other) const
+        {
+            t.m_cf += other.m_cf;
+        }
+    };
+    // Number of spinlocks protecting the buckets of a container with b_count buckets during concurrent
+    // insertions. Each spinlock protects all the buckets whose index is congruent to the spinlock index
+    // modulo the number of spinlocks.
+    // NOTE: the maximum number of spinlocks is a tuning parameter.
+    static std::size_t n_bucket_locks(const bucket_size_type &b_count)
+    {
+        const std::size_t max_locks = std::size_t(1u) << 16u;
+        // NOTE: the bucket count of a hash_set is a power of two.
+        piranha_assert(b_count && !(b_count & (b_count - 1u)));
+        return b_count < max_locks ? static_cast<std::size_t>(b_count) : max_locks;
+    }
+    // Move the terms of chunk into retval, using the concurrent insertion of hash_set in multithreaded mode.
+    // The terms in chunk must not be present in retval.
+    void move_chunk(Series &retval, Series &chunk) const
+    {
+        using term_type = typename Series::term_type;
+        auto &r_container = retval._container();
+        auto &c_container = chunk._container();
+        if (!c_container.size()) {
+            return;
+        }
+        if (unlikely(c_container.size() > std::numeric_limits<bucket_size_type>::max() - r_container.size())) {
+            piranha_throw(std::overflow_error, "overflow error in the number of terms of a series");
+        }
+        const auto new_size = static_cast<bucket_size_type>(r_container.size() + c_container.size());
+        // Make room in retval for the new terms.
+        const auto n_buckets = boost::numeric_cast<bucket_size_type>(
+            std::ceil(static_cast<double>(new_size) / r_container.max_load_factor()));
+        if (n_buckets > r_container.bucket_count()) {
+            r_container.rehash(n_buckets, tuning::get_parallel_memory_set() ? m_n_threads : 1u);
+        }
+        const auto c_count = c_container.bucket_count();
+        const unsigned n_threads = c_count < m_n_threads ? 1u : m_n_threads;
+        detail::atomic_flag_array sl_array(n_bucket_locks(r_container.bucket_count()));
+        auto mover = [&r_container, &c_container, &sl_array](const bucket_size_type &start,
+                                                             const bucket_size_type &end) {
+            for (auto i = start; i != end; ++i) {
+                for (const auto &t : c_container._get_bucket_list(i)) {
+                    term_type tmp_term{std::move(t.m_cf), t.m_key};
+                    const auto bucket_idx = r_container._bucket(tmp_term);
+                    const bool inserted = r_container._concurrent_insert(std::move(tmp_term), bucket_idx, sl_array,
+                                                                         cf_adder{});
+                    piranha_assert(inserted);
+                    (void)inserted;
+                }
+            }
+        };
+        if (n_threads == 1u) {
+            mover(0u, c_count);
+        } else {
+            future_list<void> f_list;
+            try {
+                for (unsigned i = 0u; i < n_threads; ++i) {
+                    const auto start = static_cast<bucket_size_type>((c_count / n_threads) * i),
+                               end = static_cast<bucket_size_type>(
+                                   (i == n_threads - 1u) ? c_count : (c_count / n_threads) * (i + 1u));
+                    f_list.push_back(thread_pool::enqueue(i, mover, start, end));
+                }
+                // First let's wait for everything to finish.
+                f_list.wait_all();
+                // Then, let's handle the exceptions.
+                f_list.get_all();
+            } catch (...) {
+                f_list.wait_all();
+                throw;
+            }
+        }
+        r_container._update_size(new_size);
+    }
+    // Chunked mode for plain_multiplication(): the output hash space is partitioned into n_chunks ranges
+    // according to the hash values of the terms, and each range is computed into its own container (sized
+    // for n_buckets / n_chunks buckets), sanitised and then moved into retval. Terms with the same key
+    // have the same hash value, thus the chunks never overlap.
+    // NOTE: the hash value of a product is known only after the term-by-term multiplication, so each chunk
+    // performs all the term-by-term multiplications and keeps only the products in its range. The chunked mode
+    // thus reduces the peak memory usage by a factor of n_chunks at the price of n_chunks times the cost of
+    // the term-by-term multiplications.
+    template <typename LimitFunctor>
+    Series chunked_multiplication(const LimitFunctor &lf, const bucket_size_type &n_buckets,
+                                  const bucket_size_type &n_chunks) const
+    {
+        using term_type = typename Series::term_type;
+        piranha_assert(n_chunks > 1u);
+        Series retval;
+        retval.set_symbol_set(m_ss);
+        setup_node_arena(retval);
+        const unsigned n_threads_rehash = tuning::get_parallel_memory_set() ? m_n_threads : 1u;
+        const auto chunk_n_buckets = static_cast<bucket_size_type>(n_buckets / n_chunks + 1u);
+        try {
+            for (bucket_size_type c = 0u; c < n_chunks; ++c) {
+                Series chunk;
+                chunk.set_symbol_set(m_ss);
+                auto &c_container = chunk._container();
+                try {
+                    c_container.rehash(chunk_n_buckets, n_threads_rehash);
+                    filtered_multiplication(chunk, lf, [c, n_chunks](const term_type &t) {
+                        return static_cast<bucket_size_type>(t.hash() % n_chunks) == c;
+                    });
+                    sanitise_series(chunk, m_n_threads);
+                    move_chunk(retval, chunk);
+                    // The chunk must always be cleared, since we moved out the terms.
+                    c_container.clear();
+                } catch (...) {
+                    c_container.clear();
+                    throw;
+                }
+            }
+            finalise_series(retval);
+        } catch (...) {
+            retval._container().clear();
+            throw;
+        }
+        return retval;
+    }
     // Implementation of finalise().
     template <typename T,
               typename std::enable_if<mppp::is_rational<typename T::term_type::cf_type>::value, int>::type = 0>
@@ -280,9 +507,8 @@ private:
         if (piranha::is_one(this->m_lcm)) {
             return;
         }
-        // NOTE: this has to be the square of the lcm, as in addition to uniformising
-        // the denominators in each series we are also multiplying the two series.
-        const auto l2 = this->m_lcm * this->m_lcm;
+        // NOTE: m_lcm is the product of the lcms of the denominators of the two operands.
+        const auto &l2 = this->m_lcm;
         auto &container = s._container();
         // Single thread implementation.
         if (m_n_threads == 1u) {
@@ -329,6 +555,19 @@ private:
     void finalise_impl(T &) const
     {
     }
+    // Implementation of finalise_term().
+    template <typename T, typename std::enable_if<mppp::is_rational<typename T::cf_type>::value, int>::type = 0>
+    void finalise_term_impl(T &t) const
+    {
+        if (!piranha::is_one(this->m_lcm)) {
+            t.m_cf._get_den() = this->m_lcm;
+            t.m_cf.canonicalise();
+        }
+    }
+    template <typename T, typename std::enable_if<!mppp::is_rational<typename T::cf_type>::value, int>::type = 0>
+    void finalise_term_impl(T &) const
+    {
+    }
 
 public:
     /// Constructor.
@@ -340,9 +579,9 @@ public:
      *
      * If the coefficient type of \p Series is an mp++ rational, then the pointers in \p m_v1 and \p
      * m_v2 will refer not to the original terms in \p s1 and \p s2 but to *copies* of these terms, in which all
-     * coefficients have unitary denominator and the numerators have all been multiplied by the global least common
-     * multiplier. This transformation allows to reduce the multiplication of series with rational coefficients to the
-     * multiplication of series with integral coefficients.
+     * coefficients have unitary denominator and the numerators have all been multiplied by the least common
+     * multiplier of the denominators of the respective operand. This transformation allows to reduce the
+     * multiplication of series with rational coefficients to the multiplication of series with integral coefficients.
      *
      * If an operand is empty and the series type does not satisfy piranha::zero_is_absorbing, then a hidden
      * private series consisting of a single term with zero coefficient is created, and the pointers in
@@ -408,6 +647,59 @@ private:
     base_series_multiplier &operator=(base_series_multiplier &&) = delete;
 
 protected:
+    /// Memory footprint of a term.
+    /**
+     * This method will return the number of bytes of memory touched when accessing a term of the operands
+     * via the vectors of pointers base_series_multiplier::m_v1 and base_series_multiplier::m_v2. Since the terms
+     * are not stored contiguously, the size of a term is rounded up to a multiple of the cache line size
+     * (as returned by piranha::settings::get_cache_line_size()), and the size of a pointer is added to the result.
+     *
+     * @return the memory footprint of a term, in bytes.
+     */
+    static std::size_t term_footprint()
+    {
+        const auto cl = static_cast<std::size_t>(settings::get_cache_line_size());
+        std::size_t retval = sizeof(typename Series::term_type);
+        if (cl) {
+            retval = (retval / cl + static_cast<std::size_t>(retval % cl != 0u)) * cl;
+        }
+        return retval + sizeof(typename v_ptr::value_type);
+    }
+    /// Tile sizes for the blocked multiplication.
+    /**
+     * This method will return the sizes of the blocks into which the first and second operand of a multiplication
+     * are divided by blocked_multiplication(). \p fp1 and \p fp2 are the memory footprints (in bytes) of the
+     * elements of the two operands (e.g., as returned by term_footprint()).
+     *
+     * If piranha::tuning::get_multiplication_auto_tiling() returns \p true and the sizes of the L1 and L2 caches
+     * can be detected via piranha::runtime_info::get_cache_size(), the block of the second operand is sized so
+     * that it fills half of the L1 cache (as it is traversed once for each term in the block of the first operand),
+     * and the block of the first operand is sized so that it fills half of the L2 cache. The returned values
+     * are clamped to the range accepted by piranha::tuning::set_multiplication_block_size(). Otherwise,
+     * the value returned by piranha::tuning::get_multiplication_block_size() is used for both operands.
+     *
+     * @param fp1 the memory footprint of an element of the first operand.
+     * @param fp2 the memory footprint of an element of the second operand.
+     *
+     * @return a pair containing the block sizes for the first and second operand.
+     *
+     * @throws unspecified any exception thrown by piranha::safe_cast().
+     */
+    static std::pair<size_type, size_type> tile_sizes(const std::size_t &fp1, const std::size_t &fp2)
+    {
+        // NOTE: the cache sizes are detected only once.
+        static const unsigned long l1_size = runtime_info::get_cache_size(1u);
+        static const unsigned long l2_size = runtime_info::get_cache_size(2u);
+        if (!tuning::get_multiplication_auto_tiling() || !l1_size || !l2_size || !fp1 || !fp2) {
+            const auto bsize = piranha::safe_cast<size_type>(tuning::get_multiplication_block_size());
+            return std::make_pair(bsize, bsize);
+        }
+        // NOTE: the fraction of the caches devoted to the blocks is a tuning parameter, the rest
+        // is left to the output container.
+        auto clamp = [](unsigned long n) { return std::min(std::max(n, 16ul), 4096ul); };
+        return std::make_pair(piranha::safe_cast<size_type>(clamp(l2_size / 2u / fp1)),
+                              piranha::safe_cast<size_type>(clamp(l1_size / 2u / fp2)));
+    }
     /// Blocked multiplication.
     /**
      * \note
@@ -429,7 +721,7 @@ protected:
      * base_series_multiplier::size_type and returning \p void. \p lf must be a function object
      * with a call operator accepting and returning a base_series_multiplier::size_type.
      *
-     * Internally, the double loops is decomposed in blocks of size tuning::get_multiplication_block_size() in an
+     * Internally, the double loops is decomposed in blocks whose sizes are computed by tile_sizes() in an
      * attempt to optimise cache memory access patterns.
      *
      * This method is meant to be used for series multiplication. \p mf is intended to be a function object that
@@ -454,20 +746,21 @@ protected:
         if (unlikely(start1 > end1 || start1 > m_v1.size() || end1 > m_v1.size())) {
             piranha_throw(std::invalid_argument, "invalid bounds in blocked_multiplication");
         }
-        // Block size and number of regular blocks.
-        const size_type bsize = piranha::safe_cast<size_type>(tuning::get_multiplication_block_size()),
-                        nblocks1 = static_cast<size_type>((end1 - start1) / bsize),
-                        nblocks2 = static_cast<size_type>(m_v2.size() / bsize);
+        // Block sizes and number of regular blocks.
+        const auto ts = tile_sizes(term_footprint(), term_footprint());
+        const size_type bsize1 = ts.first, bsize2 = ts.second,
+                        nblocks1 = static_cast<size_type>((end1 - start1) / bsize1),
+                        nblocks2 = static_cast<size_type>(m_v2.size() / bsize2);
         // Start and end of last (possibly irregular) blocks.
-        const size_type i_ir_start = static_cast<size_type>(nblocks1 * bsize + start1), i_ir_end = end1;
-        const size_type j_ir_start = static_cast<size_type>(nblocks2 * bsize), j_ir_end = m_v2.size();
+        const size_type i_ir_start = static_cast<size_type>(nblocks1 * bsize1 + start1), i_ir_end = end1;
+        const size_type j_ir_start = static_cast<size_type>(nblocks2 * bsize2), j_ir_end = m_v2.size();
         for (size_type n1 = 0u; n1 < nblocks1; ++n1) {
-            const size_type i_start = static_cast<size_type>(n1 * bsize + start1),
-                            i_end = static_cast<size_type>(i_start + bsize);
+            const size_type i_start = static_cast<size_type>(n1 * bsize1 + start1),
+                            i_end = static_cast<size_type>(i_start + bsize1);
             // regulars1 * regulars2
             for (size_type n2 = 0u; n2 < nblocks2; ++n2) {
-                const size_type j_start = static_cast<size_type>(n2 * bsize),
-                                j_end = static_cast<size_type>(j_start + bsize);
+                const size_type j_start = static_cast<size_type>(n2 * bsize2),
+                                j_end = static_cast<size_type>(j_start + bsize2);
                 for (size_type i = i_start; i < i_end; ++i) {
                     const size_type limit = std::min<size_type>(lf(i), j_end);
                     for (size_type j = j_start; j < limit; ++j) {
@@ -485,8 +778,8 @@ protected:
         }
         // rem1 * regulars2
         for (size_type n2 = 0u; n2 < nblocks2; ++n2) {
-            const size_type j_start = static_cast<size_type>(n2 * bsize),
-                            j_end = static_cast<size_type>(j_start + bsize);
+            const size_type j_start = static_cast<size_type>(n2 * bsize2),
+                            j_end = static_cast<size_type>(j_start + bsize2);
             for (size_type i = i_ir_start; i < i_ir_end; ++i) {
                 const size_type limit = std::min<size_type>(lf(i), j_end);
                 for (size_type j = j_start; j < limit; ++j) {
@@ -518,7 +811,28 @@ protected:
     {
         blocked_multiplication(mf, start1, end1, default_limit_functor{*this});
     }
-    /// Estimate size of series multiplication.
+    /// Result of the statistical estimation of the size of a series multiplication.
+    /**
+     * @see base_series_multiplier::sample_final_series_size().
+     */
+    struct size_estimate {
+        /// The estimated size, i.e., the mean of the estimates of the single trials.
+        bucket_size_type m_value;
+        /// Lower bound of the 95% confidence interval of the mean.
+        bucket_size_type m_lower;
+        /// Upper bound of the 95% confidence interval of the mean.
+        bucket_size_type m_upper;
+        /// Number of trials performed.
+        unsigned m_n_trials;
+        /// Number of trials which did not find any duplicate term.
+        /**
+         * In such trials, the estimate is the total number of term-by-term multiplications. A nonzero value
+         * means that the operands are very sparse and that the estimate is an upper bound rather than a
+         * statistical estimate.
+         */
+        unsigned m_n_saturated;
+    };
+    /// Statistical estimation of the size of series multiplication.
     /**
      * \note
      * If \p MultArity, \p MultFunctor or \p LimitFunctor do not satisfy the requirements outlined below,
@@ -533,22 +847,27 @@ protected:
      * \p Series passed as second parameter for construction.
      *
      * This method will apply a statistical approach to estimate the final size of the result of the multiplication of
-     * the first series by the second. It will perform random term-by-term multiplications
-     * and deduce the estimate from the number of term multiplications performed before finding the first duplicate
+     * the first series by the second. Each trial will perform random term-by-term multiplications
+     * and deduce an estimate from the number of term multiplications performed before finding the first duplicate
      * term. The \p MultArity parameter represents the arity of term multiplications - that is, the number of terms
      * generated by a single term-by-term multiplication. It must be strictly positive.
      *
+     * The trials are run in rounds of 15. After each round, the 95% confidence interval of the mean
+     * of the estimates of the single trials is computed, and new rounds are run until the half-width of the interval
+     * is not greater than half the mean, up to a maximum of 60 trials. The returned value contains the mean,
+     * the confidence interval, the number of trials and the number of trials which did not find any duplicate.
+     *
      * The \p lf parameter must be a function object exposing the same inteface as explained in
      * blocked_multiplication(). This functor establishes how many terms in the second series must be multiplied by
      * the <tt>i</tt>-th term of the first series.
      *
-     * The number returned by this function is always at least 1. Multiple threads might be used by this method:
+     * The estimated size is always at least 1. Multiple threads might be used by this method:
      * in such a case, different instances of \p MultFunctor are constructed in different threads, but \p lf is
-     * shared among all threads.
+     * shared among all threads. The result does not depend on the number of threads.
      *
      * @param lf the limit functor.
      *
-     * @return the estimated size of the multiplication of the first series by the second, always at least 1.
+     * @return the estimate of the size of the multiplication of the first series by the second.
      *
      * @throws std::overflow_error in case of (unlikely) overflows in integral arithmetics.
      * @throws unspecified any exception thrown by:
@@ -561,7 +880,7 @@ protected:
      * - future_list::push_back().
      */
     template <std::size_t MultArity, typename MultFunctor, typename LimitFunctor>
-    bucket_size_type estimate_final_series_size(const LimitFunctor &lf) const
+    size_estimate sample_final_series_size(const LimitFunctor &lf) const
     {
         PIRANHA_TT_CHECK(is_function_object, MultFunctor, void, const size_type &, const size_type &);
         PIRANHA_TT_CHECK(std::is_constructible, MultFunctor, const base_series_multiplier &, Series &);
@@ -569,37 +888,42 @@ protected:
         // Cache these.
         const size_type size1 = m_v1.size(), size2 = m_v2.size();
         constexpr std::size_t result_size = MultArity;
-        // If one of the two series is empty, just return 0.
+        // If one of the two series is empty, just return 1.
         if (unlikely(!size1 || !size2)) {
-            return 1u;
+            return size_estimate{1u, 1u, 1u, 0u, 0u};
         }
         // If either series has a size of 1, just return size1 * size2 * result_size.
         if (size1 == 1u || size2 == 1u) {
-            return static_cast<bucket_size_type>(integer(size1) * size2 * result_size);
+            const auto ret = static_cast<bucket_size_type>(integer(size1) * size2 * result_size);
+            return size_estimate{ret, ret, ret, 0u, 0u};
         }
-        // NOTE: Hard-coded number of trials.
+        // NOTE: number of trials per round and max number of trials. The first round
+        // is always performed.
         // NOTE: here consider that in case of extremely sparse series with few terms this will incur in noticeable
         // overhead, since we will need many term-by-term before encountering the first duplicate.
-        const unsigned n_trials = 15u;
+        const unsigned round_trials = 15u, max_trials = 60u;
+        // NOTE: tolerance on the relative half-width of the confidence interval.
+        const double tolerance = .5;
         // NOTE: Hard-coded value for the estimation multiplier.
         // NOTE: This value should be tuned for performance/memory usage tradeoffs.
         const unsigned multiplier = 2u;
         // Number of threads to use. If there are more threads than trials, then reduce
         // the number of actual threads to use.
         // NOTE: this is a bit different from usual, where we do not care if the workload per thread is zero.
-        // We do like this because n_trials is a small number and there still seems to be benefit in running
+        // We do like this because round_trials is a small number and there still seems to be benefit in running
         // just 1 trial per thread.
-        const unsigned n_threads = (n_trials >= m_n_threads) ? m_n_threads : n_trials;
+        const unsigned n_threads = (round_trials >= m_n_threads) ? m_n_threads : round_trials;
         piranha_assert(n_threads > 0u);
-        // Trials per thread. This will always be at least 1.
-        const unsigned tpt = n_trials / n_threads;
+        // Trials per thread in each round. This will always be at least 1.
+        const unsigned tpt = round_trials / n_threads;
         piranha_assert(tpt >= 1u);
-        // The cumulative estimate.
-        integer c_estimate(0);
-        // Sync mutex - actually used only in multithreading.
-        std::mutex mut;
+        // The estimates of the single trials, and the flags signalling the trials which did not find duplicates.
+        // Each thread writes in its own elements.
+        std::vector<integer> estimates(max_trials);
+        std::vector<char> saturated(max_trials, 0);
         // The estimation functor.
-        auto estimator = [&lf, size1, n_threads, tpt, this, &c_estimate, &mut, multiplier](unsigned thread_idx) {
+        auto estimator = [&lf, size1, n_threads, tpt, this, &estimates, &saturated,
+                          multiplier](unsigned thread_idx, unsigned first_trial) {
             piranha_assert(thread_idx < n_threads);
             // Vectors of indices into m_v1.
             std::vector<size_type> v_idx1(piranha::safe_cast<typename std::vector<size_type>::size_type>(size1));
@@ -611,10 +935,8 @@ protected:
             // Uniform int distribution.
             using dist_type = std::uniform_int_distribution<size_type>;
             dist_type dist;
-            // Init the accumulated estimation for averaging later.
-            integer acc(0);
             // Number of trials for this thread - usual special casing for the last thread.
-            const unsigned cur_trials = (thread_idx == n_threads - 1u) ? (n_trials - thread_idx * tpt) : tpt;
+            const unsigned cur_trials = (thread_idx == n_threads - 1u) ? (round_trials - thread_idx * tpt) : tpt;
             // This should always be guaranteed because tpt is never 0.
             piranha_assert(cur_trials > 0u);
             // Create and setup the temp series.
@@ -624,9 +946,10 @@ protected:
             MultFunctor mf(*this, tmp);
             // Go with the trials.
             for (auto n = 0u; n < cur_trials; ++n) {
-                // Seed the engine. The seed should be the global trial number, accounting for multiple
-                // threads. This way the estimation will not depend on the number of threads.
-                engine.seed(static_cast<std::mt19937::result_type>(tpt * thread_idx + n));
+                // The global trial number, accounting for multiple threads and rounds. It is used as seed
+                // for the engine, so that the estimation will not depend on the number of threads.
+                const unsigned trial = first_trial + tpt * thread_idx + n;
+                engine.seed(static_cast<std::mt19937::result_type>(trial));
                 // Reset the indices vector and re-randomise it.
                 // NOTE: we need to do this as every run inside this for loop must be completely independent
                 // of any previous run, we cannot keep any state.
@@ -673,6 +996,7 @@ protected:
                     // is the average number of terms in s2 that participate in the multiplication.
                     // The result will be then count * acc_s2 / count = acc_s2.
                     add = acc_s2;
+                    saturated[trial] = 1;
                 } else {
                     // If we found a duplicate, we use the heuristic.
                     add = integer(multiplier) * count * count;
@@ -681,40 +1005,98 @@ protected:
                 if (add.sgn() == 0) {
                     add = 1;
                 }
-                acc += add;
+                estimates[trial] = std::move(add);
                 // Reset tmp.
                 tmp._container().clear();
             }
-            // Accumulate in the shared variable.
+        };
+        size_estimate retval;
+        unsigned n_trials = 0u;
+        while (true) {
+            // Run a round of trials.
             if (n_threads == 1u) {
-                // No locking needed.
-                c_estimate += acc;
+                estimator(0u, n_trials);
             } else {
-                std::lock_guard<std::mutex> lock(mut);
-                c_estimate += acc;
-            }
-        };
-        // Run the estimation functor.
-        if (n_threads == 1u) {
-            estimator(0u);
-        } else {
-            future_list<void> f_list;
-            try {
-                for (unsigned i = 0u; i < n_threads; ++i) {
-                    f_list.push_back(thread_pool::enqueue(i, estimator, i));
+                future_list<void> f_list;
+                try {
+                    for (unsigned i = 0u; i < n_threads; ++i) {
+                        f_list.push_back(thread_pool::enqueue(i, estimator, i, n_trials));
+                    }
+                    // First let's wait for everything to finish.
+                    f_list.wait_all();
+                    // Then, let's handle the exceptions.
+                    f_list.get_all();
+                } catch (...) {
+                    f_list.wait_all();
+                    throw;
                 }
-                // First let's wait for everything to finish.
-                f_list.wait_all();
-                // Then, let's handle the exceptions.
-                f_list.get_all();
-            } catch (...) {
-                f_list.wait_all();
-                throw;
+            }
+            n_trials += round_trials;
+            // Compute the mean and the confidence interval.
+            integer c_estimate(0);
+            for (unsigned i = 0u; i < n_trials; ++i) {
+                c_estimate += estimates[i];
+            }
+            piranha_assert(c_estimate >= n_trials);
+            const auto mean = static_cast<double>(c_estimate) / n_trials;
+            double var = 0.;
+            for (unsigned i = 0u; i < n_trials; ++i) {
+                const auto diff = static_cast<double>(estimates[i]) - mean;
+                var += diff * diff;
+            }
+            var /= (n_trials - 1u);
+            const auto half_width = 1.96 * std::sqrt(var / n_trials);
+            if (half_width <= tolerance * mean || n_trials == max_trials) {
+                retval.m_value = static_cast<bucket_size_type>(c_estimate / n_trials);
+                retval.m_lower = (mean - half_width > 1.) ? static_cast<bucket_size_type>(mean - half_width)
+                                                          : bucket_size_type(1u);
+                retval.m_upper = static_cast<bucket_size_type>(
+                    std::min(mean + half_width, static_cast<double>(std::numeric_limits<bucket_size_type>::max())));
+                break;
             }
         }
-        piranha_assert(c_estimate >= n_trials);
-        // Return the mean.
-        return static_cast<bucket_size_type>(c_estimate / n_trials);
+        retval.m_n_trials = n_trials;
+        retval.m_n_saturated
+            = static_cast<unsigned>(std::count(saturated.begin(), saturated.begin() + n_trials, char(1)));
+        return retval;
+    }
+    /// Statistical estimation of the size of series multiplication (convenience overload)
+    /**
+     * @return the output of the other overload of sample_final_series_size(), with a limit
+     * functor whose call operator will always return the size of the second series unconditionally.
+     *
+     * @throws unspecified any exception thrown by the other overload of sample_final_series_size().
+     */
+    template <std::size_t MultArity, typename MultFunctor>
+    size_estimate sample_final_series_size() const
+    {
+        return sample_final_series_size<MultArity, MultFunctor>(default_limit_functor{*this});
+    }
+    /// Estimate size of series multiplication.
+    /**
+     * \note
+     * If \p MultArity, \p MultFunctor or \p LimitFunctor do not satisfy the requirements outlined
+     * in sample_final_series_size(), a compile-time error will be produced.
+     *
+     * If \p lf is a default limit functor (i.e., this method was invoked via the convenience overload)
+     * and the actual size of the product of operands with the same sizes and keys is found in the cache
+     * (see cached_final_series_size()), the cached size will be returned. Otherwise, the mean estimated size
+     * computed by sample_final_series_size() will be returned.
+     *
+     * @param lf the limit functor.
+     *
+     * @return the estimated size of the multiplication of the first series by the second, always at least 1.
+     *
+     * @throws unspecified any exception thrown by sample_final_series_size() or cached_final_series_size().
+     */
+    template <std::size_t MultArity, typename MultFunctor, typename LimitFunctor>
+    bucket_size_type estimate_final_series_size(const LimitFunctor &lf) const
+    {
+        bucket_size_type retval;
+        if (std::is_same<LimitFunctor, default_limit_functor>::value && cached_final_series_size(retval)) {
+            return retval;
+        }
+        return sample_final_series_size<MultArity, MultFunctor>(lf).m_value;
     }
     /// Estimate size of series multiplication (convenience overload)
     /**
@@ -728,6 +1110,79 @@ protected:
     {
         return estimate_final_series_size<MultArity, MultFunctor>(default_limit_functor{*this});
     }
+    /// Look up the size of the multiplication in the cache.
+    /**
+     * If piranha::tuning::get_estimate_cache() returns \p true and a multiplication of operands with the same
+     * sizes and keys as the operands of \p this was previously registered via register_final_series_size(),
+     * the actual size of the result of such multiplication will be written into \p out.
+     *
+     * @param out the output value.
+     *
+     * @return \p true if the size was found in the cache, \p false otherwise.
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    bool cached_final_series_size(bucket_size_type &out) const
+    {
+        if (!tuning::get_estimate_cache()) {
+            return false;
+        }
+        std::size_t tmp;
+        if (get_size_cache().find(size_cache_key(), tmp)) {
+            out = static_cast<bucket_size_type>(std::max<std::size_t>(tmp, 1u));
+            return true;
+        }
+        return false;
+    }
+    /// Register the size of the result of a multiplication.
+    /**
+     * This method should be called after a multiplication whose final size was estimated. The estimated and
+     * actual size of the result will be appended to piranha::estimation_log (if enabled). If \p cache is \p true
+     * and piranha::tuning::get_estimate_cache() returns \p true, the actual size will also be stored in the cache
+     * used by cached_final_series_size(). \p cache should be \p false if not all the term-by-term
+     * multiplications were performed (e.g., in truncated multiplications).
+     *
+     * @param estimate the estimated size of the result.
+     * @param actual the actual size of the result.
+     * @param cache flag signalling whether the actual size can be stored in the cache.
+     *
+     * @throws unspecified any exception thrown by piranha::estimation_log::push_back() or by threading primitives.
+     */
+    void register_final_series_size(const bucket_size_type &estimate, const bucket_size_type &actual,
+                                    bool cache = true) const
+    {
+        estimation_log::push_back(estimation_log::record{static_cast<unsigned long long>(m_v1.size()),
+                                                         static_cast<unsigned long long>(m_v2.size()),
+                                                         static_cast<unsigned long long>(estimate),
+                                                         static_cast<unsigned long long>(actual)});
+        if (cache && tuning::get_estimate_cache()) {
+            get_size_cache().insert(size_cache_key(), static_cast<std::size_t>(actual));
+        }
+    }
+
+private:
+    // The cache of the sizes of the results, one per series type.
+    static detail::series_size_cache &get_size_cache()
+    {
+        static detail::series_size_cache cache;
+        return cache;
+    }
+    // Key into the cache: sizes of the operands and hashes of their keys. The hashes are combined in an
+    // order-independent way, as the order of the terms depends on the history of the containers.
+    detail::series_size_cache::key_type size_cache_key() const
+    {
+        auto hasher = [this](const v_ptr &v) {
+            std::size_t retval = m_ss.size();
+            for (const auto &ptr : v) {
+                retval += ptr->hash();
+            }
+            return retval;
+        };
+        return detail::series_size_cache::key_type{
+            {static_cast<std::size_t>(m_v1.size()), static_cast<std::size_t>(m_v2.size()), hasher(m_v1), hasher(m_v2)}};
+    }
+
+protected:
     /// A plain multiplier functor.
     /**
      * \note
@@ -746,7 +1201,9 @@ protected:
      * series
      * using the low-level interface of piranha::hash_set, otherwise the call operator will use
      * piranha::series::insert() for
-     * term insertion.
+     * term insertion. In fast mode, the insertions are pipelined via piranha::hash_set::_pipeline (with a prefetch
+     * distance given by piranha::tuning::get_prefetch_distance()), and flush() must be called after the last
+     * term-by-term multiplication in order to complete the pending insertions.
      */
     template <bool FastMode>
     class plain_multiplier
@@ -754,7 +1211,6 @@ protected:
         using term_type = typename Series::term_type;
         using key_type = typename term_type::key_type;
         PIRANHA_TT_CHECK(key_is_multipliable, typename term_type::cf_type, key_type);
-        using it_type = decltype(std::declval<Series &>()._container().end());
         static constexpr std::size_t m_arity = key_type::multiply_arity;
 
     public:
@@ -767,7 +1223,10 @@ protected:
          * @param retval the \p Series instance into which terms resulting from multiplications will be inserted.
          */
         explicit plain_multiplier(const base_series_multiplier &bsm, Series &retval)
-            : m_v1(bsm.m_v1), m_v2(bsm.m_v2), m_retval(retval), m_c_end(retval._container().end())
+            : m_v1(bsm.m_v1), m_v2(bsm.m_v2), m_retval(retval),
+              m_pipeline(retval._container(), cf_adder{},
+                         FastMode ? piranha::safe_cast<bucket_size_type>(tuning::get_prefetch_distance())
+                                  : bucket_size_type(0u))
         {
         }
 
@@ -799,28 +1258,64 @@ protected:
             for (std::size_t n = 0u; n < m_arity; ++n) {
                 auto &tmp_term = m_tmp_t[n];
                 if (FastMode) {
-                    auto &container = m_retval._container();
-                    // Try to locate the term into retval.
-                    auto bucket_idx = container._bucket(tmp_term);
-                    const auto it = container._find(tmp_term, bucket_idx);
-                    if (it == m_c_end) {
-                        container._unique_insert(term_insertion(tmp_term), bucket_idx);
-                    } else {
-                        it->m_cf += tmp_term.m_cf;
-                    }
+                    // NOTE: move the term into the ring buffer of the pipeline, tmp_term will be
+                    // overwritten by the next multiplication.
+                    m_pipeline.push(std::move(term_insertion(tmp_term)));
                 } else {
                     m_retval.insert(term_insertion(tmp_term));
                 }
             }
         }
+        /// Complete the pending insertions.
+        /**
+         * In fast mode, this method will complete the term insertions still pending in the pipeline. Otherwise,
+         * this method has no effects.
+         *
+         * @throws unspecified any exception thrown by piranha::hash_set::_pipeline::flush().
+         */
+        void flush() const
+        {
+            m_pipeline.flush();
+        }
 
     private:
         mutable std::array<term_type, m_arity> m_tmp_t;
         const std::vector<term_type const *> &m_v1;
         const std::vector<term_type const *> &m_v2;
         Series &m_retval;
-        const it_type m_c_end;
+        mutable typename container_type::template _pipeline<cf_adder> m_pipeline;
     };
+    /// Setup the node arena of a series.
+    /**
+     * If piranha::tuning::get_node_arena() returns \p true, this method will enable the node arena
+     * (see piranha::hash_set::_set_node_arena()) in the container of \p retval, which must be empty. It
+     * is meant to be called on the series which will hold the result of the multiplication, before
+     * any term is inserted.
+     *
+     * @param retval the series whose node arena will be set up.
+     *
+     * @throws unspecified any exception thrown by piranha::hash_set::_set_node_arena().
+     */
+    static void setup_node_arena(Series &retval)
+    {
+        if (tuning::get_node_arena()) {
+            retval._container()._set_node_arena(true);
+        }
+    }
+
+private:
+    // Move a coefficient which is about to be destroyed into the thread-local pool, if its type is recyclable.
+    template <typename Cf, enable_if_t<detail::is_recyclable_cf<Cf>::value, int> = 0>
+    static void recycle_cf(Cf &cf)
+    {
+        detail::cf_recycler<Cf>::release(std::move(cf));
+    }
+    template <typename Cf, enable_if_t<!detail::is_recyclable_cf<Cf>::value, int> = 0>
+    static void recycle_cf(Cf &)
+    {
+    }
+
+protected:
     /// Sanitise series.
     /**
      * When using the low-level interface of piranha::hash_set for term insertion, invariants might be violated
@@ -831,7 +1326,9 @@ protected:
      *
      * This method can be used to fix these invariants: it will check whether each term of \p retval is incompatible
      * and/or zero, and the total count of terms in the series will be set to the number of nonzero terms.
-     * Zero terms will be erased.
+     * Zero terms will be erased. If the coefficient type is piranha::integer or piranha::rational, the coefficients
+     * of the erased terms will be moved into a thread-local pool, so that their storage can be reused by subsequent
+     * multiplications.
      *
      * Note that in case of exceptions \p retval will likely be left in an inconsistent state which violates internal
      * invariants. Calls to this function should always be wrapped in a try/catch block that makes sure that \p retval
@@ -854,7 +1351,6 @@ protected:
      */
     static void sanitise_series(Series &retval, unsigned n_threads)
     {
-        using term_type = typename Series::term_type;
         if (unlikely(n_threads == 0u)) {
             piranha_throw(std::invalid_argument, "invalid number of threads");
         }
@@ -875,6 +1371,7 @@ protected:
                 // First update the size, it will be scaled back in the erase() method if necessary.
                 container._update_size(static_cast<bucket_size_type>(container.size() + 1u));
                 if (unlikely(it->is_zero(args))) {
+                    recycle_cf(it->m_cf);
                     it = container.erase(it);
                 } else {
                     ++it;
@@ -891,34 +1388,30 @@ protected:
             piranha_assert(start <= end && end <= b_count);
             (void)b_count;
             bucket_size_type count = 0u;
-            std::vector<term_type> term_list;
-            // Examine and count the terms bucket-by-bucket.
+            // Examine and count the terms bucket-by-bucket, erasing the ignorable terms in place.
             for (bucket_size_type i = start; i != end; ++i) {
-                term_list.clear();
                 const auto &bl = container._get_bucket_list(i);
-                const auto it_f = bl.end();
-                for (auto it = bl.begin(); it != it_f; ++it) {
+                // NOTE: the end of the bucket must be re-evaluated after each erasure.
+                for (auto it = bl.begin(); it != bl.end();) {
                     // Check first for compatibility.
                     if (unlikely(!it->is_compatible(args))) {
                         piranha_throw(std::invalid_argument, "incompatible term");
                     }
                     // Check for ignorability.
                     if (unlikely(it->is_zero(args))) {
-                        term_list.push_back(*it);
+                        recycle_cf(it->m_cf);
+                        // NOTE: must use _erase to avoid concurrent modifications
+                        // to the number of elements in the table. The returned iterator
+                        // points to the element following the erased one.
+                        it = container._erase(typename container_type::const_iterator(&container, i, it));
+                        continue;
                     }
                     // Update the count of terms.
                     if (unlikely(count == std::numeric_limits<bucket_size_type>::max())) {
                         piranha_throw(std::overflow_error, "overflow error in the number of terms of a series");
                     }
                     count = static_cast<bucket_size_type>(count + 1u);
-                }
-                for (auto it = term_list.begin(); it != term_list.end(); ++it) {
-                    // NOTE: must use _erase to avoid concurrent modifications
-                    // to the number of elements in the table.
-                    container._erase(container._find(*it, i));
-                    // Account for the erased term.
-                    piranha_assert(count > 0u);
-                    count = static_cast<bucket_size_type>(count - 1u);
+                    ++it;
                 }
             }
             // Update the global count.
@@ -967,6 +1460,14 @@ protected:
      *
      * Note that, in multithreaded mode, \p lf will be shared among (and called concurrently from) all the threads.
      *
+     * If the estimated memory footprint of the result exceeds tuning::get_multiplication_memory_limit(), the
+     * multiplication will be performed in chunked mode: the output hash space is partitioned into
+     * base_series_multiplier::chunked_multiplication_n_chunks() ranges, which are computed one at a time. Since
+     * the range of a product is known only after the term-by-term multiplication, all the term-by-term
+     * multiplications are performed for each range: with \f$ k \f$ ranges, the peak memory usage of the result is
+     * reduced by a factor of \f$ k \f$, and the cost of the term-by-term multiplications is multiplied by
+     * \f$ k \f$.
+     *
      * @param lf the limit functor (see base_series_multiplier::blocked_multiplication()).
      *
      * @return the series resulting from the multiplication of the two series used to construct \p this.
@@ -986,6 +1487,42 @@ protected:
      */
     template <typename LimitFunctor>
     Series plain_multiplication(const LimitFunctor &lf) const
+    {
+        return plain_multiplication_impl(lf, 0u);
+    }
+    /// A plain series multiplication routine (convenience overload).
+    /**
+     * @return the output of the other overload of plain_multiplication(), with a limit
+     * functor whose call operator will always return the size of the second series unconditionally.
+     *
+     * @throws unspecified any exception thrown by the other overload of plain_multiplication().
+     */
+    Series plain_multiplication() const
+    {
+        return plain_multiplication_impl(default_limit_functor{*this}, 0u);
+    }
+    /// Plain series multiplication with a known size estimate.
+    /**
+     * This method is equivalent to plain_multiplication(), but, if \p est is nonzero, it will be used as the
+     * estimated size of the result, and the estimation via base_series_multiplier::estimate_final_series_size() will
+     * be skipped. This is useful when the caller has already estimated the size of the result, e.g., in order to
+     * choose among different multiplication algorithms.
+     *
+     * @param est the estimated size of the result, or zero.
+     *
+     * @return the series resulting from the multiplication of the two series used to construct \p this.
+     *
+     * @throws unspecified any exception thrown by plain_multiplication().
+     */
+    Series _plain_multiplication(bucket_size_type est) const
+    {
+        return plain_multiplication_impl(default_limit_functor{*this}, est);
+    }
+
+private:
+    // Implementation of plain_multiplication(). If est is nonzero, it is used as the estimated size of the result.
+    template <typename LimitFunctor>
+    Series plain_multiplication_impl(const LimitFunctor &lf, bucket_size_type est) const
     {
         // Shortcuts.
         using term_type = typename Series::term_type;
@@ -996,6 +1533,7 @@ protected:
         // Setup the return value with the merged symbol set.
         Series retval;
         retval.set_symbol_set(m_ss);
+        setup_node_arena(retval);
         // Do not do anything if one of the two series is empty.
         if (unlikely(m_v1.empty() || m_v2.empty())) {
             return retval;
@@ -1013,14 +1551,30 @@ protected:
         if (integer(m_v1.size()) * m_v2.size() < integer(e_thr) * e_thr && n_threads == 1u) {
             estimate = false;
         }
+        // If an estimate was provided, use it.
+        if (est) {
+            estimate = true;
+        }
+        // A flag signalling that all the term-by-term multiplications are performed (so that the actual size
+        // can be cached for later estimations).
+        const bool full_mult = std::is_same<LimitFunctor, default_limit_functor>::value;
         if (estimate) {
             // Estimate and rehash.
-            const auto est = estimate_final_series_size<m_arity, plain_multiplier<false>>(lf);
+            if (!est) {
+                est = estimate_final_series_size<m_arity, plain_multiplier<false>>(lf);
+            }
             // NOTE: use numeric cast here as safe_cast is expensive, going through an integer-double conversion,
             // and in this case the behaviour of numeric_cast is appropriate.
             const auto n_buckets = boost::numeric_cast<bucket_size_type>(
                 std::ceil(static_cast<double>(est) / retval._container().max_load_factor()));
             piranha_assert(n_buckets > 0u);
+            // If the estimated result does not fit in the memory limit, switch to the chunked mode.
+            const auto n_chunks = chunked_multiplication_n_chunks(n_buckets);
+            if (n_chunks > 1u) {
+                retval = chunked_multiplication(lf, n_buckets, n_chunks);
+                register_final_series_size(est, retval.size(), full_mult);
+                return retval;
+            }
             // Check if we want to use the parallel memory set.
             // NOTE: it is important here that we use the same n_threads for multiplication and memset as
             // we tie together pinned threads with potentially different NUMA regions.
@@ -1031,13 +1585,17 @@ protected:
             try {
                 // Single-thread case.
                 if (estimate) {
-                    blocked_multiplication(plain_multiplier<true>(*this, retval), 0u, size1, lf);
+                    const plain_multiplier<true> pm(*this, retval);
+                    blocked_multiplication(pm, 0u, size1, lf);
+                    pm.flush();
                     // If we estimated beforehand, we need to sanitise the series.
                     sanitise_series(retval, static_cast<unsigned>(n_threads));
+                    finalise_series(retval);
+                    register_final_series_size(est, retval.size(), full_mult);
                 } else {
                     blocked_multiplication(plain_multiplier<false>(*this, retval), 0u, size1, lf);
+                    finalise_series(retval);
                 }
-                finalise_series(retval);
                 return retval;
             } catch (...) {
                 retval._container().clear();
@@ -1046,78 +1604,58 @@ protected:
         }
         // Multi-threaded case.
         piranha_assert(estimate);
-        // Init the vector of spinlocks.
-        detail::atomic_flag_array sl_array(piranha::safe_cast<std::size_t>(retval._container().bucket_count()));
-        // Init the future list.
-        future_list<void> f_list;
-        // Thread block size.
-        const auto block_size = size1 / n_threads;
         try {
-            for (size_type idx = 0u; idx < n_threads; ++idx) {
-                // Thread functor.
-                auto tf = [idx, this, block_size, n_threads, &sl_array, &retval, &lf]() {
-                    // Used to store the result of term multiplication.
-                    std::array<term_type, key_type::multiply_arity> tmp_t;
-                    // End of retval container (thread-safe).
-                    const auto c_end = retval._container().end();
-                    // Block functor.
-                    // NOTE: this is very similar to the plain functor, but it does the bucket locking
-                    // additionally.
-                    auto f = [&c_end, &tmp_t, this, &retval, &sl_array](const size_type &i, const size_type &j) {
-                        // Run the term multiplication.
-                        key_type::multiply(tmp_t, *(this->m_v1[i]), *(this->m_v2[j]), retval.get_symbol_set());
-                        for (std::size_t n = 0u; n < key_type::multiply_arity; ++n) {
-                            auto &container = retval._container();
-                            auto &tmp_term = tmp_t[n];
-                            // Try to locate the term into retval.
-                            auto bucket_idx = container._bucket(tmp_term);
-                            // Lock the bucket.
-                            detail::atomic_lock_guard alg(sl_array[static_cast<std::size_t>(bucket_idx)]);
-                            const auto it = container._find(tmp_term, bucket_idx);
-                            if (it == c_end) {
-                                container._unique_insert(term_insertion(tmp_term), bucket_idx);
-                            } else {
-                                it->m_cf += tmp_term.m_cf;
-                            }
-                        }
-                    };
-                    // Thread block limit.
-                    const auto e1
-                        = (idx == n_threads - 1u) ? this->m_v1.size() : static_cast<size_type>((idx + 1u) * block_size);
-                    this->blocked_multiplication(f, static_cast<size_type>(idx * block_size), e1, lf);
-                };
-                f_list.push_back(thread_pool::enqueue(static_cast<unsigned>(idx), tf));
-            }
-            f_list.wait_all();
-            f_list.get_all();
+            filtered_multiplication(retval, lf, [](const term_type &) { return true; });
             sanitise_series(retval, static_cast<unsigned>(n_threads));
             finalise_series(retval);
+            register_final_series_size(est, retval.size(), full_mult);
         } catch (...) {
-            f_list.wait_all();
             // Clean up retval as it might be in an inconsistent state.
             retval._container().clear();
             throw;
         }
         return retval;
     }
-    /// A plain series multiplication routine (convenience overload).
+
+protected:
+    /// Number of chunks for the chunked multiplication mode.
     /**
-     * @return the output of the other overload of plain_multiplication(), with a limit
-     * functor whose call operator will always return the size of the second series unconditionally.
+     * The memory footprint of a result container with \p n_buckets buckets is estimated as \p n_buckets times the
+     * size of the term type of \p Series. If the footprint does not exceed tuning::get_multiplication_memory_limit(),
+     * 1 will be returned. Otherwise, the return value is an odd number of chunks such that the footprint of a single
+     * chunk does not exceed the limit. The number of chunks is odd so that the partitioning of the hash values
+     * does not correlate with the power-of-two bucket count of piranha::hash_set.
      *
-     * @throws unspecified any exception thrown by the other overload of plain_multiplication().
+     * @param n_buckets the estimated number of buckets of the result container.
+     *
+     * @return the number of chunks in which plain_multiplication() will partition the output hash space.
+     *
+     * @throws unspecified any exception thrown by the conversion operator of piranha::integer.
      */
-    Series plain_multiplication() const
+    static bucket_size_type chunked_multiplication_n_chunks(const bucket_size_type &n_buckets)
     {
-        return plain_multiplication(default_limit_functor{*this});
+        const integer limit(tuning::get_multiplication_memory_limit());
+        const integer footprint = integer(n_buckets) * sizeof(typename Series::term_type);
+        if (footprint <= limit) {
+            return 1u;
+        }
+        // NOTE: there's no point in having more chunks than buckets.
+        integer n_chunks = (footprint - 1) / limit + 1;
+        if (n_chunks > n_buckets) {
+            n_chunks = n_buckets;
+        }
+        if (n_chunks % 2 == 0) {
+            n_chunks += 1;
+        }
+        return static_cast<bucket_size_type>(n_chunks);
     }
     /// Finalise series.
     /**
      * This method will finalise the output \p s of a series multiplication undertaken via
      * piranha::base_series_multiplier.
      * Currently, this method will not do anything unless the coefficient type of \p Series is an mp++ rational.
-     * In this case, the coefficients of \p s will be normalised with respect to the least common multiplier computed in
-     * the constructor of piranha::base_series_multiplier.
+     * In this case, the coefficients of \p s will be divided by the product of the least common multipliers computed
+     * in the constructor of piranha::base_series_multiplier, and canonicalised.
      *
      * @param s the \p Series to be finalised.
      *
@@ -1129,6 +1667,66 @@ protected:
     {
         finalise_impl(s);
     }
+    /// Finalise term.
+    /**
+     * This method is the term-by-term counterpart of finalise_series(), and it is meant to be used on
+     * terms of the result of a multiplication which are not stored in a series. If the coefficient type of
+     * \p Series is an mp++ rational, the coefficient of \p t will be divided by the product of the least common
+     * multipliers computed in the constructor of piranha::base_series_multiplier, and canonicalised. Otherwise,
+     * this method does nothing.
+     *
+     * @param t the term to be finalised.
+     */
+    void finalise_term(typename Series::term_type &t) const
+    {
+        finalise_term_impl(t);
+    }
+    /// Packed representation of a vector of terms.
+    /**
+     * This structure stores the packed keys of a vector of terms and pointers to their coefficients in two
+     * separate contiguous arrays (structure-of-arrays layout), so that the inner loops of the multiplication
+     * routines can stream over the keys without dereferencing term pointers. The coefficients are not copied.
+     * The type \p K is the packed representation of a key, as returned by the functor passed to pack_terms().
+     */
+    template <typename K>
+    struct packed_terms {
+        /// Packed keys.
+        std::vector<K> m_keys;
+        /// Pointers to the coefficients.
+        std::vector<typename Series::term_type::cf_type const *> m_cfs;
+    };
+    /// Pack a vector of terms.
+    /**
+     * \note
+     * This method can be used only if \p F is a function object which can be called with a const reference to the
+     * key type of \p Series.
+     *
+     * The keys of the terms pointed to by \p v will be converted to their packed representation via \p f, and
+     * pointers to the coefficients will be stored. The i-th elements of the output arrays correspond to the i-th
+     * term in \p v, which must outlive the returned object.
+     *
+     * @param v the vector of terms to be packed.
+     * @param f the functor used to compute the packed representation of the keys.
+     *
+     * @return the packed representation of \p v.
+     *
+     * @throws std::bad_alloc in case of memory errors.
+     * @throws unspecified any exception thrown by \p f.
+     */
+    template <typename F>
+    static packed_terms<uncvref_t<decltype(std::declval<const F &>()(
+        std::declval<const typename Series::term_type::key_type &>()))>>
+    pack_terms(const v_ptr &v, const F &f)
+    {
+        packed_terms<uncvref_t<decltype(f(std::declval<const typename Series::term_type::key_type &>()))>> retval;
+        retval.m_keys.reserve(v.size());
+        retval.m_cfs.reserve(v.size());
+        for (const auto ptr : v) {
+            retval.m_keys.push_back(f(ptr->m_key));
+            retval.m_cfs.push_back(&ptr->m_cf);
+        }
+        return retval;
+    }
 
 protected:
     /// Vector of const pointers to the terms in the larger series.
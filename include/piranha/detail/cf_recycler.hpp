@@ -0,0 +1,237 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_CF_RECYCLER_HPP
+#define PIRANHA_DETAIL_CF_RECYCLER_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <piranha/config.hpp>
+#include <piranha/thread_pool.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// Coefficient types whose dynamically-allocated storage can be recycled via cf_recycler.
+template <typename T>
+struct is_recyclable_cf : std::false_type {
+};
+
+template <std::size_t SSize>
+struct is_recyclable_cf<mppp::integer<SSize>> : std::true_type {
+};
+
+template <std::size_t SSize>
+struct is_recyclable_cf<mppp::rational<SSize>> : std::true_type {
+};
+
+// Check if a coefficient holds dynamically-allocated storage worth recycling.
+template <std::size_t SSize>
+inline bool cf_has_dynamic_storage(const mppp::integer<SSize> &n)
+{
+    return n.is_dynamic();
+}
+
+template <std::size_t SSize>
+inline bool cf_has_dynamic_storage(const mppp::rational<SSize> &q)
+{
+    return q.get_num().is_dynamic() || q.get_den().is_dynamic();
+}
+
+// Number of limbs of the values of the coefficients holding dynamic storage.
+template <std::size_t SSize>
+inline std::size_t cf_limbs(const mppp::integer<SSize> &n)
+{
+    return n.size();
+}
+
+template <std::size_t SSize>
+inline std::size_t cf_limbs(const mppp::rational<SSize> &q)
+{
+    return q.get_num().size() + q.get_den().size();
+}
+
+// Prepare a recycled coefficient for reuse.
+template <std::size_t SSize>
+inline void cf_recycled_reset(mppp::integer<SSize> &)
+{
+}
+
+// NOTE: the rational coefficients are used as destinations of multiplications which write only
+// into the numerator (see cf_mult_impl()), thus the denominator must be one.
+template <std::size_t SSize>
+inline void cf_recycled_reset(mppp::rational<SSize> &q)
+{
+    q._get_den() = 1;
+}
+
+// A per-thread pool of coefficients holding dynamically-allocated storage. Coefficients which are about
+// to be destroyed can be moved into the pool via release(), and refill() can later hand them out, storage
+// included, as the destination of an arithmetic operation. The multiprecision arithmetic functions
+// write into the existing storage of their return value when it is large enough, so that in the steady
+// state of a series multiplication the allocations of the coefficients of the new terms are served
+// from the storage of the terms which were discarded earlier.
+// The values of the coefficients handed out by refill() are unspecified, apart from the denominators of
+// the rationals, which are set to one.
+// The memory held by each pool is bounded: coefficients whose values are larger than max_cf_limbs limbs are
+// not recycled, and the pool stops accepting coefficients when their values total max_limbs limbs. The pools
+// are emptied when the thread pool is resized (see thread_pool_resize_count()), and the pool of the calling
+// thread can be emptied via clear().
+// NOTE: if thread_local is not available, the pool is disabled.
+template <typename Cf>
+class cf_recycler
+{
+    static_assert(is_recyclable_cf<Cf>::value, "Invalid coefficient type.");
+
+public:
+    // Maximum number of coefficients in the pool of each thread.
+    static const std::size_t max_size = 1024u;
+    // Maximum number of limbs of a recycled coefficient.
+    static const std::size_t max_cf_limbs = 256u;
+    // Maximum total number of limbs of the coefficients in the pool of each thread.
+    static const std::size_t max_limbs = 32768u;
+    // Replace the value of x with a coefficient from the pool, if available, or with a default-constructed one.
+    static void refill(Cf &x)
+    {
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+        auto &p = pool();
+        if (!p.m_cfs.empty()) {
+            x = std::move(p.m_cfs.back());
+            p.m_cfs.pop_back();
+            p.m_limbs -= cf_limbs(x);
+            cf_recycled_reset(x);
+            return;
+        }
+#endif
+        x = Cf{};
+    }
+    // Move x into the pool, if it holds dynamic storage which is not too large and the pool is not full.
+    // The state of x after the call is valid but unspecified.
+    static void release(Cf &&x) noexcept
+    {
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+        if (!cf_has_dynamic_storage(x)) {
+            return;
+        }
+        const auto l = cf_limbs(x);
+        if (l > max_cf_limbs) {
+            return;
+        }
+        try {
+            auto &p = pool();
+            if (p.m_cfs.size() == max_size || l > max_limbs - p.m_limbs) {
+                return;
+            }
+            // NOTE: reserve the whole pool in one go, so that the pool does not reallocate.
+            if (p.m_cfs.capacity() < max_size) {
+                p.m_cfs.reserve(max_size);
+            }
+            p.m_cfs.push_back(std::move(x));
+            p.m_limbs += l;
+        } catch (...) {
+            // NOTE: the recycling is an optimisation, just let x be destroyed normally.
+        }
+#else
+        (void)x;
+#endif
+    }
+    // Number of coefficients in the pool of the calling thread.
+    static std::size_t size()
+    {
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+        return pool().m_cfs.size();
+#else
+        return 0u;
+#endif
+    }
+    // Destroy all the coefficients in the pool of the calling thread.
+    static void clear()
+    {
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+        pool().clear();
+#endif
+    }
+    // Total number of limbs of the coefficients in the pool of the calling thread.
+    static std::size_t limbs()
+    {
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+        return pool().m_limbs;
+#else
+        return 0u;
+#endif
+    }
+
+private:
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+    struct pool_type {
+        void clear()
+        {
+            m_cfs.clear();
+            m_cfs.shrink_to_fit();
+            m_limbs = 0u;
+        }
+        std::vector<Cf> m_cfs;
+        std::size_t m_limbs = 0u;
+        unsigned long m_resize_count = thread_pool_resize_count();
+    };
+    // Return the pool of the calling thread, emptying it first if the thread pool was resized
+    // since the last call.
+    static pool_type &pool()
+    {
+        static thread_local pool_type p;
+        const auto rc = thread_pool_resize_count();
+        if (unlikely(rc != p.m_resize_count)) {
+            p.clear();
+            p.m_resize_count = rc;
+        }
+        return p;
+    }
+#endif
+};
+
+template <typename Cf>
+const std::size_t cf_recycler<Cf>::max_size;
+
+template <typename Cf>
+const std::size_t cf_recycler<Cf>::max_cf_limbs;
+
+template <typename Cf>
+const std::size_t cf_recycler<Cf>::max_limbs;
+}
+}
+
+#endif
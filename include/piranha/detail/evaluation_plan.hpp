@@ -0,0 +1,367 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_EVALUATION_PLAN_HPP
+#define PIRANHA_DETAIL_EVALUATION_PLAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <piranha/config.hpp>
+#include <piranha/detail/monomial_common.hpp>
+#include <piranha/detail/thread_partition.hpp>
+#include <piranha/exceptions.hpp>
+#include <piranha/integer.hpp>
+#include <piranha/math.hpp>
+#include <piranha/math/pow.hpp>
+#include <piranha/settings.hpp>
+#include <piranha/symbol_utils.hpp>
+#include <piranha/thread_pool.hpp>
+#include <piranha/type_traits.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// Wrapper to do multadd in the evaluation of series either via math::multiply_accumulate(), if supported, or just
+// plain math operators.
+template <typename E, enable_if_t<has_multiply_accumulate<E>::value, int> = 0>
+inline void series_eval_multadd(E &retval, const E &a, const E &b)
+{
+    math::multiply_accumulate(retval, a, b);
+}
+
+template <typename E1, typename E2, typename E3>
+inline void series_eval_multadd(E1 &retval, const E2 &a, const E3 &b)
+{
+    retval += a * b;
+}
+
+// Detect if the addition of values of type T is exact, so that the result of a sum does not depend on the order of
+// the operations.
+template <typename T>
+using series_eval_is_exact = disjunction<std::is_integral<T>, mppp::is_integer<T>, mppp::is_rational<T>>;
+
+// Evaluation plan for series whose keys evaluate to products of powers of the values of the symbols (see
+// key_power_exponents). The exponents of all the terms are unpacked once, at construction, into a flat
+// array. At evaluation time, for each symbol a table of the powers of its value is built, covering the range
+// of exponents in which the symbol appears in the series, so that the evaluation of a key reduces to table lookups
+// and multiplications. The terms are then evaluated, possibly in parallel, and summed.
+// NOTE: the terms are kept in the iteration order of the series, which is also the order in which they are laid
+// out in memory, and the result is the same as the one of the term-by-term evaluation. The terms are evaluated in
+// parallel only if the evaluation type is exact (see series_eval_is_exact), as the reduction of the partial sums
+// would otherwise make the result depend on the number of threads.
+// NOTE: the plan refers to the terms of the series, which must outlive it and must not be modified.
+template <typename Series>
+class series_evaluation_plan
+{
+    using term_type = typename Series::term_type;
+    using cf_type = typename term_type::cf_type;
+    using key_type = typename term_type::key_type;
+    using expo_type = key_power_exponents_t<key_type>;
+    using uexpo_type = typename std::make_unsigned<expo_type>::type;
+    using size_type = typename std::vector<expo_type>::size_type;
+    // Run f(thread_idx, begin, end) on n_threads threads, where [begin, end) is the range of [0, size)
+    // assigned to the thread.
+    template <typename F>
+    static void run_threads(unsigned n_threads, size_type size, const F &f)
+    {
+        auto thread_func = [&f, n_threads, size](unsigned thread_idx) {
+            const auto r = thread_partition(size, n_threads, thread_idx);
+            f(thread_idx, r.first, r.second);
+        };
+        future_list<void> ff_list;
+        try {
+            for (unsigned i = 0u; i < n_threads; ++i) {
+                ff_list.push_back(thread_pool::enqueue(i, thread_func, i));
+            }
+            // First let's wait for everything to finish.
+            ff_list.wait_all();
+            // Then, let's handle the exceptions.
+            ff_list.get_all();
+        } catch (...) {
+            ff_list.wait_all();
+            throw;
+        }
+    }
+    // Index of the exponent e of the symbol j in its table of powers.
+    // NOTE: the difference must be cast back to uexpo_type before widening, as for exponent types narrower
+    // than int the operands are promoted to int and the difference can be negative.
+    size_type table_idx(size_type j, const expo_type &e) const
+    {
+        return static_cast<size_type>(
+            static_cast<uexpo_type>(static_cast<uexpo_type>(e) - static_cast<uexpo_type>(m_min[j])));
+    }
+
+public:
+    // Number of points in the chunks of the batch evaluation.
+    static const size_type batch_chunk_size = 64u;
+    // The type of the powers of the values.
+    template <typename T>
+    using pow_type = decltype(piranha::pow(std::declval<const T &>(), std::declval<const expo_type &>()));
+    // The type of the evaluation of the coefficients.
+    template <typename T>
+    using cf_eval_type
+        = decltype(math::evaluate(std::declval<const cf_type &>(), std::declval<const symbol_fmap<T> &>()));
+    // The evaluation type.
+    template <typename T>
+    using eval_type = decltype(std::declval<const cf_eval_type<T> &>() * std::declval<const pow_type<T> &>());
+    explicit series_evaluation_plan(const Series &s) : m_n_syms(s.get_symbol_set().size())
+    {
+        const auto &ss = s.get_symbol_set();
+        const auto &c = s._container();
+        m_terms.reserve(c.size());
+        std::vector<expo_type> tmp;
+        for (const auto &t : c) {
+            key_power_exponents<key_type>::get(t.m_key, ss, tmp);
+            piranha_assert(tmp.size() == m_n_syms);
+            if (m_terms.empty()) {
+                m_min = tmp;
+                m_max = tmp;
+            } else {
+                for (size_type j = 0u; j < m_n_syms; ++j) {
+                    m_min[j] = std::min(m_min[j], tmp[j]);
+                    m_max[j] = std::max(m_max[j], tmp[j]);
+                }
+            }
+            m_expos.insert(m_expos.end(), tmp.begin(), tmp.end());
+            m_terms.push_back(&t);
+        }
+        // NOTE: if the range of the exponents of a symbol is wider than the number of terms, its powers
+        // are computed on the fly. This is a tuning parameter.
+        const integer n_terms(m_terms.size());
+        for (size_type j = 0u; j < m_n_syms; ++j) {
+            m_tabulate.push_back(integer(m_max[j]) - integer(m_min[j]) < n_terms);
+        }
+    }
+    series_evaluation_plan(const series_evaluation_plan &) = default;
+    series_evaluation_plan(series_evaluation_plan &&) = default;
+    series_evaluation_plan &operator=(const series_evaluation_plan &) = default;
+    series_evaluation_plan &operator=(series_evaluation_plan &&) = default;
+    // Evaluate the series. values contains the values of the symbols of the series, in the order of the symbol set,
+    // dict is used for the evaluation of the coefficients.
+    template <typename T>
+    eval_type<T> evaluate(const std::vector<T> &values, const symbol_fmap<T> &dict) const
+    {
+        if (unlikely(values.size() != m_n_syms)) {
+            piranha_throw(std::invalid_argument, "invalid vector of values for the evaluation of a series: the size of "
+                                                 "the vector of values ("
+                                                     + std::to_string(values.size())
+                                                     + ") differs from the number of symbols of the series ("
+                                                     + std::to_string(m_n_syms) + ")");
+        }
+        if (m_terms.empty()) {
+            return eval_type<T>(0);
+        }
+        // Build the tables of powers.
+        std::vector<std::vector<pow_type<T>>> tables(m_n_syms);
+        for (size_type j = 0u; j < m_n_syms; ++j) {
+            if (!m_tabulate[j]) {
+                continue;
+            }
+            for (auto k = m_min[j];; ++k) {
+                tables[j].push_back(piranha::pow(values[j], k));
+                if (k == m_max[j]) {
+                    break;
+                }
+            }
+        }
+        // Power of the value of the symbol j, for the exponent e.
+        auto pow_j = [this, &tables, &values](size_type j, const expo_type &e) -> pow_type<T> {
+            if (!m_tabulate[j]) {
+                return piranha::pow(values[j], e);
+            }
+            return tables[j][table_idx(j, e)];
+        };
+        auto sum_range = [this, &pow_j, &dict](size_type begin, size_type end) {
+            eval_type<T> retval(0);
+            for (auto i = begin; i < end; ++i) {
+                const auto e = m_expos.data() + i * m_n_syms;
+                // NOTE: same order of operations as in the evaluation of the keys.
+                pow_type<T> key_value(m_n_syms ? pow_j(0u, e[0u]) : pow_type<T>(1));
+                for (size_type j = 1u; j < m_n_syms; ++j) {
+                    key_value *= pow_j(j, e[j]);
+                }
+                series_eval_multadd(retval, math::evaluate(m_terms[i]->m_cf, dict), key_value);
+            }
+            return retval;
+        };
+        const auto n_threads
+            = series_eval_is_exact<eval_type<T>>::value
+                  ? thread_pool::use_threads(integer(m_terms.size()), integer(settings::get_min_work_per_thread()))
+                  : 1u;
+        if (n_threads == 1u) {
+            return sum_range(0u, m_terms.size());
+        }
+        // Each thread evaluates a range of terms, then the partial sums are added up.
+        std::vector<eval_type<T>> partials;
+        partials.reserve(n_threads);
+        for (unsigned i = 0u; i < n_threads; ++i) {
+            partials.emplace_back(0);
+        }
+        run_threads(n_threads, m_terms.size(), [&sum_range, &partials](unsigned thread_idx, size_type begin,
+                                                                       size_type end) {
+            partials[thread_idx] = sum_range(begin, end);
+        });
+        eval_type<T> retval(std::move(partials[0u]));
+        for (unsigned i = 1u; i < n_threads; ++i) {
+            retval += std::move(partials[i]);
+        }
+        return retval;
+    }
+    // Evaluate the series at n_points points. fill(begin, end, vals) must write into vals the values of the
+    // symbols of the series at the points in the range [begin, end): the size of vals is n_symbols() * (end - begin),
+    // and the values of each symbol over the points are contiguous. The coefficients are evaluated only once, via
+    // dict, and thus they must not depend on the point.
+    // The points are processed in chunks of batch_chunk_size elements, one term at a time, so that the innermost
+    // loops run over contiguous arrays of points. If allow_threads is true, the chunks are split among threads.
+    // For each point, the result is the same as the one of evaluate().
+    template <typename T, typename F>
+    std::vector<eval_type<T>> evaluate_batch(size_type n_points, const F &fill, const symbol_fmap<T> &dict,
+                                             bool allow_threads) const
+    {
+        std::vector<eval_type<T>> retval;
+        retval.reserve(n_points);
+        for (size_type p = 0u; p < n_points; ++p) {
+            retval.emplace_back(0);
+        }
+        if (!n_points || m_terms.empty()) {
+            return retval;
+        }
+        std::vector<cf_eval_type<T>> cfs;
+        cfs.reserve(m_terms.size());
+        for (const auto t : m_terms) {
+            cfs.push_back(math::evaluate(t->m_cf, dict));
+        }
+        auto eval_chunks = [this, n_points, &fill, &cfs, &retval](unsigned, size_type c_begin, size_type c_end) {
+            // Values, tables of powers and key values for the current chunk, reused across chunks.
+            std::vector<T> vals;
+            std::vector<std::vector<pow_type<T>>> tables(m_n_syms);
+            std::vector<pow_type<T>> kv;
+            for (auto c = c_begin; c < c_end; ++c) {
+                const auto begin = c * batch_chunk_size, end = std::min(n_points, begin + batch_chunk_size);
+                const auto m = static_cast<size_type>(end - begin);
+                vals.resize(m_n_syms * m);
+                fill(begin, end, vals);
+                // The table of symbol j stores the powers of the values for the exponent k in
+                // the range [m * (k - min), m * (k - min + 1)).
+                for (size_type j = 0u; j < m_n_syms; ++j) {
+                    if (!m_tabulate[j]) {
+                        continue;
+                    }
+                    tables[j].clear();
+                    for (auto k = m_min[j];; ++k) {
+                        for (size_type p = 0u; p < m; ++p) {
+                            tables[j].push_back(piranha::pow(vals[j * m + p], k));
+                        }
+                        if (k == m_max[j]) {
+                            break;
+                        }
+                    }
+                }
+                for (size_type i = 0u; i < m_terms.size(); ++i) {
+                    const auto e = m_expos.data() + i * m_n_syms;
+                    // NOTE: same order of operations as in the evaluation of the keys.
+                    kv.clear();
+                    if (!m_n_syms) {
+                        kv.resize(m, pow_type<T>(1));
+                    } else if (m_tabulate[0u]) {
+                        const auto row = tables[0u].data() + table_idx(0u, e[0u]) * m;
+                        kv.assign(row, row + m);
+                    } else {
+                        for (size_type p = 0u; p < m; ++p) {
+                            kv.push_back(piranha::pow(vals[p], e[0u]));
+                        }
+                    }
+                    for (size_type j = 1u; j < m_n_syms; ++j) {
+                        if (m_tabulate[j]) {
+                            const auto row = tables[j].data() + table_idx(j, e[j]) * m;
+                            for (size_type p = 0u; p < m; ++p) {
+                                kv[p] *= row[p];
+                            }
+                        } else {
+                            for (size_type p = 0u; p < m; ++p) {
+                                kv[p] *= piranha::pow(vals[j * m + p], e[j]);
+                            }
+                        }
+                    }
+                    const auto out = retval.data() + begin;
+                    for (size_type p = 0u; p < m; ++p) {
+                        series_eval_multadd(out[p], cfs[i], kv[p]);
+                    }
+                }
+            }
+        };
+        const size_type n_chunks
+            = n_points / batch_chunk_size + static_cast<size_type>(n_points % batch_chunk_size != 0u);
+        const auto n_threads
+            = allow_threads ? thread_pool::use_threads(integer(n_points) * m_terms.size(),
+                                                       integer(settings::get_min_work_per_thread()))
+                            : 1u;
+        if (n_threads == 1u) {
+            eval_chunks(0u, 0u, n_chunks);
+        } else {
+            // NOTE: each thread writes into its own range of the return value, no reduction is needed.
+            run_threads(n_threads, n_chunks, eval_chunks);
+        }
+        return retval;
+    }
+    // Number of symbols of the series.
+    size_type n_symbols() const
+    {
+        return m_n_syms;
+    }
+
+private:
+    size_type m_n_syms;
+    std::vector<const term_type *> m_terms;
+    // The exponents of the terms, stored contiguously.
+    std::vector<expo_type> m_expos;
+    // Minimum and maximum exponents of each symbol.
+    std::vector<expo_type> m_min;
+    std::vector<expo_type> m_max;
+    // Flags signalling if the powers of each symbol are tabulated.
+    std::vector<bool> m_tabulate;
+};
+
+template <typename Series>
+const typename series_evaluation_plan<Series>::size_type series_evaluation_plan<Series>::batch_chunk_size;
+}
+}
+
+#endif
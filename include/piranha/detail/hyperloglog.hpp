@@ -0,0 +1,106 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_HYPERLOGLOG_HPP
+#define PIRANHA_DETAIL_HYPERLOGLOG_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <piranha/config.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// HyperLogLog sketch for the approximate counting of the distinct elements of a multiset
+// (Flajolet et al., 2007). The sketch uses 2**12 registers, yielding a standard error of about 1.6%.
+// The input values are mixed internally, so that they need not be well-distributed hashes.
+class hyperloglog
+{
+    static const unsigned nbits = 12u;
+    static const std::size_t nregs = std::size_t(1) << nbits;
+
+public:
+    hyperloglog()
+    {
+        m_regs.fill(0u);
+    }
+    void add(std::uint64_t x)
+    {
+        // The finaliser of splitmix64.
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        x = x ^ (x >> 31);
+        // The top bits select the register, the position of the first set bit in the
+        // remaining ones is the rank. The guard bit caps the rank to 64 - nbits + 1.
+        const auto idx = static_cast<std::size_t>(x >> (64u - nbits));
+        std::uint64_t rest = (x << nbits) | (std::uint64_t(1) << (nbits - 1u));
+        unsigned char rank = 1u;
+        while (!(rest & (std::uint64_t(1) << 63u))) {
+            rest <<= 1u;
+            ++rank;
+        }
+        m_regs[idx] = std::max(m_regs[idx], rank);
+    }
+    void merge(const hyperloglog &other)
+    {
+        for (std::size_t i = 0u; i < nregs; ++i) {
+            m_regs[i] = std::max(m_regs[i], other.m_regs[i]);
+        }
+    }
+    double estimate() const
+    {
+        const double m = static_cast<double>(nregs), alpha = 0.7213 / (1. + 1.079 / m);
+        double sum = 0.;
+        std::size_t n_zeros = 0u;
+        for (const auto &r : m_regs) {
+            sum += std::ldexp(1., -static_cast<int>(r));
+            n_zeros += static_cast<std::size_t>(r == 0u);
+        }
+        const double raw = alpha * m * m / sum;
+        // Small range correction (linear counting). With 64-bit hashes, no large range
+        // correction is needed.
+        if (raw <= 2.5 * m && n_zeros) {
+            return m * std::log(m / static_cast<double>(n_zeros));
+        }
+        return raw;
+    }
+
+private:
+    std::array<unsigned char, nregs> m_regs;
+};
+}
+}
+
+#endif
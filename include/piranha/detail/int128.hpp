@@ -0,0 +1,91 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_INT128_HPP
+#define PIRANHA_DETAIL_INT128_HPP
+
+#include <piranha/config.hpp>
+
+#if defined(PIRANHA_HAVE_GCC_INT128)
+
+#include <cstddef>
+#include <limits>
+
+#include <mp++/integer.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// NOTE: the __extension__ keyword silences the pedantic diagnostics about the non-standard 128-bit types.
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+// Absolute value of a machine word, as an unsigned word (so that it is defined also for the minimum value).
+inline unsigned long long word_abs(long long n)
+{
+    return n < 0 ? 0ull - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+}
+
+// Check whether the sum of n products of machine words bounded in absolute value by max1 and max2
+// is guaranteed to fit in a 128-bit signed integer.
+inline bool int128_accumulation_safe(unsigned long long max1, unsigned long long max2, unsigned long long n)
+{
+    // NOTE: max1 * max2 is at most 2**126, which fits in the unsigned 128-bit type.
+    const uint128_t prod = static_cast<uint128_t>(max1) * max2;
+    const uint128_t limit = (uint128_t(1) << 127u) - 1u;
+    return n == 0u || prod <= limit / n;
+}
+
+// Write into out the value of a 128-bit signed integer.
+template <std::size_t SSize>
+inline void int128_to_integer(mppp::integer<SSize> &out, int128_t n)
+{
+    using int_t = mppp::integer<SSize>;
+    if (n >= std::numeric_limits<long long>::min() && n <= std::numeric_limits<long long>::max()) {
+        out = static_cast<long long>(n);
+        return;
+    }
+    const bool negative = n < 0;
+    const uint128_t m = negative ? uint128_t(0) - static_cast<uint128_t>(n) : static_cast<uint128_t>(n);
+    int_t shift(1ull << 32u);
+    mul(shift, shift, shift);
+    mul(out, int_t(static_cast<unsigned long long>(m >> 64u)), shift);
+    add(out, out, int_t(static_cast<unsigned long long>(m)));
+    if (negative) {
+        out.neg();
+    }
+}
+}
+}
+
+#endif
+
+#endif
@@ -113,6 +113,17 @@ inline void monomial_pow_mult_exp(T &ret, const T &exp, const U &x, const std::i
 // The enabler.
 template <typename T, typename U>
 using monomial_pow_enabler = enable_if_t<(monomial_pow_dispatcher<T, U>::value < 4u), int>;
+
+// Extraction of the exponents of a key whose evaluation is the product of the powers of the values of the
+// symbols, used in the evaluation plans of series. The keys with C++ integral exponents specialise this class,
+// providing the exponent type as value_type and a static method get(k, s, out), which writes into the vector
+// out the exponents of the key k with respect to the symbol set s.
+template <typename Key, typename = void>
+struct key_power_exponents {
+};
+
+template <typename Key>
+using key_power_exponents_t = typename key_power_exponents<Key>::value_type;
 }
 }
 
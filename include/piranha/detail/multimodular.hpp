@@ -0,0 +1,221 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_MULTIMODULAR_HPP
+#define PIRANHA_DETAIL_MULTIMODULAR_HPP
+
+#include <piranha/config.hpp>
+
+#if defined(PIRANHA_HAVE_GCC_INT128)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <mp++/integer.hpp>
+
+#include <piranha/detail/int128.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// The largest primes below 2**63, used in the multimodular multiplication. The residues are stored
+// in 64-bit unsigned integers, and the product of two residues plus a residue fits in 128 bits.
+inline const std::array<std::uint64_t, 16u> &mm_primes()
+{
+    static const std::array<std::uint64_t, 16u> primes
+        = {{0x7fffffffffffffe7ull, 0x7fffffffffffff5bull, 0x7ffffffffffffefdull, 0x7ffffffffffffed3ull,
+            0x7ffffffffffffe89ull, 0x7ffffffffffffe7dull, 0x7ffffffffffffe79ull, 0x7ffffffffffffe67ull,
+            0x7ffffffffffffe37ull, 0x7ffffffffffffe29ull, 0x7ffffffffffffdfbull, 0x7ffffffffffffdefull,
+            0x7ffffffffffffddbull, 0x7ffffffffffffd8dull, 0x7ffffffffffffd77ull, 0x7ffffffffffffd63ull}};
+    return primes;
+}
+
+// A word-sized modulus, with the precomputed reciprocal used to reduce double-word integers without a 128-bit
+// division. See N. Moller and T. Granlund, "Improved division by invariant integers", IEEE Transactions on
+// Computers, 2011 (algorithm 4).
+class mm_modulus
+{
+public:
+    explicit mm_modulus(std::uint64_t p) : m_p(p), m_shift(0u)
+    {
+        piranha_assert(p);
+        // Normalise the divisor, so that its most significant bit is set.
+        while (!((p << m_shift) & (std::uint64_t(1u) << 63u))) {
+            ++m_shift;
+        }
+        m_d = p << m_shift;
+        // NOTE: the quotient is in the [2**64, 2**65) range, the truncation subtracts 2**64.
+        m_v = static_cast<std::uint64_t>(~uint128_t(0u) / m_d);
+    }
+    std::uint64_t get() const
+    {
+        return m_p;
+    }
+    // Compute x mod p. x must be less than p * 2**64.
+    std::uint64_t reduce(uint128_t x) const
+    {
+        x <<= m_shift;
+        const auto u1 = static_cast<std::uint64_t>(x >> 64u), u0 = static_cast<std::uint64_t>(x);
+        piranha_assert(u1 < m_d);
+        // NOTE: all the computations are modulo 2**64 or 2**128.
+        const uint128_t q = static_cast<uint128_t>(m_v) * u1 + ((static_cast<uint128_t>(u1 + 1u) << 64u) | u0);
+        const auto q1 = static_cast<std::uint64_t>(q >> 64u), q0 = static_cast<std::uint64_t>(q);
+        auto r = static_cast<std::uint64_t>(u0 - q1 * m_d);
+        if (r > q0) {
+            r += m_d;
+        }
+        if (r >= m_d) {
+            r -= m_d;
+        }
+        return r >> m_shift;
+    }
+
+private:
+    std::uint64_t m_p;
+    unsigned m_shift;
+    std::uint64_t m_d;
+    std::uint64_t m_v;
+};
+
+// The moduli corresponding to mm_primes().
+inline const std::vector<mm_modulus> &mm_moduli()
+{
+    static const std::vector<mm_modulus> moduli = []() {
+        std::vector<mm_modulus> retval;
+        for (const auto p : mm_primes()) {
+            retval.emplace_back(p);
+        }
+        return retval;
+    }();
+    return moduli;
+}
+
+// Compute (a + b * c) mod p, with a, b and c already reduced modulo p.
+inline std::uint64_t mm_fma(std::uint64_t a, std::uint64_t b, std::uint64_t c, const mm_modulus &m)
+{
+    // NOTE: b * c + a <= (p - 1) ** 2 + p - 1 < p * 2**64.
+    return m.reduce(static_cast<uint128_t>(b) * c + a);
+}
+
+inline std::uint64_t mm_pow(std::uint64_t b, std::uint64_t e, const mm_modulus &m)
+{
+    std::uint64_t retval = 1u;
+    for (; e; e >>= 1u) {
+        if (e & 1u) {
+            retval = mm_fma(0u, retval, b, m);
+        }
+        b = mm_fma(0u, b, b, m);
+    }
+    return retval;
+}
+
+// Residue of an mp++ integer modulo p, in the [0, p) range. mp_p is p as an mp++ integer, q and r are
+// work variables.
+template <std::size_t SSize>
+inline std::uint64_t mm_reduce(const mppp::integer<SSize> &n, std::uint64_t p, const mppp::integer<SSize> &mp_p,
+                               mppp::integer<SSize> &q, mppp::integer<SSize> &r)
+{
+    // NOTE: the sign of r is the sign of n.
+    tdiv_qr(q, r, n, mp_p);
+    long long tmp = 0;
+    const bool ok = r.get(tmp);
+    (void)ok;
+    piranha_assert(ok);
+    return tmp < 0 ? static_cast<std::uint64_t>(static_cast<std::uint64_t>(tmp) + p) : static_cast<std::uint64_t>(tmp);
+}
+
+// Chinese remainder reconstruction of an integer from its residues modulo the first n primes of mm_primes(),
+// via Garner's mixed-radix algorithm. The result is in the symmetric range (-M / 2, M / 2], where M is the
+// product of the primes.
+template <typename Int>
+class mm_crt
+{
+    using int_t = Int;
+
+public:
+    explicit mm_crt(std::size_t n) : m_n(n), m_mod(1)
+    {
+        const auto &primes = mm_primes();
+        const auto &moduli = mm_moduli();
+        piranha_assert(n > 0u && n <= primes.size());
+        // The inverse of the product of the first i primes modulo the i-th prime.
+        m_inv.push_back(0u);
+        for (std::size_t i = 1u; i < n; ++i) {
+            std::uint64_t prod = 1u;
+            for (std::size_t j = 0u; j < i; ++j) {
+                prod = mm_fma(0u, prod, primes[j] % primes[i], moduli[i]);
+            }
+            m_inv.push_back(mm_pow(prod, primes[i] - 2u, moduli[i]));
+        }
+        for (std::size_t i = 0u; i < n; ++i) {
+            m_mod *= primes[i];
+        }
+        m_half_mod = m_mod / 2;
+    }
+    // Write into out the integer whose residues are r[0], ..., r[n - 1]. v is a work area of size n.
+    void reconstruct(int_t &out, const std::uint64_t *r, std::uint64_t *v) const
+    {
+        const auto &primes = mm_primes();
+        const auto &moduli = mm_moduli();
+        // The mixed-radix digits.
+        for (std::size_t i = 0u; i < m_n; ++i) {
+            const auto p = primes[i];
+            std::uint64_t tmp = 0u;
+            for (std::size_t j = i; j > 0u; --j) {
+                tmp = mm_fma(v[j - 1u] % p, tmp, primes[j - 1u] % p, moduli[i]);
+            }
+            // NOTE: here tmp < p and r[i] < p.
+            v[i] = i ? mm_fma(0u, r[i] >= tmp ? r[i] - tmp : r[i] + (p - tmp), m_inv[i], moduli[i]) : r[i];
+        }
+        out = v[m_n - 1u];
+        for (std::size_t j = m_n - 1u; j > 0u; --j) {
+            out *= primes[j - 1u];
+            out += v[j - 1u];
+        }
+        if (out > m_half_mod) {
+            out -= m_mod;
+        }
+    }
+
+private:
+    std::size_t m_n;
+    std::vector<std::uint64_t> m_inv;
+    int_t m_mod;
+    int_t m_half_mod;
+};
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_NODE_ARENA_HPP
+#define PIRANHA_DETAIL_NODE_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <piranha/config.hpp>
+#include <piranha/detail/atomic_lock_guard.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// A sharded slab allocator for objects of type T. Each shard carves the storage for the objects out of
+// slabs of geometrically increasing size, and keeps the storage returned via deallocate() in a free list
+// for later reuse. The memory is returned to the system only when release() is called or the arena is
+// destroyed, at which point all the slabs are freed at once. The arena deals only with raw storage:
+// constructing and destroying the objects is up to the user.
+// Each shard is protected by its own spinlock, so that allocate() and deallocate() can be called concurrently.
+// The idea is that threads operating on different shards (e.g., on different ranges of buckets of a hash set)
+// do not contend for the same lock, and that the objects allocated from the same shard are close in memory.
+template <typename T>
+class node_arena
+{
+    using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    // Entry of the free list, constructed in the storage of a deallocated object.
+    struct free_entry {
+        free_entry *m_next;
+    };
+    static_assert(sizeof(storage_type) >= sizeof(free_entry) && alignof(storage_type) >= alignof(free_entry),
+                  "Invalid storage type.");
+    struct shard {
+        shard() : m_cur(nullptr), m_left(0u), m_next_size(min_slab_size), m_free(nullptr)
+        {
+            m_lock.clear();
+        }
+        std::atomic_flag m_lock;
+        std::vector<std::unique_ptr<storage_type[]>> m_slabs;
+        // Next available slot in the last slab, and number of available slots.
+        storage_type *m_cur;
+        std::size_t m_left;
+        // Size of the next slab.
+        std::size_t m_next_size;
+        free_entry *m_free;
+    };
+
+public:
+    // Minimum and maximum number of objects in a slab.
+    static const std::size_t min_slab_size = 64u;
+    static const std::size_t max_slab_size = 65536u;
+    explicit node_arena(std::size_t n_shards)
+    {
+        piranha_assert(n_shards);
+        // NOTE: the shards are allocated separately in order to avoid false sharing
+        // between the spinlocks.
+        m_shards.reserve(n_shards);
+        for (std::size_t i = 0u; i < n_shards; ++i) {
+            m_shards.emplace_back(::new shard());
+        }
+    }
+    node_arena(const node_arena &) = delete;
+    node_arena(node_arena &&) = delete;
+    node_arena &operator=(const node_arena &) = delete;
+    node_arena &operator=(node_arena &&) = delete;
+    std::size_t n_shards() const
+    {
+        return m_shards.size();
+    }
+    // Get storage for an object of type T from the shard idx.
+    void *allocate(std::size_t idx)
+    {
+        piranha_assert(idx < m_shards.size());
+        auto &s = *m_shards[idx];
+        atomic_lock_guard lock(s.m_lock);
+        if (s.m_free) {
+            auto retval = s.m_free;
+            s.m_free = retval->m_next;
+            retval->~free_entry();
+            return static_cast<void *>(retval);
+        }
+        if (unlikely(!s.m_left)) {
+            std::unique_ptr<storage_type[]> new_slab(::new storage_type[s.m_next_size]);
+            s.m_slabs.push_back(std::move(new_slab));
+            s.m_cur = s.m_slabs.back().get();
+            s.m_left = s.m_next_size;
+            s.m_next_size = std::min<std::size_t>(s.m_next_size * 2u, max_slab_size);
+        }
+        --s.m_left;
+        return static_cast<void *>(s.m_cur++);
+    }
+    // Return the storage pointed to by p to the shard idx. p must have been returned by allocate(), possibly
+    // from a different shard, and the object stored in it must have been destroyed.
+    void deallocate(void *p, std::size_t idx)
+    {
+        piranha_assert(idx < m_shards.size());
+        auto &s = *m_shards[idx];
+        atomic_lock_guard lock(s.m_lock);
+        s.m_free = ::new (p) free_entry{s.m_free};
+    }
+    // Free all the slabs. All the storage returned by allocate() is invalidated. This is not thread-safe.
+    void release()
+    {
+        for (auto &p : m_shards) {
+            p->m_slabs.clear();
+            p->m_cur = nullptr;
+            p->m_left = 0u;
+            p->m_next_size = min_slab_size;
+            p->m_free = nullptr;
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<shard>> m_shards;
+};
+
+template <typename T>
+const std::size_t node_arena<T>::min_slab_size;
+
+template <typename T>
+const std::size_t node_arena<T>::max_slab_size;
+}
+}
+
+#endif
@@ -0,0 +1,339 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_POW_CACHE_HPP
+#define PIRANHA_DETAIL_POW_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <piranha/config.hpp>
+
+namespace piranha
+{
+
+/// Statistics of the cache of natural powers of series.
+/**
+ * @see piranha::series::get_pow_cache_stats().
+ */
+struct pow_cache_stats {
+    /// Number of exponentiations served from the cache.
+    unsigned long long hits;
+    /// Number of exponentiations which needed the computation of new powers.
+    unsigned long long misses;
+    /// Number of bases evicted from the cache because of the budget on its memory footprint.
+    unsigned long long evictions;
+    /// Number of bases in the cache.
+    std::size_t entries;
+    /// Estimated memory footprint (in bytes) of the cached powers.
+    std::size_t bytes;
+};
+
+namespace detail
+{
+
+// A concurrent cache of the natural powers of objects of type Base, stored as objects of type Power.
+// The entries (one per base) are distributed among shards according to the hash of the base, and each shard
+// is protected by a mutex which is held only during the lookup. The powers of a base are computed while
+// holding only the mutex of its entry, so that the computations of the powers of different bases proceed
+// in parallel. The cache is bounded by a budget on the estimated memory footprint of the cached powers
+// (as computed by the ByteSize functor): when the budget is exceeded, whole entries are evicted in least
+// recently used order.
+template <typename Base, typename Power, typename Hash, typename Equal, typename ByteSize>
+class pow_cache
+{
+    struct entry {
+        std::mutex m_mutex;
+        // The powers, from 0 onwards. Protected by m_mutex.
+        std::vector<Power> m_powers;
+        // Estimated footprint of m_powers. Protected by m_mutex.
+        std::size_t m_bytes = 0u;
+        // Set when the entry is removed from the cache. Protected by m_mutex.
+        bool m_evicted = false;
+        // Value of the cache's clock at the last access.
+        std::atomic<unsigned long long> m_last_use{0u};
+        // Set while the entry is stored in the map of its shard, in which case m_key points to the key
+        // of the entry in the map. Protected by the mutex of the shard.
+        bool m_in_map = false;
+        const Base *m_key = nullptr;
+    };
+    using entry_ptr = std::shared_ptr<entry>;
+    struct shard {
+        std::mutex m_mutex;
+        std::unordered_map<Base, entry_ptr, Hash, Equal> m_map;
+    };
+    // NOTE: this is a tuning parameter.
+    static const std::size_t n_shards = 16u;
+
+public:
+    // Default budget for the estimated memory footprint of the cache: 1 GB.
+    static const std::size_t default_budget = std::size_t(1u) << 30u;
+    pow_cache() : m_clock(0u), m_bytes(0u), m_budget(default_budget), m_hits(0u), m_misses(0u), m_evictions(0u) {}
+    pow_cache(const pow_cache &) = delete;
+    pow_cache(pow_cache &&) = delete;
+    pow_cache &operator=(const pow_cache &) = delete;
+    pow_cache &operator=(pow_cache &&) = delete;
+    // Construct an object of type Ret from base raised to the power of n. If the power is not in the cache,
+    // the missing powers of base are computed: the power 0 is constructed via init(), the power i + 1 via
+    // next(p), where p is the power i.
+    template <typename Ret, typename Init, typename Next>
+    Ret get(const Base &base, std::size_t n, const Init &init, const Next &next)
+    {
+        const auto e = fetch_entry(base);
+        bool over_budget = false;
+        Ret retval;
+        {
+            std::lock_guard<std::mutex> lock(e->m_mutex);
+            if (e->m_powers.size() > n) {
+                ++m_hits;
+            } else {
+                ++m_misses;
+                // NOTE: in case of exceptions, the powers already computed are kept.
+                if (e->m_powers.empty()) {
+                    e->m_powers.push_back(init());
+                    account(*e, e->m_powers.back());
+                }
+                while (e->m_powers.size() <= n) {
+                    e->m_powers.push_back(next(e->m_powers.back()));
+                    account(*e, e->m_powers.back());
+                }
+                over_budget = m_bytes.load() > m_budget.load();
+            }
+            retval = Ret(e->m_powers[n]);
+        }
+        if (over_budget) {
+            evict();
+        }
+        return retval;
+    }
+    // If base raised to the power of n is in the cache, construct retval from it and return true. Otherwise,
+    // return false without modifying the cache.
+    template <typename Ret>
+    bool find(const Base &base, std::size_t n, Ret &retval)
+    {
+        entry_ptr e;
+        {
+            auto &s = m_shards[Hash{}(base) % n_shards];
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+            const auto it = s.m_map.find(base);
+            if (it == s.m_map.end()) {
+                return false;
+            }
+            e = it->second;
+        }
+        std::lock_guard<std::mutex> lock(e->m_mutex);
+        if (e->m_powers.size() <= n) {
+            return false;
+        }
+        ++m_hits;
+        e->m_last_use.store(++m_clock);
+        retval = Ret(e->m_powers[n]);
+        return true;
+    }
+    // Remove the entry of base from the cache. Returns true if the entry was found.
+    bool erase(const Base &base)
+    {
+        entry_ptr e;
+        {
+            auto &s = m_shards[Hash{}(base) % n_shards];
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+            const auto it = s.m_map.find(base);
+            if (it == s.m_map.end()) {
+                return false;
+            }
+            e = std::move(it->second);
+            e->m_in_map = false;
+            s.m_map.erase(it);
+        }
+        retire(*e);
+        return true;
+    }
+    // Remove all the entries.
+    void clear()
+    {
+        for (auto &s : m_shards) {
+            std::vector<entry_ptr> removed;
+            {
+                std::lock_guard<std::mutex> lock(s.m_mutex);
+                removed.reserve(s.m_map.size());
+                for (auto &p : s.m_map) {
+                    p.second->m_in_map = false;
+                    removed.push_back(std::move(p.second));
+                }
+                s.m_map.clear();
+            }
+            // NOTE: the mutexes of the entries are acquired without holding the lock on the shard,
+            // as they can be held for a long time by a concurrent computation of the powers.
+            for (const auto &e : removed) {
+                retire(*e);
+            }
+        }
+    }
+    void set_budget(std::size_t budget)
+    {
+        m_budget.store(budget);
+        if (m_bytes.load() > budget) {
+            evict();
+        }
+    }
+    std::size_t get_budget() const
+    {
+        return m_budget.load();
+    }
+    pow_cache_stats get_stats()
+    {
+        pow_cache_stats retval;
+        retval.hits = m_hits.load();
+        retval.misses = m_misses.load();
+        retval.evictions = m_evictions.load();
+        retval.entries = 0u;
+        for (auto &s : m_shards) {
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+            retval.entries += s.m_map.size();
+        }
+        retval.bytes = m_bytes.load();
+        return retval;
+    }
+    void reset_stats()
+    {
+        m_hits.store(0u);
+        m_misses.store(0u);
+        m_evictions.store(0u);
+    }
+
+private:
+    // Locate the entry of base, creating it if needed, and mark it as used.
+    entry_ptr fetch_entry(const Base &base)
+    {
+        auto &s = m_shards[Hash{}(base) % n_shards];
+        std::lock_guard<std::mutex> lock(s.m_mutex);
+        auto it = s.m_map.find(base);
+        if (it == s.m_map.end()) {
+            // NOTE: create the entry before inserting it, so that the map never contains null pointers.
+            it = s.m_map.emplace(base, std::make_shared<entry>()).first;
+            // NOTE: the elements of an unordered_map are not moved by rehashing, so the key can be
+            // referred to until the entry is removed from the map.
+            it->second->m_in_map = true;
+            it->second->m_key = &it->first;
+        }
+        it->second->m_last_use.store(++m_clock);
+        return it->second;
+    }
+    // Account for a new power p in the entry e. Must be called with the lock on e held.
+    void account(entry &e, const Power &p)
+    {
+        // NOTE: the entry might have been removed from the cache after the lookup. In such case,
+        // the powers are computed anyway but they are not part of the footprint of the cache.
+        if (e.m_evicted) {
+            return;
+        }
+        const auto b = ByteSize{}(p);
+        e.m_bytes += b;
+        m_bytes += b;
+    }
+    // Remove the footprint of an entry which was removed from its shard.
+    void retire(entry &e)
+    {
+        std::lock_guard<std::mutex> lock(e.m_mutex);
+        piranha_assert(!e.m_evicted);
+        e.m_evicted = true;
+        m_bytes -= e.m_bytes;
+        e.m_bytes = 0u;
+    }
+    // Evict entries in least recently used order until the footprint is within the budget. The entries whose
+    // powers are being computed are skipped.
+    void evict()
+    {
+        // Collect the entries with their last use time.
+        std::vector<std::tuple<unsigned long long, std::size_t, entry_ptr>> candidates;
+        for (std::size_t i = 0u; i < n_shards; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].m_mutex);
+            for (const auto &p : m_shards[i].m_map) {
+                candidates.emplace_back(p.second->m_last_use.load(), i, p.second);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const std::tuple<unsigned long long, std::size_t, entry_ptr> &a,
+                     const std::tuple<unsigned long long, std::size_t, entry_ptr> &b) {
+                      return std::get<0u>(a) < std::get<0u>(b);
+                  });
+        for (const auto &c : candidates) {
+            if (m_bytes.load() <= m_budget.load()) {
+                break;
+            }
+            auto &s = m_shards[std::get<1u>(c)];
+            const auto &e = std::get<2u>(c);
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+            // Skip the entries which have been removed from the shard in the meantime.
+            if (!e->m_in_map) {
+                continue;
+            }
+            std::unique_lock<std::mutex> e_lock(e->m_mutex, std::try_to_lock);
+            if (!e_lock.owns_lock()) {
+                continue;
+            }
+            piranha_assert(!e->m_evicted);
+            // Locate the entry via its key.
+            const auto it = s.m_map.find(*e->m_key);
+            piranha_assert(it != s.m_map.end() && it->second == e);
+            e->m_in_map = false;
+            s.m_map.erase(it);
+            e->m_evicted = true;
+            m_bytes -= e->m_bytes;
+            e->m_bytes = 0u;
+            ++m_evictions;
+        }
+    }
+
+private:
+    std::array<shard, n_shards> m_shards;
+    std::atomic<unsigned long long> m_clock;
+    std::atomic<std::size_t> m_bytes;
+    std::atomic<std::size_t> m_budget;
+    std::atomic<unsigned long long> m_hits;
+    std::atomic<unsigned long long> m_misses;
+    std::atomic<unsigned long long> m_evictions;
+};
+
+template <typename Base, typename Power, typename Hash, typename Equal, typename ByteSize>
+const std::size_t pow_cache<Base, Power, Hash, Equal, ByteSize>::n_shards;
+
+template <typename Base, typename Power, typename Hash, typename Equal, typename ByteSize>
+const std::size_t pow_cache<Base, Power, Hash, Equal, ByteSize>::default_budget;
+}
+}
+
+#endif
@@ -0,0 +1,55 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_PREFETCH_HPP
+#define PIRANHA_DETAIL_PREFETCH_HPP
+
+#include <piranha/config.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// Hint the processor to fetch into the cache the memory location at addr, in anticipation of a
+// read/write access in the near future. This is a no-op on compilers lacking the prefetch builtin.
+inline void prefetch(const void *addr)
+{
+#if defined(PIRANHA_COMPILER_IS_GCC) || defined(PIRANHA_COMPILER_IS_CLANG) || defined(PIRANHA_COMPILER_IS_INTEL)
+    // NOTE: the second argument signals an access for writing, the third one
+    // the maximum degree of temporal locality.
+    __builtin_prefetch(addr, 1, 3);
+#else
+    (void)addr;
+#endif
+}
+}
+}
+
+#endif
@@ -0,0 +1,226 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_SUBS_BATCHER_HPP
+#define PIRANHA_DETAIL_SUBS_BATCHER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include <piranha/detail/thread_partition.hpp>
+#include <piranha/symbol_utils.hpp>
+#include <piranha/thread_pool.hpp>
+#include <piranha/type_traits.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// Hashing of the values produced by the substitution of a term: the hash() method, if available (e.g., for series),
+// otherwise std::hash.
+// NOTE: the hash() method is checked first, so that is_hashable is not instantiated for series types.
+template <typename T>
+using subs_value_hash_method_t = decltype(std::declval<const T &>().hash());
+
+template <typename T, enable_if_t<std::is_same<detected_t<subs_value_hash_method_t, T>, std::size_t>::value, int> = 0>
+inline std::size_t subs_value_hash(const T &x)
+{
+    return x.hash();
+}
+
+template <typename T,
+          enable_if_t<conjunction<negation<std::is_same<detected_t<subs_value_hash_method_t, T>, std::size_t>>,
+                                  is_hashable<T>>::value,
+                      int> = 0>
+inline std::size_t subs_value_hash(const T &x)
+{
+    return std::hash<T>{}(x);
+}
+
+template <typename T>
+using subs_value_hash_t = decltype(subs_value_hash(std::declval<const T &>()));
+
+// The values can be grouped if they can be hashed and compared for equality.
+template <typename T>
+using subs_value_is_groupable
+    = conjunction<is_detected<subs_value_hash_t, T>, is_equality_comparable<addlref_t<const T>>>;
+
+// Coefficient type of a series type T.
+template <typename T>
+using subs_series_cf_t = typename T::term_type::cf_type;
+
+// Detect if the addition of values of type T is exact, so that the result of a sum does not depend on the order of
+// the additions: C++ integrals, mp++ integers and rationals, and series whose coefficients have exact additions.
+template <typename T, typename = void>
+struct subs_sum_is_exact : disjunction<std::is_integral<T>, mppp::is_integer<T>, mppp::is_rational<T>> {
+};
+
+template <typename T>
+struct subs_sum_is_exact<T, enable_if_t<is_detected<subs_series_cf_t, T>::value>>
+    : subs_sum_is_exact<subs_series_cf_t<T>> {
+};
+
+// Batched substitution. The substitution of a term results in one or more pairs (value, term), whose sum of
+// products is the result of the substitution. Instead of computing the products term by term, the terms are
+// grouped according to the values (e.g., in the substitution of x in a polynomial, all the terms with the same
+// exponent of x result in the same value), and all the terms of a group are inserted into the same series. The
+// result of the substitution is then computed with a single multiplication per group. If the values cannot
+// be hashed and compared, each term ends up in its own group.
+template <typename Value, typename Series>
+class subs_batcher
+{
+    using term_type = typename Series::term_type;
+    // Find the group of the value v, writing the hash of v into h. Returns null if the group does not exist.
+    template <typename T, enable_if_t<subs_value_is_groupable<T>::value, int> = 0>
+    Series *find_group(const T &v, std::size_t &h)
+    {
+        h = subs_value_hash(v);
+        const auto range = m_index.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (m_groups[it->second].first == v) {
+                return &m_groups[it->second].second;
+            }
+        }
+        return nullptr;
+    }
+    template <typename T, enable_if_t<!subs_value_is_groupable<T>::value, int> = 0>
+    Series *find_group(const T &, std::size_t &)
+    {
+        return nullptr;
+    }
+    // Add the last group, whose value has hash h, to the index.
+    template <typename T, enable_if_t<subs_value_is_groupable<T>::value, int> = 0>
+    void index_last_group(const T &, const std::size_t &h)
+    {
+        m_index.emplace(h, m_groups.size() - 1u);
+    }
+    template <typename T, enable_if_t<!subs_value_is_groupable<T>::value, int> = 0>
+    void index_last_group(const T &, const std::size_t &)
+    {
+    }
+
+public:
+    // NOTE: the products of the groups are computed in parallel only if there are enough groups, otherwise
+    // it is better to leave the threads to the series multiplications. This is a tuning parameter.
+    static const std::size_t min_groups_per_thread = 8u;
+    explicit subs_batcher(const symbol_fset &s_set) : m_s_set(s_set) {}
+    // Add the term t to the group of the value v.
+    void add(Value &&v, term_type &&t)
+    {
+        std::size_t h = 0u;
+        auto s = find_group(v, h);
+        if (s == nullptr) {
+            Series tmp;
+            tmp.set_symbol_set(m_s_set);
+            m_groups.emplace_back(std::move(v), std::move(tmp));
+            // NOTE: the index is updated only after the group has been appended, so that it never refers
+            // to a missing group. If the indexing throws, the group is just not found by the next values.
+            index_last_group(m_groups.back().first, h);
+            s = &m_groups.back().second;
+        }
+        s->insert(std::move(t));
+    }
+    std::size_t size() const
+    {
+        return m_groups.size();
+    }
+    // Compute the sum of mult(v, s) over all the groups (v, s). The groups are consumed. The products are computed
+    // in parallel only if the addition of values of type Ret is exact (see subs_sum_is_exact), as the reduction of
+    // the partial sums changes the order of the additions, and with floating-point coefficients the result would
+    // depend on the number of threads.
+    template <typename Ret, typename Mult>
+    Ret accumulate(const Mult &mult)
+    {
+        auto sum_range = [this, &mult](std::size_t begin, std::size_t end) {
+            Ret retval(0);
+            for (auto i = begin; i < end; ++i) {
+                retval += mult(std::move(m_groups[i].first), std::move(m_groups[i].second));
+            }
+            return retval;
+        };
+        const auto n_groups = m_groups.size();
+        if (!n_groups) {
+            return Ret(0);
+        }
+        const auto n_threads
+            = subs_sum_is_exact<Ret>::value ? thread_pool::use_threads(n_groups, min_groups_per_thread) : 1u;
+        if (n_threads == 1u) {
+            return sum_range(0u, n_groups);
+        }
+        // Each thread accumulates the products of a range of groups, then the partial sums are added up.
+        std::vector<Ret> partials;
+        partials.reserve(n_threads);
+        for (unsigned i = 0u; i < n_threads; ++i) {
+            partials.emplace_back(0);
+        }
+        auto thread_func = [&sum_range, &partials, n_groups, n_threads](unsigned thread_idx) {
+            const auto r = thread_partition(n_groups, n_threads, thread_idx);
+            partials[thread_idx] = sum_range(r.first, r.second);
+        };
+        future_list<void> ff_list;
+        try {
+            for (unsigned i = 0u; i < n_threads; ++i) {
+                ff_list.push_back(thread_pool::enqueue(i, thread_func, i));
+            }
+            // First let's wait for everything to finish.
+            ff_list.wait_all();
+            // Then, let's handle the exceptions.
+            ff_list.get_all();
+        } catch (...) {
+            ff_list.wait_all();
+            throw;
+        }
+        Ret retval(std::move(partials[0u]));
+        for (unsigned i = 1u; i < n_threads; ++i) {
+            retval += std::move(partials[i]);
+        }
+        return retval;
+    }
+
+private:
+    const symbol_fset &m_s_set;
+    std::vector<std::pair<Value, Series>> m_groups;
+    // Map from the hashes of the values to the indices of the groups.
+    std::unordered_multimap<std::size_t, std::size_t> m_index;
+};
+
+template <typename Value, typename Series>
+const std::size_t subs_batcher<Value, Series>::min_groups_per_thread;
+}
+}
+
+#endif
@@ -0,0 +1,58 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_DETAIL_THREAD_PARTITION_HPP
+#define PIRANHA_DETAIL_THREAD_PARTITION_HPP
+
+#include <utility>
+
+#include <piranha/config.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// The range [start,end[ of the indices of an array of size size assigned to the thread thread_idx of the pool,
+// when the work on the array is split among the first n_threads threads. The last thread takes care of the
+// remainder. All the routines which initialise memory in parallel must use this partition: the algorithms
+// which later write into the memory can then use it too, so that each page is first touched (and thus
+// allocated, under the first-touch policy of NUMA systems) by the thread that will mostly write into it.
+template <typename T>
+inline std::pair<T, T> thread_partition(const T &size, unsigned n_threads, unsigned thread_idx)
+{
+    piranha_assert(n_threads && thread_idx < n_threads);
+    const T wpt = static_cast<T>(size / n_threads);
+    return std::make_pair(static_cast<T>(wpt * thread_idx),
+                          thread_idx == n_threads - 1u ? size : static_cast<T>(wpt * (thread_idx + 1u)));
+}
+}
+}
+
+#endif
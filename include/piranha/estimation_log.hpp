@@ -0,0 +1,150 @@
+/* Copyright 2009-2017 Francesco Biscani (bluescarni@gmail.com)
+
+This file is part of the Piranha library.
+
+The Piranha library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The Piranha library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the Piranha library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PIRANHA_ESTIMATION_LOG_HPP
+#define PIRANHA_ESTIMATION_LOG_HPP
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <piranha/config.hpp>
+#include <piranha/detail/init.hpp>
+
+namespace piranha
+{
+
+namespace detail
+{
+
+// A record in the estimation log.
+struct estimation_record {
+    // Sizes of the operands.
+    unsigned long long m_size1;
+    unsigned long long m_size2;
+    // Estimated and actual size of the result.
+    unsigned long long m_estimate;
+    unsigned long long m_actual;
+};
+
+template <typename = int>
+struct base_estimation_log {
+    static std::atomic<bool> s_enabled;
+    static std::mutex s_mutex;
+    static std::vector<estimation_record> s_records;
+};
+
+template <typename T>
+std::atomic<bool> base_estimation_log<T>::s_enabled(false);
+
+template <typename T>
+std::mutex base_estimation_log<T>::s_mutex;
+
+template <typename T>
+std::vector<estimation_record> base_estimation_log<T>::s_records;
+}
+
+/// Log of the estimations of the size of series multiplications.
+/**
+ * Before performing a series multiplication, the series multipliers may estimate the size of the result in order
+ * to pre-allocate the memory needed by the output container (see, e.g.,
+ * piranha::base_series_multiplier::estimate_final_series_size()). This class can be used to monitor the quality of
+ * these estimates: when the log is enabled, each series multiplication which estimated the size of the result
+ * appends to the log a record containing the sizes of the operands, the estimated size and the actual size of the
+ * result.
+ *
+ * The log is disabled by default. All the methods in this class are thread-safe.
+ */
+class estimation_log : private detail::base_estimation_log<>
+{
+public:
+    /// Record type.
+    /**
+     * The record is a struct with the following <tt>unsigned long long</tt> public data members:
+     * - \p m_size1 and \p m_size2, the sizes of the operands of the multiplication,
+     * - \p m_estimate, the estimated size of the result,
+     * - \p m_actual, the actual size of the result.
+     */
+    using record = detail::estimation_record;
+    /// Get the status of the log.
+    /**
+     * @return \p true if the log is enabled, \p false otherwise.
+     */
+    static bool get_enabled()
+    {
+        return s_enabled.load();
+    }
+    /// Enable or disable the log.
+    /**
+     * Disabling the log does not clear the records already logged.
+     *
+     * @param flag \p true to enable the log, \p false to disable it.
+     */
+    static void set_enabled(bool flag)
+    {
+        s_enabled.store(flag);
+    }
+    /// Add a record to the log.
+    /**
+     * The record will be appended to the log only if the log is enabled.
+     *
+     * @param r the record that will be added to the log.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers or by threading primitives.
+     */
+    static void push_back(const record &r)
+    {
+        if (get_enabled()) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_records.push_back(r);
+        }
+    }
+    /// Get the records.
+    /**
+     * @return a copy of the records in the log, in the order in which they were logged.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers or by threading primitives.
+     */
+    static std::vector<record> get_records()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        return s_records;
+    }
+    /// Clear the log.
+    /**
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_records.clear();
+    }
+};
+}
+
+#endif
@@ -48,8 +48,13 @@ see https://www.gnu.org/licenses/. */
 #include <vector>
 
 #include <piranha/config.hpp>
+#include <piranha/detail/atomic_flag_array.hpp>
+#include <piranha/detail/atomic_lock_guard.hpp>
 #include <piranha/detail/debug_access.hpp>
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/node_arena.hpp>
+#include <piranha/detail/prefetch.hpp>
+#include <piranha/detail/thread_partition.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/s11n.hpp>
 #include <piranha/safe_cast.hpp>
@@ -167,6 +172,8 @@ class hash_set
         storage_type m_storage;
         node *m_next;
     };
+    // Arena for the allocation of the nodes.
+    using node_arena_type = detail::node_arena<node>;
     // List constituting the bucket.
     // NOTE: in this list implementation the m_next pointer is used as a flag to signal if the current node
     // stores an item: the pointer is not null if it does contain something. The value of m_next pointer in a node is
@@ -291,17 +298,38 @@ class hash_set
             }
             piranha_assert(other.empty());
         }
+        // Allocation and deallocation of dynamically-allocated nodes. If arena is not null, the node is
+        // allocated from (or returned to) the shard shard_idx of arena, otherwise the global new and delete
+        // operators are used.
+        static node *alloc_node(node_arena_type *arena, const std::size_t &shard_idx)
+        {
+            return arena ? ::new (arena->allocate(shard_idx)) node() : ::new node();
+        }
+        static void free_node(node *n, node_arena_type *arena, const std::size_t &shard_idx)
+        {
+            if (arena) {
+                n->~node();
+                arena->deallocate(static_cast<void *>(n), shard_idx);
+            } else {
+                ::delete n;
+            }
+        }
         template <typename U, enable_if_t<std::is_same<T, uncvref_t<U>>::value, int> = 0>
-        node *insert(U &&item)
+        node *insert(U &&item, node_arena_type *arena = nullptr, const std::size_t &shard_idx = 0u)
         {
             // NOTE: optimize with likely/unlikely?
             if (m_node.m_next) {
                 // Create the new node and forward-link it to the second node.
-                std::unique_ptr<node> new_node(::new node());
-                ::new (static_cast<void *>(&new_node->m_storage)) T(std::forward<U>(item));
+                node *new_node = alloc_node(arena, shard_idx);
+                try {
+                    ::new (static_cast<void *>(&new_node->m_storage)) T(std::forward<U>(item));
+                } catch (...) {
+                    free_node(new_node, arena, shard_idx);
+                    throw;
+                }
                 new_node->m_next = m_node.m_next;
                 // Link first node to the new node.
-                m_node.m_next = new_node.release();
+                m_node.m_next = new_node;
                 return m_node.m_next;
             } else {
                 ::new (static_cast<void *>(&m_node.m_storage)) T(std::forward<U>(item));
@@ -348,6 +376,17 @@ class hash_set
             // After destruction, the list should be equivalent to a default-constructed one.
             piranha_assert(empty());
         }
+        // Destroy the content of the list without deallocating the nodes. This is to be used only when the
+        // nodes belong to an arena which is going to be released in bulk.
+        void release()
+        {
+            if (!std::is_trivially_destructible<T>::value) {
+                for (node *cur = &m_node; cur->m_next; cur = cur->m_next) {
+                    cur->ptr()->~T();
+                }
+            }
+            m_node.m_next = nullptr;
+        }
         static node terminator;
         node m_node;
     };
@@ -498,14 +537,13 @@ private:
                 }
                 constructed_ranges[thread_idx] = std::make_pair(start, end);
             };
-            // Work per thread.
-            const auto wpt = size / n_threads;
             future_list<decltype(thread_function(0u, 0u, 0u))> f_list;
             try {
                 for (unsigned i = 0u; i < n_threads; ++i) {
-                    const auto start = static_cast<size_type>(wpt * i),
-                               end = static_cast<size_type>((i == n_threads - 1u) ? size : wpt * (i + 1u));
-                    f_list.push_back(thread_pool::enqueue(i, thread_function, start, end, i));
+                    // NOTE: the buckets are first-touched by the threads according to the common partition,
+                    // which the parallel algorithms writing into the set can use to get NUMA-local buckets.
+                    const auto r = detail::thread_partition(size, n_threads, i);
+                    f_list.push_back(thread_pool::enqueue(i, thread_function, r.first, r.second, i));
                 }
                 f_list.wait_all();
                 // NOTE: no need to get_all() here, as we know no exceptions will be generated inside thread_func.
@@ -535,6 +573,13 @@ private:
         // Proceed to destroy all elements and deallocate only if the set is actually storing something.
         if (ptr()) {
             const size_type size = size_type(1u) << m_log2_size;
+            if (m_arena) {
+                // The dynamically-allocated nodes belong to the arena: destroy only their content here,
+                // the nodes are freed all at once below.
+                for (size_type i = 0u; i < size; ++i) {
+                    ptr()[i].release();
+                }
+            }
             for (size_type i = 0u; i < size; ++i) {
                 allocator().destroy(&ptr()[i]);
             }
@@ -542,6 +587,16 @@ private:
         } else {
             piranha_assert(!m_log2_size && !m_n_elements);
         }
+        if (m_arena) {
+            m_arena->release();
+        }
+    }
+    // Number of shards in the node arena (as a power of two). The shards are associated
+    // to contiguous ranges of buckets.
+    static const size_type m_log2_n_shards = 6u;
+    size_type arena_shard(const size_type &idx) const
+    {
+        return (m_log2_size > m_log2_n_shards) ? (idx >> (m_log2_size - m_log2_n_shards)) : idx;
     }
 #if defined(PIRANHA_WITH_BOOST_S11N)
     // Serialization support.
@@ -700,6 +755,24 @@ public:
     hash_set(const hash_set &other)
         : m_pack(nullptr, other.hash(), other.k_equal(), other.allocator()), m_log2_size(0u), m_n_elements(0u)
     {
+        if (other.m_arena) {
+            // If other has a node arena, create a new one for this and copy the elements one by one
+            // into empty buckets, so that the new nodes are allocated from the new arena.
+            m_arena.reset(::new node_arena_type(size_type(1u) << m_log2_n_shards));
+            init_from_n_buckets(other.bucket_count(), 1u);
+            try {
+                for (size_type i = 0u; i < bucket_count(); ++i) {
+                    for (const auto &x : other.ptr()[i]) {
+                        _unique_insert(x, i);
+                    }
+                }
+            } catch (...) {
+                destroy_and_deallocate();
+                throw;
+            }
+            m_n_elements = other.m_n_elements;
+            return;
+        }
         // Proceed to actual copy only if other has some content.
         if (other.ptr()) {
             const size_type size = size_type(1u) << other.m_log2_size;
@@ -737,7 +810,8 @@ public:
      * @param other set to be moved.
      */
     hash_set(hash_set &&other) noexcept
-        : m_pack(std::move(other.m_pack)), m_log2_size(other.m_log2_size), m_n_elements(other.m_n_elements)
+        : m_pack(std::move(other.m_pack)), m_log2_size(other.m_log2_size), m_n_elements(other.m_n_elements),
+          m_arena(std::move(other.m_arena))
     {
         // Clear out the other one.
         other.ptr() = nullptr;
@@ -828,6 +902,7 @@ public:
             m_pack = std::move(other.m_pack);
             m_log2_size = other.m_log2_size;
             m_n_elements = other.m_n_elements;
+            m_arena = std::move(other.m_arena);
             // Zero out other.
             other.ptr() = nullptr;
             other.m_log2_size = 0u;
@@ -1107,6 +1182,7 @@ public:
         std::swap(m_pack, other.m_pack);
         std::swap(m_log2_size, other.m_log2_size);
         std::swap(m_n_elements, other.m_n_elements);
+        std::swap(m_arena, other.m_arena);
     }
     /// Rehash set.
     /**
@@ -1140,6 +1216,9 @@ public:
         }
         // Create a new set with needed amount of buckets.
         hash_set new_set(new_size, hash(), k_equal(), n_threads);
+        if (m_arena) {
+            new_set.m_arena.reset(::new node_arena_type(size_type(1u) << m_log2_n_shards));
+        }
         try {
             const auto it_f = _m_end();
             for (auto it = _m_begin(); it != it_f; ++it) {
@@ -1255,9 +1334,204 @@ public:
         piranha_assert(find(std::forward<U>(k)) == end());
         // Assert bucket index is correct.
         piranha_assert(bucket_idx == _bucket(k));
-        auto p = ptr()[bucket_idx].insert(std::forward<U>(k));
+        auto p = ptr()[bucket_idx].insert(std::forward<U>(k), m_arena.get(), arena_shard(bucket_idx));
         return iterator(this, bucket_idx, local_iterator(p));
     }
+    /// Concurrent insertion (low-level).
+    /**
+     * \note
+     * This template method is activated only if \p T and \p U are the same type, aside from cv qualifications and
+     * references.
+     *
+     * This method can be called concurrently from multiple threads in order to insert elements into the set, or to
+     * update the elements already present. The bucket of index \p bucket_idx, which must be the destination bucket for
+     * \p k, is protected by the spinlock of index <tt>bucket_idx & (locks.m_size - 1)</tt> in \p locks, whose size
+     * must be a power of two. While holding the lock, the method will look for an element equivalent to \p k in the
+     * bucket: if such element exists, \p f will be called with a const reference to the existing element and with \p k
+     * as arguments, otherwise \p k will be inserted in the bucket.
+     *
+     * As in _unique_insert(), this method will not update the number of elements present in the set, nor it will
+     * resize the set in case the maximum load factor is exceeded. While concurrent insertions are ongoing, no other
+     * method modifying the set can be called.
+     *
+     * @param k object that will be inserted into the set.
+     * @param bucket_idx destination bucket for \p k.
+     * @param locks the array of spinlocks protecting the buckets.
+     * @param f the functor that will be used to update an element equivalent to \p k already present in the set.
+     *
+     * @return \p true if \p k was inserted into the set, \p false if an equivalent element was updated via \p f.
+     *
+     * @throws unspecified any exception thrown by _find(), _unique_insert() or by the call operator of \p f.
+     */
+    template <typename U, typename F, insert_enabler<U> = 0>
+    bool _concurrent_insert(U &&k, const size_type &bucket_idx, detail::atomic_flag_array &locks, const F &f)
+    {
+        // Assert the size of the lock array is a power of two.
+        piranha_assert(locks.m_size && !(locks.m_size & (locks.m_size - 1u)));
+        detail::atomic_lock_guard alg(locks[static_cast<std::size_t>(bucket_idx & (locks.m_size - 1u))]);
+        const auto it = _find(k, bucket_idx);
+        if (it == end()) {
+            _unique_insert(std::forward<U>(k), bucket_idx);
+            return true;
+        }
+        f(*it, k);
+        return false;
+    }
+    /// Prefetch bucket (low-level).
+    /**
+     * Hint the processor to load into the cache the bucket of index \p bucket_idx, in anticipation of
+     * an access in the near future (e.g., via _find() or _unique_insert()). This method has no observable
+     * effects on the set.
+     *
+     * @param bucket_idx the index of the bucket to be prefetched.
+     */
+    void _prefetch_bucket(const size_type &bucket_idx) const
+    {
+        piranha_assert(bucket_idx < bucket_count());
+        detail::prefetch(ptr() + bucket_idx);
+    }
+    /// Pipelined insertion (low-level).
+    /**
+     * This class implements a software-pipelined version of the find-or-insert pattern of the low-level interface
+     * of piranha::hash_set. The elements pushed into the pipeline are kept in a ring buffer of
+     * pending insertions, and the destination bucket of each element is prefetched as soon as the element is pushed.
+     * When the ring buffer is full, the oldest pending element is completed: if an equivalent element exists in the
+     * set, \p F will be called with a const reference to the existing element and with a const reference to the
+     * pending element as arguments, otherwise the pending element will be inserted in the set via _unique_insert().
+     * The elements are completed in the order in which they were pushed, so that the final state of the set
+     * is the same as if the elements had been processed one at a time.
+     *
+     * The number of elements in the ring buffer is the prefetch distance specified on construction. With a distance
+     * of zero, each pushed element is completed immediately.
+     *
+     * As in _unique_insert(), the pipeline will not update the number of elements present in the set, nor will
+     * it resize the set in case the maximum load factor is exceeded. flush() must be called after the last push()
+     * in order to complete the pending insertions, which are otherwise discarded by the destructor. If an exception
+     * is thrown by push() or flush(), the pending insertions are discarded, the content of the set will be
+     * unspecified, and the pipeline must not be used any further.
+     */
+    template <typename F>
+    class _pipeline
+    {
+    public:
+        /// Constructor.
+        /**
+         * @param h the set into which the elements will be inserted.
+         * @param f the functor that will be used to update the elements already present in the set.
+         * @param distance the prefetch distance.
+         *
+         * @throws unspecified any exception thrown by memory allocation errors, or by the copy constructor
+         * of \p F.
+         */
+        explicit _pipeline(hash_set &h, const F &f, const size_type &distance)
+            : m_set(h), m_f(f), m_keys(distance), m_buckets(distance), m_head(0u), m_n_pending(0u)
+        {
+        }
+        /// Destructor.
+        /**
+         * The destructor will discard the pending insertions, if any: flush() must be called in order to complete
+         * them.
+         */
+        ~_pipeline() noexcept {}
+        /// Deleted copy constructor.
+        _pipeline(const _pipeline &) = delete;
+        /// Deleted move constructor.
+        _pipeline(_pipeline &&) = delete;
+        /// Deleted copy assignment operator.
+        _pipeline &operator=(const _pipeline &) = delete;
+        /// Deleted move assignment operator.
+        _pipeline &operator=(_pipeline &&) = delete;
+        /// Push an element into the pipeline.
+        /**
+         * \note
+         * This template method is activated only if \p T and \p U are the same type, aside from cv qualifications
+         * and references.
+         *
+         * @param k the element to be pushed into the pipeline.
+         *
+         * @throws unspecified any exception thrown by:
+         * - the hasher, the equality predicate or the call operator of \p F,
+         * - the copy/move assignment operator of \p T,
+         * - _unique_insert().
+         */
+        template <typename U, insert_enabler<U> = 0>
+        void push(U &&k)
+        {
+            try {
+                const auto bucket_idx = m_set._bucket(k);
+                const auto distance = m_keys.size();
+                if (!distance) {
+                    complete(std::forward<U>(k), bucket_idx);
+                    return;
+                }
+                m_set._prefetch_bucket(bucket_idx);
+                if (m_n_pending == distance) {
+                    // The ring buffer is full: complete the oldest pending element,
+                    // and replace it with the new one.
+                    complete(std::move(m_keys[m_head]), m_buckets[m_head]);
+                    m_keys[m_head] = std::forward<U>(k);
+                    m_buckets[m_head] = bucket_idx;
+                    m_head = next_idx(m_head);
+                } else {
+                    // NOTE: m_head and m_n_pending are both less than distance, no overflow is possible.
+                    auto pos = static_cast<size_type>(m_head + m_n_pending);
+                    if (pos >= distance) {
+                        pos = static_cast<size_type>(pos - distance);
+                    }
+                    m_keys[pos] = std::forward<U>(k);
+                    m_buckets[pos] = bucket_idx;
+                    ++m_n_pending;
+                }
+            } catch (...) {
+                m_n_pending = 0u;
+                throw;
+            }
+        }
+        /// Complete all the pending insertions.
+        /**
+         * @throws unspecified any exception thrown by the hasher, the equality predicate, the call operator of \p F
+         * or _unique_insert().
+         */
+        void flush()
+        {
+            try {
+                while (m_n_pending) {
+                    const auto idx = m_head;
+                    m_head = next_idx(m_head);
+                    --m_n_pending;
+                    complete(std::move(m_keys[idx]), m_buckets[idx]);
+                }
+            } catch (...) {
+                m_n_pending = 0u;
+                throw;
+            }
+        }
+
+    private:
+        size_type next_idx(const size_type &idx) const
+        {
+            const auto retval = static_cast<size_type>(idx + 1u);
+            return retval == m_keys.size() ? size_type(0u) : retval;
+        }
+        template <typename U>
+        void complete(U &&k, const size_type &bucket_idx)
+        {
+            const auto it = m_set._find(k, bucket_idx);
+            if (it == m_set.end()) {
+                m_set._unique_insert(std::forward<U>(k), bucket_idx);
+            } else {
+                m_f(*it, k);
+            }
+        }
+
+    private:
+        hash_set &m_set;
+        const F m_f;
+        std::vector<key_type> m_keys;
+        std::vector<size_type> m_buckets;
+        size_type m_head;
+        size_type m_n_pending;
+    };
     /// Find element (low-level).
     /**
      * Locate element in the set. The parameter \p bucket_idx is the index of the destination bucket for \p k and, for
@@ -1357,6 +1631,46 @@ public:
         piranha_assert(idx < bucket_count());
         return ptr()[idx];
     }
+    /// Enable or disable the node arena.
+    /**
+     * The first element of each bucket is stored directly in the array of buckets, while the other elements are
+     * stored in dynamically-allocated nodes. By default, each node is allocated and deallocated individually. If the
+     * node arena is enabled, the nodes are instead carved out of large slabs of memory owned by the set, and the
+     * memory of the nodes removed from the set is recycled for later insertions. All the slabs are freed at once
+     * when the set is cleared or destroyed, or when its content is moved to a new set during a rehash operation.
+     *
+     * The arena is split in shards, each one associated to a contiguous range of buckets and protected by its own
+     * spinlock. Hence, _unique_insert() and _erase() can still be called concurrently on different buckets, and
+     * the nodes of neighbouring buckets tend to be close in memory.
+     *
+     * The node arena is preserved by copy, move, swap and rehash operations.
+     *
+     * @param flag \p true to enable the node arena, \p false to disable it.
+     *
+     * @throws std::invalid_argument if the set is not empty.
+     * @throws unspecified any exception thrown by memory allocation errors.
+     */
+    void _set_node_arena(bool flag)
+    {
+        if (unlikely(!empty())) {
+            piranha_throw(std::invalid_argument, "the node arena can be set only on an empty set");
+        }
+        if (flag && !m_arena) {
+            m_arena.reset(::new node_arena_type(size_type(1u) << m_log2_n_shards));
+        } else if (!flag) {
+            m_arena.reset();
+        }
+    }
+    /// Test for the presence of the node arena.
+    /**
+     * @return \p true if the node arena is enabled, \p false otherwise.
+     *
+     * @see _set_node_arena().
+     */
+    bool _has_node_arena() const
+    {
+        return static_cast<bool>(m_arena);
+    }
     /// Erase element.
     /**
      * Erase the element to which \p it points. \p it must be a valid iterator
@@ -1396,7 +1710,7 @@ public:
                 // Move-construct from the second element, and then destroy it.
                 ::new (static_cast<void *>(&bucket.m_node.m_storage)) T(std::move(*bucket.m_node.m_next->ptr()));
                 bucket.m_node.m_next->ptr()->~T();
-                ::delete bucket.m_node.m_next;
+                list::free_node(bucket.m_node.m_next, m_arena.get(), arena_shard(it.m_idx));
                 // Establish the new link.
                 bucket.m_node.m_next = tmp;
                 return bucket.begin();
@@ -1412,7 +1726,7 @@ public:
                     prev_b_it.m_ptr->m_next = b_it.m_ptr->m_next;
                     // Delete the current one.
                     b_it.m_ptr->ptr()->~T();
-                    ::delete b_it.m_ptr;
+                    list::free_node(b_it.m_ptr, m_arena.get(), arena_shard(it.m_idx));
                     break;
                 };
             }
@@ -1430,6 +1744,7 @@ private:
     pack_type m_pack;
     size_type m_log2_size;
     size_type m_n_elements;
+    std::unique_ptr<node_arena_type> m_arena;
 };
 
 template <typename T, typename Hash, typename Pred>
@@ -1438,6 +1753,9 @@ typename hash_set<T, Hash, Pred>::node hash_set<T, Hash, Pred>::list::terminator
 template <typename T, typename Hash, typename Pred>
 const typename hash_set<T, Hash, Pred>::size_type hash_set<T, Hash, Pred>::m_n_nonzero_sizes;
 
+template <typename T, typename Hash, typename Pred>
+const typename hash_set<T, Hash, Pred>::size_type hash_set<T, Hash, Pred>::m_log2_n_shards;
+
 #if defined(PIRANHA_WITH_BOOST_S11N)
 
 inline namespace impl
@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/subs_batcher.hpp>
 #include <piranha/forwarding.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/series.hpp>
@@ -83,6 +84,9 @@ class ipow_substitutable_series : public Series, ipow_substitutable_series_tag
             = static_cast<unsigned>(has_ipow_subs<typename Term::cf_type, T>::value)
               + (static_cast<unsigned>(key_has_ipow_subs<typename Term::key_type, T>::value) << 1u);
     };
+    // NOTE: in cases 1 and 2, the terms are grouped according to the values resulting from the substitution
+    // (see detail::subs_batcher), so that a single multiplication per group is needed, instead of one multiplication
+    // per term.
     // Case 1: subs only on cf.
     template <typename T, typename Term>
     using cf_subs_type
@@ -90,17 +94,21 @@ class ipow_substitutable_series : public Series, ipow_substitutable_series_tag
                                    std::declval<const integer &>(), std::declval<T const &>()));
     template <typename T, typename Term>
     using ret_type_1 = decltype(std::declval<const cf_subs_type<T, Term> &>() * std::declval<Derived const &>());
-    template <typename T, typename Term, typename std::enable_if<subs_term_score<Term, T>::value == 1u, int>::type = 0>
-    static ret_type_1<T, Term> subs_term_impl(const Term &t, const symbol_idx &idx, const std::string &name,
-                                              const integer &n, const T &x, const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              typename std::enable_if<subs_term_score<Term, T>::value == 1u, int>::type = 0>
+    static ret_type_1<T, Term> subs_impl(const typename Series::container_type &c, const symbol_idx &idx,
+                                         const std::string &name, const integer &n, const T &x,
+                                         const symbol_fset &s_set)
     {
         piranha_assert(ss_index_of(s_set, name) == idx);
         (void)idx;
-        Derived tmp;
-        tmp.set_symbol_set(s_set);
-        tmp.insert(Term(typename Term::cf_type(1), t.m_key));
+        detail::subs_batcher<cf_subs_type<T, Term>, Derived> batcher(s_set);
+        for (const auto &t : c) {
+            batcher.add(math::ipow_subs(t.m_cf, name, n, x), Term(typename Term::cf_type(1), t.m_key));
+        }
         // NOTE: use moves here in case the multiplication can take advantage.
-        return math::ipow_subs(t.m_cf, name, n, x) * std::move(tmp);
+        return batcher.template accumulate<ret_type_1<T, Term>>(
+            [](cf_subs_type<T, Term> &&v, Derived &&tmp) { return std::move(v) * std::move(tmp); });
     }
     // Case 2: subs only on key.
     template <typename T, typename Term>
@@ -113,52 +121,59 @@ class ipow_substitutable_series : public Series, ipow_substitutable_series_tag
     using ret_type_2 = typename std::enable_if<is_addable_in_place<ret_type_2_<T, Term>>::value
                                                    && std::is_constructible<ret_type_2_<T, Term>, const int &>::value,
                                                ret_type_2_<T, Term>>::type;
-    template <typename T, typename Term, typename std::enable_if<subs_term_score<Term, T>::value == 2u, int>::type = 0>
-    static ret_type_2<T, Term> subs_term_impl(const Term &t, const symbol_idx &idx, const std::string &name,
-                                              const integer &n, const T &x, const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              typename std::enable_if<subs_term_score<Term, T>::value == 2u, int>::type = 0>
+    static ret_type_2<T, Term> subs_impl(const typename Series::container_type &c, const symbol_idx &idx,
+                                         const std::string &name, const integer &n, const T &x,
+                                         const symbol_fset &s_set)
     {
         piranha_assert(ss_index_of(s_set, name) == idx);
         (void)name;
-        ret_type_2<T, Term> retval(0);
-        auto ksubs = t.m_key.ipow_subs(idx, n, x, s_set);
-        for (auto &p : ksubs) {
-            Derived tmp;
-            tmp.set_symbol_set(s_set);
-            tmp.insert(Term{t.m_cf, std::move(p.second)});
-            // NOTE: possible use of multadd here in the future.
-            retval += std::move(tmp) * std::move(p.first);
+        detail::subs_batcher<k_subs_type<T, Term>, Derived> batcher(s_set);
+        for (const auto &t : c) {
+            auto ksubs = t.m_key.ipow_subs(idx, n, x, s_set);
+            for (auto &p : ksubs) {
+                batcher.add(std::move(p.first), Term{t.m_cf, std::move(p.second)});
+            }
         }
-        return retval;
+        return batcher.template accumulate<ret_type_2<T, Term>>(
+            [](k_subs_type<T, Term> &&v, Derived &&tmp) { return std::move(tmp) * std::move(v); });
     }
     // Case 3: subs on cf and key.
     // NOTE: the checks on type 2 are already present in the alias above.
     template <typename T, typename Term>
     using ret_type_3
         = decltype(std::declval<const cf_subs_type<T, Term> &>() * std::declval<const ret_type_2<T, Term> &>());
-    template <typename T, typename Term, typename std::enable_if<subs_term_score<Term, T>::value == 3u, int>::type = 0>
-    static ret_type_3<T, Term> subs_term_impl(const Term &t, const symbol_idx &idx, const std::string &name,
-                                              const integer &n, const T &x, const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              typename std::enable_if<subs_term_score<Term, T>::value == 3u, int>::type = 0>
+    static ret_type_3<T, Term> subs_impl(const typename Series::container_type &c, const symbol_idx &idx,
+                                         const std::string &name, const integer &n, const T &x,
+                                         const symbol_fset &s_set)
     {
         piranha_assert(ss_index_of(s_set, name) == idx);
-        // Accumulator for the sum below. This is the same type resulting from case 2.
-        ret_type_2<T, Term> acc(0);
-        auto ksubs = t.m_key.ipow_subs(idx, n, x, s_set);
-        auto cf_subs = math::ipow_subs(t.m_cf, name, n, x);
-        for (auto &p : ksubs) {
-            Derived tmp;
-            tmp.set_symbol_set(s_set);
-            tmp.insert(Term(typename Term::cf_type(1), std::move(p.second)));
-            // NOTE: multadd chance.
-            acc += std::move(tmp) * std::move(p.first);
+        ret_type_3<T, Term> retval(0);
+        for (const auto &t : c) {
+            // Accumulator for the sum below. This is the same type resulting from case 2.
+            ret_type_2<T, Term> acc(0);
+            auto ksubs = t.m_key.ipow_subs(idx, n, x, s_set);
+            auto cf_subs = math::ipow_subs(t.m_cf, name, n, x);
+            for (auto &p : ksubs) {
+                Derived tmp;
+                tmp.set_symbol_set(s_set);
+                tmp.insert(Term(typename Term::cf_type(1), std::move(p.second)));
+                // NOTE: multadd chance.
+                acc += std::move(tmp) * std::move(p.first);
+            }
+            retval += std::move(cf_subs) * std::move(acc);
         }
-        return std::move(cf_subs) * std::move(acc);
+        return retval;
     }
     // Initial definition of the subs type.
     template <typename T>
-    using subs_type_ = decltype(subs_term_impl(std::declval<typename Series::term_type const &>(),
-                                               std::declval<const symbol_idx &>(), std::declval<const std::string &>(),
-                                               std::declval<const integer &>(), std::declval<const T &>(),
-                                               std::declval<symbol_fset const &>()));
+    using subs_type_ = decltype(subs_impl(std::declval<typename Series::container_type const &>(),
+                                          std::declval<const symbol_idx &>(), std::declval<const std::string &>(),
+                                          std::declval<const integer &>(), std::declval<const T &>(),
+                                          std::declval<symbol_fset const &>()));
     // Enable conditionally based on the common requirements in the ipow_subs() method.
     template <typename T>
     using ipow_subs_type = enable_if_t<
@@ -210,6 +225,9 @@ public:
      * This method will return an object resulting from the substitution of the integral power of the symbol called \p
      * name in \p this with the generic object \p x.
      *
+     * As in piranha::substitutable_series::subs(), if only the coefficients or only the keys support substitution,
+     * the result is computed with one multiplication per group of terms yielding the same substituted value.
+     *
      * @param name name of the symbol to be substituted.
      * @param n integral power of the symbol to be substituted.
      * @param x object used for the substitution.
@@ -225,11 +243,7 @@ public:
     ipow_subs_type<T> ipow_subs(const std::string &name, const integer &n, const T &x) const
     {
         const auto idx = ss_index_of(this->m_symbol_set, name);
-        ipow_subs_type<T> retval(0);
-        for (const auto &t : this->m_container) {
-            retval += subs_term_impl(t, idx, name, n, x, this->m_symbol_set);
-        }
-        return retval;
+        return subs_impl(this->m_container, idx, name, n, x, this->m_symbol_set);
     }
     /// Substitution.
     /**
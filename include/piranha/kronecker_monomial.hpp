@@ -1165,6 +1165,21 @@ public:
         return !k.get_int();
     }
 };
+
+inline namespace impl
+{
+
+// Exponents of a Kronecker monomial, for use in the evaluation plans of series.
+template <typename T>
+struct key_power_exponents<kronecker_monomial<T>> {
+    using value_type = T;
+    static void get(const kronecker_monomial<T> &k, const symbol_fset &s, std::vector<T> &out)
+    {
+        const auto v = k.unpack(s);
+        out.assign(v.begin(), v.end());
+    }
+};
+}
 }
 
 #if defined(PIRANHA_WITH_BOOST_S11N)
@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PIRANHA_LAMBDIFY_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -41,10 +42,12 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 #include <vector>
 
+#include <piranha/detail/evaluation_plan.hpp>
 #include <piranha/detail/init.hpp>
 #include <piranha/detail/sfinae_types.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/math.hpp>
+#include <piranha/series.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/type_traits.hpp>
 
@@ -58,11 +61,36 @@ namespace detail
 template <typename T, typename U>
 using math_lambdified_reqs = std::integral_constant<
     bool, conjunction<is_evaluable<T, U>, std::is_copy_constructible<T>, std::is_move_constructible<T>>::value>;
+
+// Detect if the batch evaluation of lambdified objects can go through a series_evaluation_plan: T must be
+// a series supporting evaluation plans, and its coefficients must not be series (so that their evaluation
+// does not depend on the point).
+template <typename T, typename U, typename = void>
+struct lambdified_has_batch_plan : std::false_type {
+};
+
+template <typename T, typename U>
+struct lambdified_has_batch_plan<
+    T, U, enable_if_t<conjunction<is_series<T>, negation<is_series<typename T::term_type::cf_type>>,
+                                  series_has_evaluation_plan<T, U>>::value>> : std::true_type {
+};
+
+// Placeholder for the evaluation plan of lambdified objects which cannot use one.
+struct lambdified_no_plan {
+};
 }
 
 namespace math
 {
 
+/// Memory layout of the points in the batch evaluation of piranha::math::lambdified.
+enum class points_layout {
+    /// The values of the coordinates of each point are contiguous.
+    row_major,
+    /// The values of each coordinate over all the points are contiguous.
+    col_major
+};
+
 /// Functor interface for piranha::math::evaluate().
 /**
  * This class exposes a function-like interface for the evaluation of instances of type \p T with objects of type \p U.
@@ -141,6 +169,113 @@ class lambdified
         // Make sure the sizes are consistent.
         piranha_assert(m_ptrs.size() == static_cast<decltype(m_ptrs.size())>(m_names.size()) + m_extra_map.size());
     }
+    // Value of the coordinate i of the point p in the batch evaluation.
+    const U &point_value(const U *points, std::size_t n_points, std::size_t p, std::size_t i,
+                         points_layout layout) const
+    {
+        return layout == points_layout::row_major ? points[p * m_names.size() + i] : points[i * n_points + p];
+    }
+    // The evaluation plan of m_x, built on first use. Since m_x is never modified, the plan can be reused across
+    // evaluations.
+    using plan_type = typename std::conditional<detail::lambdified_has_batch_plan<T, U>::value,
+                                                detail::series_evaluation_plan<T>, detail::lambdified_no_plan>::type;
+    const plan_type &get_plan()
+    {
+        if (!m_plan) {
+            m_plan.reset(new plan_type(m_x));
+        }
+        return *m_plan;
+    }
+    // Evaluation via the stored plan, after the values have been written into m_eval_dict.
+    template <typename T1 = T, enable_if_t<detail::lambdified_has_batch_plan<T1, U>::value, int> = 0>
+    typename lambdified<T1, U>::eval_type call_impl()
+    {
+        const auto &plan = get_plan();
+        std::vector<U> values;
+        for (const auto &sym : m_x.get_symbol_set()) {
+            const auto it = m_eval_dict.find(sym);
+            if (unlikely(it == m_eval_dict.end())) {
+                piranha_throw(std::invalid_argument, "cannot evaluate series: the symbol '" + sym
+                                                         + "' is missing from the series evaluation dictionary");
+            }
+            values.push_back(it->second);
+        }
+        return plan.evaluate(values, symbol_fmap<U>{m_eval_dict.begin(), m_eval_dict.end()});
+    }
+    // Evaluation via math::evaluate().
+    template <typename T1 = T, enable_if_t<!detail::lambdified_has_batch_plan<T1, U>::value, int> = 0>
+    typename lambdified<T1, U>::eval_type call_impl()
+    {
+        // NOTE: of course, this will have to be fixed in the rewrite.
+        return math::evaluate(m_x, symbol_fmap<U>{m_eval_dict.begin(), m_eval_dict.end()});
+    }
+    // Batch evaluation via an evaluation plan.
+    template <typename T1 = T, enable_if_t<detail::lambdified_has_batch_plan<T1, U>::value, int> = 0>
+    std::vector<typename lambdified<T1, U>::eval_type> batch_impl(const U *points, std::size_t n_points,
+                                                                  points_layout layout)
+    {
+        using func_type = typename extra_map_type::mapped_type;
+        const auto &ss = m_x.get_symbol_set();
+        // For each symbol of the series, the position of the corresponding coordinate in the points or, for the
+        // symbols in the extra map, the mapped function.
+        std::vector<std::size_t> pos;
+        std::vector<const func_type *> funcs;
+        bool has_extras = false;
+        for (const auto &sym : ss) {
+            const auto it = std::find(m_names.begin(), m_names.end(), sym);
+            if (it != m_names.end()) {
+                pos.push_back(static_cast<std::size_t>(it - m_names.begin()));
+                funcs.push_back(nullptr);
+                continue;
+            }
+            const auto it_e = m_extra_map.find(sym);
+            if (unlikely(it_e == m_extra_map.end())) {
+                piranha_throw(std::invalid_argument, "cannot evaluate series: the symbol '" + sym
+                                                         + "' is missing from the series evaluation dictionary");
+            }
+            pos.push_back(0u);
+            funcs.push_back(std::addressof(it_e->second));
+            has_extras = true;
+        }
+        const auto n_names = m_names.size();
+        auto fill = [this, points, n_points, layout, n_names, has_extras, &pos, &funcs](
+            std::size_t begin, std::size_t end, std::vector<U> &vals) {
+            const auto m = end - begin;
+            std::vector<U> point;
+            for (auto p = begin; p < end; ++p) {
+                if (has_extras) {
+                    point.resize(0);
+                    for (std::size_t i = 0u; i < n_names; ++i) {
+                        point.push_back(this->point_value(points, n_points, p, i, layout));
+                    }
+                }
+                for (decltype(pos.size()) j = 0u; j < pos.size(); ++j) {
+                    vals[j * m + (p - begin)]
+                        = funcs[j] ? (*funcs[j])(point) : this->point_value(points, n_points, p, pos[j], layout);
+                }
+            }
+        };
+        // NOTE: the functions in the extra map are not guaranteed to be thread-safe (e.g., they might
+        // call into the Python interpreter), thus the evaluation is single-threaded if they are needed.
+        return get_plan().evaluate_batch(n_points, fill, symbol_fmap<U>{}, !has_extras);
+    }
+    // Batch evaluation via the call operator.
+    template <typename T1 = T, enable_if_t<!detail::lambdified_has_batch_plan<T1, U>::value, int> = 0>
+    std::vector<typename lambdified<T1, U>::eval_type> batch_impl(const U *points, std::size_t n_points,
+                                                                  points_layout layout)
+    {
+        std::vector<eval_type> retval;
+        retval.reserve(n_points);
+        std::vector<U> point;
+        for (std::size_t p = 0u; p < n_points; ++p) {
+            point.resize(0);
+            for (std::size_t i = 0u; i < m_names.size(); ++i) {
+                point.push_back(point_value(points, n_points, p, i, layout));
+            }
+            retval.push_back((*this)(point));
+        }
+        return retval;
+    }
 
 public:
     /// Evaluation type.
@@ -253,6 +388,10 @@ public:
      * If a non-empty \p extra_map parameter was used during construction, the symbols in it are evaluated according
      * to the mapped functions before being passed down in the evaluation dictionary to piranha::math::evaluate().
      *
+     * If \p T is a piranha::series whose coefficients are not series and whose keys are monomials with C++ integral
+     * exponents, the exponents of the terms are unpacked on the first evaluation (see evaluate_batch()) and reused
+     * in the subsequent ones. The result is the same as the one of piranha::math::evaluate().
+     *
      * Note that this function needs to modify the internal state of the object, and thus it is not const and it is
      * not thread-safe.
      *
@@ -294,8 +433,82 @@ public:
             *ptr = p.second(values);
             ++i;
         }
-        // NOTE: of course, this will have to be fixed in the rewrite.
-        return math::evaluate(m_x, symbol_fmap<U>{m_eval_dict.begin(), m_eval_dict.end()});
+        return call_impl();
+    }
+    /// Batch evaluation.
+    /**
+     * This method will evaluate the internal object of type \p T at \p n_points points, stored in the array
+     * \p points. Each point consists of as many values as the names used during construction and, depending on
+     * \p layout, the values of the coordinates of each point are contiguous (points_layout::row_major) or the
+     * values of each coordinate over all the points are contiguous (points_layout::col_major).
+     *
+     * If \p T is a piranha::series whose coefficients are not series and whose keys are monomials with C++ integral
+     * exponents, the exponents of the terms are unpacked only once and the series is evaluated on chunks of points,
+     * one term at a time, so that the innermost loops run over contiguous arrays of points. The chunks
+     * are evaluated in parallel, according to the value returned by
+     * piranha::settings::get_min_work_per_thread(), unless the symbols of the series include symbols from
+     * the \p extra_map parameter used during construction, whose mapped functions are called from the calling
+     * thread. Otherwise, the points are evaluated one at a time via operator()().
+     *
+     * Each point is evaluated by a single thread, with the same sequence of operations as the single-threaded
+     * evaluation of the point via operator()(). The result for each point is thus the same as the one of the
+     * single-threaded operator()(), independently of the number of threads used by this method.
+     *
+     * @param points the values of the coordinates of the points.
+     * @param n_points the number of points.
+     * @param layout the memory layout of \p points.
+     *
+     * @return a vector containing the results of the evaluation of the points.
+     *
+     * @throws std::invalid_argument if \p points is null while \p n_points and the number of names used during
+     * construction are both nonzero, or if a symbol of the series is missing from the names and from the
+     * extra map.
+     * @throws unspecified any exception raised by:
+     * - operator()(),
+     * - memory errors in standard containers,
+     * - the copy-assignment operator of \p U,
+     * - piranha::math::evaluate(), piranha::pow() and arithmetic operations on the evaluation type,
+     * - the call operator of the mapped functions in the \p extra_map parameter used during construction,
+     * - failure(s) in threading primitives.
+     */
+    std::vector<eval_type> evaluate_batch(const U *points, std::size_t n_points,
+                                          points_layout layout = points_layout::row_major)
+    {
+        if (unlikely(!points && n_points && m_names.size())) {
+            piranha_throw(std::invalid_argument, "a null pointer was passed for the points in a batch evaluation");
+        }
+        if (!n_points) {
+            return std::vector<eval_type>{};
+        }
+        return batch_impl(points, n_points, layout);
+    }
+    /// Batch evaluation (vector overload).
+    /**
+     * This method is equivalent to the other overload of evaluate_batch(), with the points stored in \p points.
+     *
+     * @param points the values of the coordinates of the points.
+     * @param n_points the number of points.
+     * @param layout the memory layout of \p points.
+     *
+     * @return a vector containing the results of the evaluation of the points.
+     *
+     * @throws std::invalid_argument if the size of \p points is not the product of \p n_points by the number
+     * of names used during construction.
+     * @throws unspecified any exception raised by the other overload of evaluate_batch().
+     */
+    std::vector<eval_type> evaluate_batch(const std::vector<U> &points, std::size_t n_points,
+                                          points_layout layout = points_layout::row_major)
+    {
+        const auto n_names = m_names.size();
+        if (unlikely(n_names ? (points.size() % n_names != 0u || points.size() / n_names != n_points)
+                             : !points.empty())) {
+            piranha_throw(std::invalid_argument, "the size of the vector of points in a batch evaluation ("
+                                                     + std::to_string(points.size())
+                                                     + ") is not consistent with the number of points ("
+                                                     + std::to_string(n_points) + ") and the number of names ("
+                                                     + std::to_string(n_names) + ")");
+        }
+        return evaluate_batch(points.data(), n_points, layout);
     }
     /// Get evaluation object.
     /**
@@ -334,6 +547,7 @@ private:
     std::unordered_map<std::string, U> m_eval_dict;
     std::vector<U *> m_ptrs;
     extra_map_type m_extra_map;
+    std::unique_ptr<plan_type> m_plan;
 };
 }
 
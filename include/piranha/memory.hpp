@@ -44,6 +44,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <piranha/config.hpp>
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/thread_partition.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/thread_pool.hpp>
 #include <piranha/type_traits.hpp>
@@ -261,6 +262,10 @@ inline bool alignment_check(const std::size_t &alignment)
  * the operation concurrently. If \p n_threads is 1 or 0, the operation will be performed in the
  * calling thread. If \p ptr is null, this function will be a no-op.
  *
+ * In multithreaded mode, the <tt>i</tt>-th thread initialises the <tt>i</tt>-th of \p n_threads contiguous
+ * ranges of equal size (the last range also includes the remainder). Under the first-touch policy of NUMA systems,
+ * the memory of each range will be allocated on the NUMA node of the thread that initialised it.
+ *
  * This function provides the strong exception safety guarantee: in case of errors, any constructed
  * instance of \p T will be destroyed before the error is re-thrown.
  *
@@ -312,13 +317,12 @@ inline void parallel_value_init(T *ptr, const std::size_t &size, const unsigned
         if (unlikely(inited_ranges.size() != n_threads)) {
             piranha_throw(std::bad_alloc, );
         }
-        // Work per thread.
-        const auto wpt = static_cast<std::size_t>(size / n_threads);
         future_list<decltype(init_function(ptr, ptr, 0u, &inited_ranges))> f_list;
         try {
             for (auto i = 0u; i < n_threads; ++i) {
-                auto start = ptr + i * wpt, end = (i == n_threads - 1u) ? ptr + size : ptr + (i + 1u) * wpt;
-                f_list.push_back(thread_pool::enqueue(i, init_function, start, end, i, &inited_ranges));
+                const auto r = detail::thread_partition(size, n_threads, i);
+                f_list.push_back(
+                    thread_pool::enqueue(i, init_function, ptr + r.first, ptr + r.second, i, &inited_ranges));
             }
             f_list.wait_all();
             f_list.get_all();
@@ -1222,6 +1222,28 @@ public:
                            [](const T &element) { return piranha::is_zero(element); });
     }
 };
+
+inline namespace impl
+{
+
+// Exponents of a monomial with C++ integral exponents, for use in the evaluation plans of series.
+template <typename T, typename S>
+struct key_power_exponents<monomial<T, S>, enable_if_t<std::is_integral<T>::value>> {
+    using value_type = T;
+    static void get(const monomial<T, S> &m, const symbol_fset &s, std::vector<T> &out)
+    {
+        const auto sbe = m.size_begin_end();
+        if (unlikely(s.size() != std::get<0>(sbe))) {
+            piranha_throw(std::invalid_argument, "invalid sizes in the extraction of the exponents of a monomial: the "
+                                                 "monomial has a size of "
+                                                     + std::to_string(std::get<0>(sbe))
+                                                     + ", while the reference symbol set has a size of "
+                                                     + std::to_string(s.size()));
+        }
+        out.assign(std::get<1>(sbe), std::get<2>(sbe));
+    }
+};
+}
 }
 
 #if defined(PIRANHA_WITH_BOOST_S11N)
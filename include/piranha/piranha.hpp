@@ -161,6 +161,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/divisor.hpp>
 #include <piranha/divisor_series.hpp>
 #include <piranha/dynamic_aligning_allocator.hpp>
+#include <piranha/estimation_log.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/hash_set.hpp>
 #include <piranha/integer.hpp>
@@ -30,8 +30,11 @@ see https://www.gnu.org/licenses/. */
 #define PIRANHA_POLYNOMIAL_HPP
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath> // For std::ceil.
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -54,14 +57,19 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/config.hpp>
 #include <piranha/detail/atomic_flag_array.hpp>
 #include <piranha/detail/cf_mult_impl.hpp>
+#include <piranha/detail/cf_recycler.hpp>
 #include <piranha/detail/debug_access.hpp>
 #include <piranha/detail/divisor_series_fwd.hpp>
+#include <piranha/detail/hyperloglog.hpp>
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/int128.hpp>
+#include <piranha/detail/multimodular.hpp>
 #include <piranha/detail/parallel_vector_transform.hpp>
 #include <piranha/detail/poisson_series_fwd.hpp>
 #include <piranha/detail/polynomial_fwd.hpp>
 #include <piranha/detail/safe_integral_arith.hpp>
 #include <piranha/detail/sfinae_types.hpp>
+#include <piranha/detail/thread_partition.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/forwarding.hpp>
 #include <piranha/integer.hpp>
@@ -451,6 +459,149 @@ class polynomial
             polynomial::clear_pow_cache();
         }
     }
+    // Multinomial exponentiation. The degree type of the key, detected via its degree() method.
+    template <typename K>
+    using key_degree_t = decltype(std::declval<const K &>().degree(std::declval<const symbol_fset &>()));
+    // The recurrence requires coefficients supporting division (for integral coefficients the divisions
+    // are exact), multiplication of polynomials yielding polynomials and key degrees castable to std::size_t.
+    template <typename T, typename Ret>
+    using multinomial_pow_enabler = conjunction<
+        std::is_same<Ret, polynomial>, std::is_same<pow_ret_type<T>, polynomial>,
+        std::is_same<polynomial, decltype(std::declval<const polynomial &>() * std::declval<const polynomial &>())>,
+        disjunction<mppp::is_integer<Cf>, mppp::is_rational<Cf>, std::is_floating_point<Cf>>,
+        is_safely_castable<const T &, integer>,
+        is_safely_castable<addlref_t<const detected_t<key_degree_t, Key>>, std::size_t>>;
+    // Compute this**x via the recurrence of J.C.P. Miller for the powers of formal power series, applied
+    // to the homogeneous components of the polynomial. If p = p_0 + p_1 + ... + p_d, where p_i is the homogeneous
+    // component of degree i and p_0 is a nonzero constant, the homogeneous components P_k of p**n satisfy
+    // P_0 = p_0**n and
+    // P_k = 1 / (k * p_0) * sum_{i=1}^{min(k,d)} ((n + 1) * i - k) * p_i * P_{k-i}.
+    // p**n is thus built in a single pass, without computing the intermediate powers. Returns false if the
+    // algorithm is not applicable or not selected, true otherwise.
+    template <typename T, typename Ret, enable_if_t<multinomial_pow_enabler<T, Ret>::value, int> = 0>
+    bool pow_multinomial(const T &x, Ret &retval) const
+    {
+        using term_type = typename base::term_type;
+        using key_type = typename term_type::key_type;
+        const auto strategy = tuning::get_pow_strategy();
+        if (strategy != pow_strategy::automatic && strategy != pow_strategy::multinomial) {
+            return false;
+        }
+        // The series multiplications in the recurrence would be truncated.
+        {
+            std::lock_guard<std::mutex> lock(s_at_degree_mutex);
+            if (s_at_degree_mode != 0) {
+                return false;
+            }
+        }
+        // Non-integral and negative exponents are dealt with by the base pow() method.
+        std::size_t n;
+        try {
+            const auto tmp = piranha::safe_cast<integer>(x);
+            if (tmp.sgn() < 0) {
+                return false;
+            }
+            n = piranha::safe_cast<std::size_t>(tmp);
+        } catch (const safe_cast_failure &) {
+            return false;
+        }
+        const auto &ss = this->m_symbol_set;
+        // Determine the degree of the polynomial and locate the constant term.
+        std::size_t deg = 0u;
+        const term_type *c_term = nullptr;
+        for (const auto &t : this->m_container) {
+            std::size_t d;
+            try {
+                d = piranha::safe_cast<std::size_t>(t.m_key.degree(ss));
+            } catch (const safe_cast_failure &) {
+                // Negative or non-integral degrees.
+                return false;
+            }
+            if (!d) {
+                // NOTE: a key with zero total degree is not necessarily unitary (e.g., x/y).
+                if (!piranha::key_is_one(t.m_key, ss)) {
+                    return false;
+                }
+                c_term = &t;
+            }
+            deg = std::max(deg, d);
+        }
+        if (c_term == nullptr || !deg || n > std::numeric_limits<std::size_t>::max() / deg) {
+            return false;
+        }
+        // NOTE: for small exponents the direct multiplications are cheaper. The threshold is a tuning parameter.
+        // In automatic mode, the recurrence is used only for exact coefficient types, so that the result
+        // does not depend on the algorithm, and powers which are already in the cache are fetched from it.
+        if (strategy == pow_strategy::automatic) {
+            if (n < 3u || std::is_floating_point<Cf>::value) {
+                return false;
+            }
+            if (this->pow_cache_find(n, retval)) {
+                return true;
+            }
+        }
+        // Split the polynomial in its homogeneous components.
+        polynomial proto;
+        proto.set_symbol_set(ss);
+        std::vector<polynomial> comps(deg + 1u, proto);
+        for (const auto &t : this->m_container) {
+            if (&t != c_term) {
+                comps[piranha::safe_cast<std::size_t>(t.m_key.degree(ss))].insert(t);
+            }
+        }
+        const Cf &c0 = c_term->m_cf;
+        // The constant term of the result, c0**n, computed via repeated squaring.
+        Cf c0n(1), c0p(c0);
+        for (auto e = n;;) {
+            if (e % 2u) {
+                c0n *= c0p;
+            }
+            e /= 2u;
+            if (!e) {
+                break;
+            }
+            c0p *= c0p;
+        }
+        const std::size_t res_deg = n * deg;
+        std::vector<polynomial> res(res_deg + 1u, proto);
+        res[0].insert(term_type(std::move(c0n), key_type(ss)));
+        retval = proto;
+        // Index of the next homogeneous component of the result to be added to retval.
+        std::size_t flushed = 0u;
+        const integer n1 = integer(n) + 1;
+        polynomial tmp;
+        for (std::size_t k = 1u; k <= res_deg; ++k) {
+            auto &pk = res[k];
+            for (std::size_t i = 1u; i <= std::min(k, deg); ++i) {
+                if (comps[i].empty() || res[k - i].empty()) {
+                    continue;
+                }
+                const integer f = n1 * integer(i) - integer(k);
+                if (piranha::is_zero(f)) {
+                    continue;
+                }
+                tmp = comps[i];
+                tmp *= Cf(f);
+                series_multiplier<polynomial>(tmp, res[k - i])._multiply_accumulate(pk);
+            }
+            // NOTE: for integral coefficients the division is exact.
+            pk /= Cf(k) * c0;
+            // The component of degree k - deg will not be needed anymore.
+            if (k >= deg) {
+                retval += std::move(res[k - deg]);
+                flushed = k - deg + 1u;
+            }
+        }
+        for (; flushed <= res_deg; ++flushed) {
+            retval += std::move(res[flushed]);
+        }
+        return true;
+    }
+    template <typename T, typename Ret, enable_if_t<!multinomial_pow_enabler<T, Ret>::value, int> = 0>
+    bool pow_multinomial(const T &, Ret &) const
+    {
+        return false;
+    }
 
 public:
     /// Series rebind alias.
@@ -519,16 +670,34 @@ public:
      *
      * This exponentiation override will check if the polynomial consists of a single-term with non-unitary
      * key. In that case, the return polynomial will consist of a single term with coefficient computed via
-     * piranha::pow() and key computed via the monomial exponentiation method. Otherwise, the base
-     * (i.e., default) exponentiation method will be used.
+     * piranha::pow() and key computed via the monomial exponentiation method.
+     *
+     * Otherwise, if the polynomial has a nonzero constant term, the coefficient type is an mp++ integer or rational
+     * or a floating-point type, the total degrees of the monomials are non-negative integers, \p x represents
+     * a non-negative integral value and the auto-truncation is disabled, the power may be computed via the
+     * recurrence of J.C.P. Miller for the powers of formal power series. The homogeneous components \f$ P_k \f$
+     * of \f$ p^n \f$, with \f$ p = p_0 + p_1 + \ldots + p_d \f$, are computed in a single pass as
+     * \f[
+     * P_k = \frac{1}{k p_0}\sum_{i=1}^{\min\left(k,d\right)}\left[\left(n+1\right)i-k\right]p_iP_{k-i},
+     * \f]
+     * without computing the intermediate powers of \f$ p \f$. The recurrence is used if the exponentiation
+     * strategy (see piranha::tuning::get_pow_strategy()) is piranha::pow_strategy::multinomial, or if it is
+     * piranha::pow_strategy::automatic, the coefficient type is an mp++ integer or rational, \f$ n \geq 3 \f$
+     * and the power is not in the cache of natural powers (in which case it is fetched from the cache). The result
+     * of the recurrence is not stored in the cache.
+     *
+     * In all the other cases, the base (i.e., default) exponentiation method will be used.
      *
      * @param x exponent.
      *
      * @return \p this to the power of \p x.
      *
      * @throws unspecified any exception thrown by:
-     * - piranha::key_is_one() and the exponentiation methods of the key type,
-     * - piranha::pow(),
+     * - piranha::key_is_one() and the exponentiation and degree methods of the key type,
+     * - piranha::pow(), piranha::safe_cast() and the arithmetic operators of the coefficient type,
+     * - the public interface of the specialisation of piranha::series_multiplier for piranha::polynomial,
+     * - the arithmetic operators of piranha::polynomial,
+     * - threading primitives,
      * - construction of coefficient, key and term,
      * - piranha::series::insert() , piranha::series::set_symbol_set() and piranha::series::pow().
      */
@@ -547,6 +716,10 @@ public:
             retval.insert(term_type(std::move(cf), std::move(key)));
             return retval;
         }
+        ret_type retval;
+        if (pow_multinomial(x, retval)) {
+            return retval;
+        }
         return static_cast<series<Cf, Key, polynomial<Cf, Key>> const *>(this)->pow(x);
     }
     /// Inversion.
@@ -814,6 +987,54 @@ public:
         };
         return um_tm_implementation(p1, p2, runner);
     }
+    /// Sum of products.
+    /**
+     * \note
+     * This function template is enabled only if the calling piranha::polynomial satisfies piranha::is_multipliable,
+     * returning the calling piranha::polynomial as return type.
+     *
+     * This function will return the sum of the products of the pairs of polynomials in \p l, that is,
+     * \f$ a_0 b_0 + a_1 b_1 + \ldots \f$. The result is the same as the one obtained via the multiplication and
+     * addition operators, but, whenever possible, all the products are accumulated into the same series
+     * (see piranha::series_multiplier::_multiply_accumulate()) instead of being computed as temporary series and
+     * then added together.
+     *
+     * @param l the list of pairs of operands.
+     *
+     * @return the sum of the products of the pairs in \p l.
+     *
+     * @throws unspecified any exception thrown by:
+     * - the public interface of the specialisation of piranha::series_multiplier for piranha::polynomial,
+     * - the public interface of piranha::symbol_fset,
+     * - the public interface of piranha::series.
+     */
+    template <typename T = polynomial, um_enabler<T> = 0>
+    static polynomial sum_of_products(std::initializer_list<std::pair<const polynomial &, const polynomial &>> l)
+    {
+        // Merge the symbol sets of all the operands.
+        symbol_fset ss;
+        for (const auto &p : l) {
+            ss = std::get<0>(ss_merge(ss, p.first.get_symbol_set()));
+            ss = std::get<0>(ss_merge(ss, p.second.get_symbol_set()));
+        }
+        polynomial retval, proto;
+        retval.set_symbol_set(ss);
+        proto.set_symbol_set(ss);
+        // Return either the original operand, if it already has the merged symbol set,
+        // or a copy of the operand with the merged symbol set stored in tmp.
+        auto extend = [&ss, &proto](const polynomial &p, polynomial &tmp) -> const polynomial & {
+            if (p.get_symbol_set() == ss) {
+                return p;
+            }
+            tmp = series_merge_f(p, proto, [](const polynomial &a, const polynomial &) { return a; });
+            return tmp;
+        };
+        polynomial tmp1, tmp2;
+        for (const auto &p : l) {
+            series_multiplier<polynomial>(extend(p.first, tmp1), extend(p.second, tmp2))._multiply_accumulate(retval);
+        }
+        return retval;
+    }
     /// Truncated multiplication (total degree).
     /**
      * \note
@@ -988,6 +1209,9 @@ using poly_multiplier_enabler = typename std::enable_if<std::is_base_of<detail::
 template <typename Series>
 class series_multiplier<Series, detail::poly_multiplier_enabler<Series>> : public base_series_multiplier<Series>
 {
+    // Make friend with debug class.
+    template <typename>
+    friend class debug_access;
     // Base multiplier type.
     using base = base_series_multiplier<Series>;
     // Cf type getter shortcut.
@@ -1112,9 +1336,11 @@ class series_multiplier<Series, detail::poly_multiplier_enabler<Series>> : publi
             }
         }
     }
+    // NOTE: the Kronecker version also stores the per-variable bounds of the operands, which are
+    // later used by the dense multiplication.
     template <typename T = Series,
               typename std::enable_if<detail::is_kronecker_monomial<key_t<T>>::value, int>::type = 0>
-    void check_bounds() const
+    void check_bounds()
     {
         using value_type = typename key_t<Series>::value_type;
         using ka = kronecker_array<value_type>;
@@ -1188,6 +1414,11 @@ class series_multiplier<Series, detail::poly_multiplier_enabler<Series>> : publi
                 piranha_throw(std::overflow_error, "Kronecker monomial components are out of bounds");
             }
         }
+        auto to_integer = [](const std::pair<value_type, value_type> &p) {
+            return std::make_pair(integer(p.first), integer(p.second));
+        };
+        std::transform(minmax_values1.begin(), minmax_values1.end(), std::back_inserter(m_minmax1), to_integer);
+        std::transform(minmax_values2.begin(), minmax_values2.end(), std::back_inserter(m_minmax2), to_integer);
     }
     // Implementation detail of the bound checking logic. This is common enough to be shared.
     template <typename MmVec, typename Func>
@@ -1235,6 +1466,12 @@ class series_multiplier<Series, detail::poly_multiplier_enabler<Series>> : publi
     template <typename T>
     using call_enabler = typename std::enable_if<
         key_is_multipliable<cf_t<T>, key_t<T>>::value && has_multiply_accumulate<cf_t<T>>::value, int>::type;
+    // Enabler for the heap-based multiplication.
+    template <typename T>
+    using heap_enabler =
+        typename std::enable_if<key_is_multipliable<cf_t<T>, key_t<T>>::value && has_multiply_accumulate<cf_t<T>>::value
+                                    && detail::is_kronecker_monomial<key_t<T>>::value,
+                                int>::type;
     // Utility helpers for the subtraction of degree types in the truncation routines. The specialisation
     // for integral types will check the operation for overflow.
     template <typename T, typename std::enable_if<!std::is_integral<T>::value, int>::type = 0>
@@ -1364,6 +1601,39 @@ public:
     {
         return um_impl();
     }
+    /// Multiply-accumulate.
+    /**
+     * \note
+     * This method can be used only if operator()() can be called.
+     *
+     * This method will add to \p retval the result of multiplying the two polynomials used as input arguments
+     * in the class' constructor, as computed by operator()(). If the key type of \p Series is a Kronecker monomial,
+     * the coefficient type is not a rational and no truncation is active, the term-by-term products will be
+     * accumulated directly into \p retval with the sparse Kronecker multiplication algorithm, without creating
+     * a temporary series for the product. Otherwise, the product will be computed via operator()() and then
+     * added to \p retval.
+     *
+     * If \p retval is one of the two polynomials used as input arguments in the class' constructor, the product will
+     * always be computed via operator()() and then added to \p retval, as the insertion of new terms into \p retval
+     * would invalidate the terms of the operand during the multiplication.
+     *
+     * If an exception is thrown, \p retval will be left in an unspecified but valid state.
+     *
+     * @param retval the series into which the product will be accumulated.
+     *
+     * @throws std::invalid_argument if the symbol set of \p retval differs from the symbol set of the operands.
+     * @throws unspecified any exception thrown by operator()(), or by the in-place addition of \p Series.
+     */
+    template <typename T = Series, call_enabler<T> = 0>
+    void _multiply_accumulate(Series &retval) const
+    {
+        if (unlikely(retval.get_symbol_set() != this->m_ss)) {
+            piranha_throw(std::invalid_argument, "incompatible symbol sets in multiply-accumulate");
+        }
+        if (operand_aliases(retval) || !kronecker_multiply_accumulate(retval)) {
+            retval += execute();
+        }
+    }
     /// Truncated multiplication.
     /**
      * \note
@@ -1526,6 +1796,95 @@ public:
         piranha_assert(retval_checker());
         return retval;
     }
+    /// Heap-based multiplication with a callback.
+    /**
+     * \note
+     * This method can be used only if operator()() can be called and the key type of \p Series is
+     * piranha::kronecker_monomial.
+     *
+     * This method will compute the product of the two polynomials used as input arguments in the class' constructor
+     * with the heap-based algorithm of Monagan and Pearce, and it will pass the terms of the result, one at a time,
+     * to \p f. Since the codification of piranha::kronecker_monomial is linear, the term-by-term products can be
+     * generated in ascending order of Kronecker code by merging, via a binary heap, the rows of products of each term
+     * of the shorter operand by the terms of the longer operand. The terms of the result are thus passed to \p f in
+     * ascending order of Kronecker code, with distinct keys, nonzero and finalised coefficients (see
+     * piranha::base_series_multiplier::finalise_term()).
+     *
+     * The heap contains at most one entry per term of the shorter operand: apart from a sorted copy of the term
+     * pointers of the two operands, the working memory of this method is proportional to the size of the shorter
+     * operand and it does not depend on the size of the result, which is never stored. The multiplication is
+     * untruncated and single-threaded, and it is never selected automatically by operator()().
+     *
+     * @param f the function object that will be invoked on each term of the result, as an rvalue.
+     *
+     * @throws unspecified any exception thrown by:
+     * - the invocation of \p f,
+     * - memory errors in standard containers,
+     * - piranha::math::mul3(),
+     * - piranha::math::multiply_accumulate(),
+     * - the canonicalisation of rational coefficients.
+     */
+    template <typename F, typename T = Series, heap_enabler<T> = 0>
+    void _heap_multiplication(const F &f) const
+    {
+        using term_type = typename Series::term_type;
+        heap_kronecker_multiplication([this, &f](term_type &&t) {
+            this->finalise_term(t);
+            f(std::move(t));
+        });
+    }
+    /// Heap-based multiplication.
+    /**
+     * \note
+     * This method can be used only if operator()() can be called and the key type of \p Series is
+     * piranha::kronecker_monomial.
+     *
+     * This method will return the result of multiplying the two polynomials used as input arguments in the class'
+     * constructor, computed with the heap-based algorithm of Monagan and Pearce (see the callback overload of this
+     * method). The terms of the result are inserted in the output series as they are produced, without intermediate
+     * storage. Note that the output series is a hash table, so that the ordering in which the terms are
+     * produced is not preserved and the memory used is proportional to the size of the result: the callback
+     * overload should be preferred when the terms are needed in order or when the result does not need to be stored.
+     *
+     * @return the result of the multiplication of the two operands used in the construction of \p this.
+     *
+     * @throws unspecified any exception thrown by:
+     * - piranha::base_series_multiplier::finalise_series(),
+     * - the public interface of piranha::hash_set,
+     * - memory errors in standard containers,
+     * - piranha::math::mul3(),
+     * - piranha::math::multiply_accumulate().
+     */
+    template <typename T = Series, heap_enabler<T> = 0>
+    Series _heap_multiplication() const
+    {
+        using term_type = typename Series::term_type;
+        using bucket_size_type = typename base::bucket_size_type;
+        Series retval;
+        retval.set_symbol_set(this->m_ss);
+        this->setup_node_arena(retval);
+        auto &container = retval._container();
+        try {
+            // NOTE: the terms are produced with distinct keys and nonzero coefficients, so they can be inserted
+            // directly, growing the table as needed.
+            heap_kronecker_multiplication([&container](term_type &&t) {
+                if (unlikely(!container.bucket_count()
+                             || static_cast<double>(container.size() + bucket_size_type(1u))
+                                        / static_cast<double>(container.bucket_count())
+                                    > container.max_load_factor())) {
+                    container._increase_size();
+                }
+                const auto bucket_idx = container._bucket(t);
+                container._unique_insert(std::move(t), bucket_idx);
+                container._update_size(static_cast<bucket_size_type>(container.size() + bucket_size_type(1u)));
+            });
+            this->finalise_series(retval);
+        } catch (...) {
+            container.clear();
+            throw;
+        }
+        return retval;
+    }
     //@}
 private:
     // NOTE: wrapper to multadd that treats specially rational coefficients. We need to decide in the future
@@ -1540,6 +1899,163 @@ private:
     {
         math::multiply_accumulate(a._get_num(), b.get_num(), c.get_num());
     }
+#if defined(PIRANHA_HAVE_GCC_INT128)
+    // Conversion of a coefficient to a machine word. Rational coefficients have been lifted to integral values
+    // in the constructor of base_series_multiplier, so that only their numerators need to be considered.
+    template <typename T, typename std::enable_if<mppp::is_integer<T>::value, int>::type = 0>
+    static bool cf_to_word(const T &cf, long long &n)
+    {
+        return cf.get(n);
+    }
+    template <typename T, typename std::enable_if<mppp::is_rational<T>::value, int>::type = 0>
+    static bool cf_to_word(const T &cf, long long &n)
+    {
+        piranha_assert(cf.get_den() == 1);
+        return cf.get_num().get(n);
+    }
+    template <typename T>
+    using has_word_cfs = std::integral_constant<bool, mppp::is_integer<T>::value || mppp::is_rational<T>::value>;
+    // Small-integer fast path: if the coefficients are mp++ integers or rationals and all the coefficients of v1
+    // and v2 fit in a machine word, write them into w1 and w2 and return true. The products of the coefficients
+    // can then be accumulated in 128-bit integers, provided that the accumulation of the min(size1, size2) products
+    // contributing to a term of the result cannot overflow, which is also checked here.
+    template <typename T = Series, typename std::enable_if<has_word_cfs<cf_t<T>>::value, int>::type = 0>
+    static bool word_cfs(const typename base::v_ptr &v1, const typename base::v_ptr &v2, std::vector<long long> &w1,
+                         std::vector<long long> &w2)
+    {
+        auto extract = [](const typename base::v_ptr &v, std::vector<long long> &w, unsigned long long &max) {
+            w.resize(v.size());
+            max = 0u;
+            for (decltype(v.size()) i = 0u; i < v.size(); ++i) {
+                if (!cf_to_word(v[i]->m_cf, w[i])) {
+                    return false;
+                }
+                max = std::max(max, detail::word_abs(w[i]));
+            }
+            return true;
+        };
+        unsigned long long max1, max2;
+        if (!extract(v1, w1, max1) || !extract(v2, w2, max2)) {
+            return false;
+        }
+        return detail::int128_accumulation_safe(max1, max2,
+                                                static_cast<unsigned long long>(std::min(v1.size(), v2.size())));
+    }
+    template <typename T = Series, typename std::enable_if<!has_word_cfs<cf_t<T>>::value, int>::type = 0>
+    static bool word_cfs(const typename base::v_ptr &, const typename base::v_ptr &, std::vector<long long> &,
+                         std::vector<long long> &)
+    {
+        return false;
+    }
+    // Conversion of a 128-bit accumulator to a coefficient, only needed when word_cfs() returns true.
+    template <typename T, typename std::enable_if<mppp::is_integer<T>::value, int>::type = 0>
+    static void int128_to_cf(T &out, const detail::int128_t &n)
+    {
+        detail::int128_to_integer(out, n);
+    }
+    // NOTE: the result is a rational with unitary denominator, which will be fixed by the finalisation.
+    template <typename T, typename std::enable_if<mppp::is_rational<T>::value, int>::type = 0>
+    static void int128_to_cf(T &out, const detail::int128_t &n)
+    {
+        detail::int128_to_integer(out._get_num(), n);
+        out._get_den() = 1;
+    }
+    template <typename T, typename std::enable_if<!has_word_cfs<T>::value, int>::type = 0>
+    static void int128_to_cf(T &, const detail::int128_t &)
+    {
+        piranha_assert(false);
+    }
+    template <typename T, typename std::enable_if<!has_word_cfs<T>::value, int>::type = 0>
+    static bool cf_to_word(const T &, long long &)
+    {
+        piranha_assert(false);
+        return false;
+    }
+    // Accumulator operations for the dense multiplication, in the small-integer case.
+    static void dense_acc_fma(detail::int128_t &a, const long long &b, const long long &c)
+    {
+        a += static_cast<detail::int128_t>(b) * c;
+    }
+    static bool dense_acc_is_zero(const detail::int128_t &a)
+    {
+        return a == 0;
+    }
+    template <typename T>
+    static void dense_acc_move(T &out, detail::int128_t &a)
+    {
+        int128_to_cf(out, a);
+    }
+    // Accumulator type of the small-integer fast path of the sparse multiplication.
+    using sparse_acc_type = detail::int128_t;
+    // Index of a 128-bit accumulator of the sparse multiplication, as stored in the coefficient cf.
+    template <typename T>
+    static long long sparse_acc_idx(const T &cf)
+    {
+        long long idx = 0;
+        const bool ok = cf_to_word(cf, idx);
+        piranha_assert(ok && idx >= 0);
+        (void)ok;
+        return idx;
+    }
+    // Replace the indices of the 128-bit accumulators stored in the coefficients of retval by the values
+    // of the accumulators, in the small-integer case of the sparse multiplication. The accumulator with
+    // index idx is accs[idx & t_mask][idx >> t_bits].
+    void sparse_acc_finalise(Series &retval, const std::vector<std::vector<detail::int128_t>> &accs,
+                             const unsigned &t_bits) const
+    {
+        using bucket_size_type = typename base::bucket_size_type;
+        auto &container = retval._container();
+        const auto t_mask = (1ll << t_bits) - 1;
+        auto acc_mover = [&container, &accs, t_bits, t_mask](const bucket_size_type &start,
+                                                            const bucket_size_type &end) {
+            for (bucket_size_type i = start; i != end; ++i) {
+                for (const auto &t : container._get_bucket_list(i)) {
+                    const auto idx = sparse_acc_idx(t.m_cf);
+                    int128_to_cf(t.m_cf, accs[static_cast<std::size_t>(idx & t_mask)]
+                                             [static_cast<std::size_t>(idx >> t_bits)]);
+                }
+            }
+        };
+        const auto b_count = container.bucket_count();
+        if (this->m_n_threads == 1u) {
+            acc_mover(0u, b_count);
+            return;
+        }
+        future_list<decltype(acc_mover(bucket_size_type(), bucket_size_type()))> f_list;
+        try {
+            for (unsigned i = 0u; i < this->m_n_threads; ++i) {
+                const auto range = detail::thread_partition(b_count, this->m_n_threads, i);
+                f_list.push_back(thread_pool::enqueue(i, acc_mover, range.first, range.second));
+            }
+            // First let's wait for everything to finish.
+            f_list.wait_all();
+            // Then, let's handle the exceptions.
+            f_list.get_all();
+        } catch (...) {
+            f_list.wait_all();
+            throw;
+        }
+    }
+#else
+    // NOTE: unused, the small-integer fast path needs 128-bit integers.
+    using sparse_acc_type = long long;
+#endif
+    // Accumulator operations for the dense multiplication, in the general case.
+    template <typename T, typename U>
+    static void dense_acc_fma(T &a, const U *p1, const U *p2)
+    {
+        fma_wrap(a, p1->m_cf, p2->m_cf);
+    }
+    template <typename T>
+    static bool dense_acc_is_zero(const T &a)
+    {
+        return piranha::is_zero(a);
+    }
+    template <typename T>
+    static void dense_acc_move(T &out, T &a)
+    {
+        out = std::move(a);
+    }
     // Wrapper for the plain multiplication routine.
     // Case 1: no auto truncation available, just run the plain multiplication.
     template <typename T = Series,
@@ -1623,6 +2139,33 @@ private:
         }
         return untruncated_kronecker_mult();
     }
+    // Determine whether the estimation of the size of the result is worth it in the Kronecker multiplication.
+    // We check the threshold, and we force the estimation in multithreaded mode.
+    bool kronecker_estimate_needed() const
+    {
+        const auto e_thr = tuning::get_estimate_threshold();
+        return integer(this->m_v1.size()) * this->m_v2.size() >= integer(e_thr) * e_thr || this->m_n_threads != 1u;
+    }
+    // Estimate of the size of the result of the Kronecker multiplication.
+    template <typename T = Series,
+              typename std::enable_if<detail::is_kronecker_monomial<typename T::term_type::key_type>::value, int>::type
+              = 0>
+    typename Series::size_type kronecker_estimate() const
+    {
+        // Use the plain functor in normal mode for the estimation. If some of the sampling trials did not find
+        // any duplicate, the operands are very sparse and the sampled estimate is just an upper bound: count
+        // the distinct codes of the products instead, if the number of products is small enough.
+        typename Series::size_type est;
+        if (!this->cached_final_series_size(est)) {
+            const auto se
+                = this->template sample_final_series_size<1u, typename base::template plain_multiplier<false>>();
+            est = se.m_n_saturated
+                          && integer(this->m_v1.size()) * this->m_v2.size() <= integer(sketch_max_products())
+                      ? std::min(se.m_value, sketch_kronecker_size())
+                      : se.m_value;
+        }
+        return est;
+    }
     template <typename T = Series,
               typename std::enable_if<detail::is_kronecker_monomial<typename T::term_type::key_type>::value, int>::type
               = 0>
@@ -1630,23 +2173,17 @@ private:
     {
         // Cache the sizes.
         const auto size1 = this->m_v1.size(), size2 = this->m_v2.size();
-        // Determine whether we want to estimate or not. We check the threshold, and
-        // we force the estimation in multithreaded mode.
-        bool estimate = true;
-        const auto e_thr = tuning::get_estimate_threshold();
-        if (integer(size1) * size2 < integer(e_thr) * e_thr && this->m_n_threads == 1u) {
-            estimate = false;
-        }
         // If estimation is not worth it, we go with the plain multiplication.
         // NOTE: this is probably not optimal, but we have to do like this as the sparse
         // Kronecker multiplication below requires estimation. Maybe in the future we can
         // have a version without estimation.
-        if (!estimate) {
+        if (!kronecker_estimate_needed()) {
             return this->plain_multiplication();
         }
         // Setup the return value.
         Series retval;
         retval.set_symbol_set(this->m_ss);
+        this->setup_node_arena(retval);
         // Do not do anything if one of the two series is empty, just return an empty series.
         if (unlikely(!size1 || !size2)) {
             return retval;
@@ -1656,17 +2193,568 @@ private:
         // NOTE: it is important here that we use the same n_threads for multiplication and memset as
         // we tie together pinned threads with potentially different NUMA regions.
         const unsigned n_threads_rehash = tuning::get_parallel_memory_set() ? this->m_n_threads : 1u;
-        // Use the plain functor in normal mode for the estimation.
-        const auto est
-            = this->template estimate_final_series_size<1u, typename base::template plain_multiplier<false>>();
-        // NOTE: if something goes wrong here, no big deal as retval is still empty.
-        retval._container().rehash(boost::numeric_cast<typename Series::size_type>(
-                                       std::ceil(static_cast<double>(est) / retval._container().max_load_factor())),
-                                   n_threads_rehash);
-        piranha_assert(retval._container().bucket_count());
+        const auto est = kronecker_estimate();
+        const auto n_buckets = boost::numeric_cast<typename Series::size_type>(
+            std::ceil(static_cast<double>(est) / retval._container().max_load_factor()));
+        // If the result does not fit in the memory limit, use the chunked mode of the plain multiplication,
+        // reusing the estimate.
+        if (this->chunked_multiplication_n_chunks(n_buckets) > 1u) {
+            return this->_plain_multiplication(est);
+        }
+        // If the exponents of the result are confined in a small box, use the dense multiplication.
+        std::vector<std::size_t> dense_weights;
+        const auto dense_size = dense_kronecker_setup(n_buckets, dense_weights);
+        if (dense_size) {
+            retval = dense_kronecker_multiplication(dense_size, dense_weights);
+        } else {
+            // NOTE: if something goes wrong here, no big deal as retval is still empty.
+            retval._container().rehash(n_buckets, n_threads_rehash);
+            piranha_assert(retval._container().bucket_count());
+            sparse_kronecker_multiplication(retval);
+        }
+        this->register_final_series_size(est, retval.size());
+        return retval;
+    }
+    // Check if retval is one of the operands. The terms of the operands are referred to by pointer, thus it
+    // is enough to check if the first term of an operand is stored in retval.
+    bool operand_aliases(const Series &retval) const
+    {
+        const auto &container = retval._container();
+        auto check = [&container](const typename base::v_ptr &v) {
+            if (v.empty()) {
+                return false;
+            }
+            const auto it = container.find(*v[0]);
+            return it != container.end() && &*it == v[0];
+        };
+        return check(this->m_v1) || check(this->m_v2);
+    }
+    // Accumulate the product into retval with the sparse Kronecker multiplication. Returns false if
+    // this is not possible, without touching retval.
+    template <typename T = Series,
+              typename std::enable_if<detail::is_kronecker_monomial<typename T::term_type::key_type>::value, int>::type
+              = 0>
+    bool kronecker_multiply_accumulate(Series &retval) const
+    {
+        // NOTE: rational coefficients cannot be accumulated, as the finalisation would apply the lcms of
+        // the operands to the whole content of retval.
+        if (mppp::is_rational<cf_t<Series>>::value || check_truncation() || !kronecker_estimate_needed()) {
+            return false;
+        }
+        if (unlikely(this->m_v1.empty() || this->m_v2.empty())) {
+            return true;
+        }
+        // Size the container for the current terms of retval plus the estimated terms of the product.
+        auto &container = retval._container();
+        const auto n_buckets = boost::numeric_cast<typename Series::size_type>(
+            std::ceil(static_cast<double>(container.size() + kronecker_estimate()) / container.max_load_factor()));
+        if (this->chunked_multiplication_n_chunks(n_buckets) > 1u) {
+            return false;
+        }
+        if (n_buckets > container.bucket_count()) {
+            const unsigned n_threads_rehash = tuning::get_parallel_memory_set() ? this->m_n_threads : 1u;
+            container.rehash(n_buckets, n_threads_rehash);
+        }
+        piranha_assert(container.bucket_count());
         sparse_kronecker_multiplication(retval);
+        return true;
+    }
+    template <typename T = Series,
+              typename std::enable_if<!detail::is_kronecker_monomial<typename T::term_type::key_type>::value, int>::type
+              = 0>
+    bool kronecker_multiply_accumulate(Series &) const
+    {
+        return false;
+    }
+    // Estimate the size of the product by counting the distinct codes of all the term-by-term products
+    // with a HyperLogLog sketch. This is a full pass over the products, but it touches only the
+    // codes and its accuracy does not depend on the sparsity of the operands. It is used only if the number of
+    // products does not exceed sketch_max_products().
+    // NOTE: the count of the distinct codes in a sample of the products cannot be extrapolated to the whole set of
+    // products: in the sparse case, almost all the sampled codes are distinct, and any scaling by the sampling
+    // ratio just reproduces the number of products.
+    static constexpr unsigned long long sketch_max_products()
+    {
+        return 1ull << 24;
+    }
+    template <typename T = Series,
+              typename std::enable_if<detail::is_kronecker_monomial<typename T::term_type::key_type>::value, int>::type
+              = 0>
+    typename Series::size_type sketch_kronecker_size() const
+    {
+        using int_type = typename Series::term_type::key_type::value_type;
+        using size_type = typename base::size_type;
+        std::vector<int_type> c1, c2;
+        c1.reserve(this->m_v1.size());
+        c2.reserve(this->m_v2.size());
+        for (const auto &ptr : this->m_v1) {
+            c1.push_back(ptr->m_key.get_int());
+        }
+        for (const auto &ptr : this->m_v2) {
+            c2.push_back(ptr->m_key.get_int());
+        }
+        const unsigned n_threads = this->m_n_threads;
+        const size_type size1 = this->m_v1.size();
+        detail::hyperloglog sketch;
+        std::mutex mut;
+        auto thread_func = [&c1, &c2, &sketch, &mut, n_threads, size1](unsigned thread_idx) {
+            detail::hyperloglog local;
+            const auto r = detail::thread_partition(size1, n_threads, thread_idx);
+            for (auto i = r.first; i < r.second; ++i) {
+                const auto code1 = c1[i];
+                for (const auto &code2 : c2) {
+                    // NOTE: the range of the codes of the products has been checked in the constructor.
+                    local.add(static_cast<std::uint64_t>(static_cast<int_type>(code1 + code2)));
+                }
+            }
+            std::lock_guard<std::mutex> lock(mut);
+            sketch.merge(local);
+        };
+        if (n_threads == 1u) {
+            thread_func(0u);
+        } else {
+            future_list<void> ff_list;
+            try {
+                for (unsigned i = 0u; i < n_threads; ++i) {
+                    ff_list.push_back(thread_pool::enqueue(i, thread_func, i));
+                }
+                // First let's wait for everything to finish.
+                ff_list.wait_all();
+                // Then, let's handle the exceptions.
+                ff_list.get_all();
+            } catch (...) {
+                ff_list.wait_all();
+                throw;
+            }
+        }
+        // NOTE: the sketch has a relative standard error of about 1.6%. Inflate the estimate so that the result
+        // is unlikely to be undersized.
+        const double retval = std::ceil(sketch.estimate() * 1.05);
+        if (retval >= static_cast<double>(std::numeric_limits<typename Series::size_type>::max())) {
+            return std::numeric_limits<typename Series::size_type>::max();
+        }
+        return retval < 1. ? typename Series::size_type(1u) : static_cast<typename Series::size_type>(retval);
+    }
+    // Heap-based multiplication after Monagan and Pearce. The heap entry (i, j) represents the product of the i-th
+    // term of the shorter operand v2 by the j-th term of v1, with both operands sorted by Kronecker code. When (i, j)
+    // is extracted from the heap, it is replaced by (i, j + 1) and, if j is zero, by (i + 1, 0), so that the heap
+    // never contains more than one entry per term of v2. The nonzero terms of the result are passed to f in
+    // ascending order of Kronecker code, with the coefficients not yet finalised.
+    template <typename F>
+    void heap_kronecker_multiplication(const F &f) const
+    {
+        using term_type = typename Series::term_type;
+        using int_type = typename term_type::key_type::value_type;
+        using size_type = typename base::size_type;
+        // NOTE: m_v1 is the longer operand.
+        auto v1 = this->m_v1, v2 = this->m_v2;
+        if (unlikely(v1.empty() || v2.empty())) {
+            return;
+        }
+        auto key_cmp
+            = [](term_type const *p1, term_type const *p2) { return p1->m_key.get_int() < p2->m_key.get_int(); };
+        std::sort(v1.begin(), v1.end(), key_cmp);
+        std::sort(v2.begin(), v2.end(), key_cmp);
+        const auto size1 = v1.size(), size2 = v2.size();
+#if defined(PIRANHA_HAVE_GCC_INT128)
+        // Small-integer fast path: accumulate the products of each term of the result in a 128-bit integer.
+        std::vector<long long> w1, w2;
+        const bool small = word_cfs(v1, v2, w1, w2);
+        detail::int128_t small_acc;
+#endif
+        // Heap entry: the code of the product, the index in v2 and the index in v1.
+        using entry_type = std::tuple<int_type, size_type, size_type>;
+        // NOTE: the heap functions of the standard library build max-heaps, hence the reversed comparison.
+        auto entry_cmp = [](const entry_type &e1, const entry_type &e2) { return std::get<0u>(e1) > std::get<0u>(e2); };
+        // NOTE: the bounds checking in the constructor ensures the sum of the codes does not overflow.
+        auto make_entry = [&v1, &v2](const size_type &i, const size_type &j) {
+            return entry_type(static_cast<int_type>(v2[i]->m_key.get_int() + v1[j]->m_key.get_int()), i, j);
+        };
+        std::vector<entry_type> heap, popped;
+        heap.reserve(size2);
+        heap.push_back(make_entry(0u, 0u));
+        while (!heap.empty()) {
+            const int_type code = std::get<0u>(heap.front());
+            term_type tmp_term;
+            // Extract all the entries with the current code, accumulating the products.
+            popped.clear();
+#if defined(PIRANHA_HAVE_GCC_INT128)
+            small_acc = 0;
+#endif
+            while (!heap.empty() && std::get<0u>(heap.front()) == code) {
+                std::pop_heap(heap.begin(), heap.end(), entry_cmp);
+                const auto &e = heap.back();
+#if defined(PIRANHA_HAVE_GCC_INT128)
+                if (small) {
+                    small_acc += static_cast<detail::int128_t>(w1[std::get<2u>(e)]) * w2[std::get<1u>(e)];
+                    popped.push_back(e);
+                    heap.pop_back();
+                    continue;
+                }
+#endif
+                const auto &cf1 = v1[std::get<2u>(e)]->m_cf;
+                const auto &cf2 = v2[std::get<1u>(e)]->m_cf;
+                if (popped.empty()) {
+                    cf_mult_impl(tmp_term.m_cf, cf1, cf2);
+                } else {
+                    fma_wrap(tmp_term.m_cf, cf1, cf2);
+                }
+                popped.push_back(e);
+                heap.pop_back();
+            }
+            // Insert the successors of the extracted entries.
+            for (const auto &e : popped) {
+                const auto i = std::get<1u>(e), j = std::get<2u>(e);
+                if (j == 0u && i + 1u < size2) {
+                    heap.push_back(make_entry(static_cast<size_type>(i + 1u), 0u));
+                    std::push_heap(heap.begin(), heap.end(), entry_cmp);
+                }
+                if (j + 1u < size1) {
+                    heap.push_back(make_entry(i, static_cast<size_type>(j + 1u)));
+                    std::push_heap(heap.begin(), heap.end(), entry_cmp);
+                }
+            }
+#if defined(PIRANHA_HAVE_GCC_INT128)
+            if (small) {
+                if (small_acc == 0) {
+                    continue;
+                }
+                int128_to_cf(tmp_term.m_cf, small_acc);
+            }
+#endif
+            if (!piranha::is_zero(tmp_term.m_cf)) {
+                tmp_term.m_key.set_int(code);
+                f(std::move(tmp_term));
+            }
+        }
+    }
+    // Setup of the dense multiplication. The exponents of the result are confined in the box of the sums of
+    // the per-variable bounds of the operands computed in check_bounds(). Each monomial in the box can be mapped
+    // to a dense index via a mixed-radix representation with the weights written into weights. The return value
+    // is the number of monomials in the box, or zero if the dense multiplication should not be used.
+    template <typename T = Series, typename std::enable_if<!is_series<cf_t<T>>::value, int>::type = 0>
+    std::size_t dense_kronecker_setup(const typename Series::size_type &n_buckets,
+                                      std::vector<std::size_t> &weights) const
+    {
+        // The bounds are not available if one of the operands is empty or if the symbol set is empty.
+        if (m_minmax1.empty()) {
+            return 0u;
+        }
+        piranha_assert(m_minmax1.size() == m_minmax2.size());
+        integer dsize(1);
+        for (decltype(m_minmax1.size()) i = 0u; i < m_minmax1.size(); ++i) {
+            dsize *= m_minmax1[i].second + m_minmax2[i].second - m_minmax1[i].first - m_minmax2[i].first + 1;
+        }
+        // The dense multiplication is used if the box is not larger than the number of term-by-term
+        // multiplications, if it is not much larger than the hash table that would be used
+        // by the sparse multiplication, and if the accumulator fits in the memory limit.
+        // NOTE: the factor on the number of buckets is a tuning parameter.
+        const unsigned dense_factor = 8u;
+        if (dsize > integer(this->m_v1.size()) * this->m_v2.size() || dsize > integer(n_buckets) * dense_factor
+            || dsize * sizeof(cf_t<Series>) > integer(tuning::get_multiplication_memory_limit())) {
+            return 0u;
+        }
+        weights.clear();
+        std::size_t w = 1u;
+        for (decltype(m_minmax1.size()) i = 0u; i < m_minmax1.size(); ++i) {
+            weights.push_back(w);
+            w *= static_cast<std::size_t>(m_minmax1[i].second + m_minmax2[i].second - m_minmax1[i].first
+                                          - m_minmax2[i].first + 1);
+        }
+        piranha_assert(w == dsize);
+        return w;
+    }
+    // NOTE: the dense accumulator would need to default-construct a large number of coefficients,
+    // which is too expensive for series coefficients.
+    template <typename T = Series, typename std::enable_if<is_series<cf_t<T>>::value, int>::type = 0>
+    std::size_t dense_kronecker_setup(const typename Series::size_type &, std::vector<std::size_t> &) const
+    {
+        return 0u;
+    }
+    // Dense multiplication: the coefficients of the result are accumulated in a flat array indexed by the
+    // dense index of the monomials, which is the sum of the dense offsets of the monomials of the operands.
+    // In multithreaded mode, the array is split in slabs which are claimed dynamically by the threads: each slab
+    // is written by one thread only.
+    Series dense_kronecker_multiplication(const std::size_t &dsize, const std::vector<std::size_t> &weights) const
+    {
+#if defined(PIRANHA_HAVE_GCC_INT128)
+        std::vector<long long> w1, w2;
+        if (word_cfs(this->m_v1, this->m_v2, w1, w2)) {
+            return dense_kronecker_impl<detail::int128_t>(dsize, weights, w1, w2);
+        }
+        if (tuning::get_multimodular_multiplication()) {
+            Series retval;
+            if (dense_kronecker_multimodular(dsize, weights, retval)) {
+                return retval;
+            }
+        }
+#endif
+        return dense_kronecker_impl<cf_t<Series>>(dsize, weights, this->m_v1, this->m_v2);
+    }
+    // Implementation of the dense multiplication. The products of the values in c1 and c2, which correspond to the
+    // terms in m_v1 and m_v2, are accumulated in an array of Acc via dense_acc_fma().
+    template <typename Acc, typename V>
+    Series dense_kronecker_impl(const std::size_t &dsize, const std::vector<std::size_t> &weights,
+                                const std::vector<V> &c1, const std::vector<V> &c2) const
+    {
+        std::vector<Acc> acc(dsize);
+        dense_kronecker_accumulate(weights, c1, c2, acc,
+                                   [](Acc &a, const V &x, const V &y) { dense_acc_fma(a, x, y); });
+        return dense_kronecker_build(dsize, weights, [&acc](const std::size_t &d) { return dense_acc_is_zero(acc[d]); },
+                                     [&acc](cf_t<Series> &out, const std::size_t &d) { dense_acc_move(out, acc[d]); });
+    }
+#if defined(PIRANHA_HAVE_GCC_INT128)
+    // Multimodular dense multiplication: the coefficients of the operands are reduced modulo a set of word-sized
+    // primes, the products are accumulated modulo each prime, and the coefficients of the result are reconstructed
+    // via the Chinese remainder theorem. The number of primes is determined from a bound on the coefficients of the
+    // result. If too many primes would be needed, or if the accumulators do not fit in the memory limit,
+    // false will be returned and retval will not be touched.
+    template <typename T = Series, typename std::enable_if<mppp::is_integer<cf_t<T>>::value, int>::type = 0>
+    bool dense_kronecker_multimodular(const std::size_t &dsize, const std::vector<std::size_t> &weights,
+                                      Series &retval) const
+    {
+        using term_type = typename Series::term_type;
+        using cf_type = cf_t<Series>;
+        const auto &primes = detail::mm_primes();
+        // Twice the bound on the absolute values of the coefficients of the result: each coefficient is the sum
+        // of at most min(size1, size2) products.
+        cf_type max1, max2, tmp;
+        auto max_abs = [&tmp](const typename base::v_ptr &v, cf_type &m) {
+            for (const auto &ptr : v) {
+                abs(tmp, ptr->m_cf);
+                if (tmp > m) {
+                    m = tmp;
+                }
+            }
+        };
+        max_abs(this->m_v1, max1);
+        max_abs(this->m_v2, max2);
+        const cf_type bound2 = max1 * max2 * std::min(this->m_v1.size(), this->m_v2.size()) * 2;
+        // Determine the number of primes, so that their product is greater than bound2.
+        std::size_t n_primes = 0u;
+        cf_type mod(1);
+        while (n_primes == 0u || mod <= bound2) {
+            if (n_primes == primes.size()) {
+                return false;
+            }
+            mod *= primes[n_primes++];
+        }
+        if (integer(dsize) * n_primes * sizeof(std::uint64_t) > integer(tuning::get_multiplication_memory_limit())) {
+            return false;
+        }
+        // Accumulate the products modulo each prime. The accumulation for each prime is parallelised over the
+        // slabs of the accumulator.
+        std::vector<std::vector<std::uint64_t>> accs(n_primes);
+        std::vector<std::uint64_t> r1(this->m_v1.size()), r2(this->m_v2.size());
+        cf_type q, r;
+        for (std::size_t i = 0u; i < n_primes; ++i) {
+            const auto p = primes[i];
+            const auto &m = detail::mm_moduli()[i];
+            const cf_type mp_p(p);
+            auto reduce
+                = [p, &mp_p, &q, &r](term_type const *ptr) { return detail::mm_reduce(ptr->m_cf, p, mp_p, q, r); };
+            std::transform(this->m_v1.begin(), this->m_v1.end(), r1.begin(), reduce);
+            std::transform(this->m_v2.begin(), this->m_v2.end(), r2.begin(), reduce);
+            accs[i].resize(dsize);
+            dense_kronecker_accumulate(weights, r1, r2, accs[i],
+                                       [&m](std::uint64_t &a, const std::uint64_t &x, const std::uint64_t &y) {
+                                           a = detail::mm_fma(a, x, y, m);
+                                       });
+        }
+        // Reconstruct the coefficients. Since the product of the primes is greater than bound2,
+        // a coefficient is zero if and only if all its residues are zero.
+        const detail::mm_crt<cf_type> crt(n_primes);
+        std::vector<std::uint64_t> res(n_primes), work(n_primes);
+        retval = dense_kronecker_build(dsize, weights,
+                                       [&accs, n_primes](const std::size_t &d) {
+                                           for (std::size_t i = 0u; i < n_primes; ++i) {
+                                               if (accs[i][d]) {
+                                                   return false;
+                                               }
+                                           }
+                                           return true;
+                                       },
+                                       [&accs, &crt, &res, &work, n_primes](cf_type &out, const std::size_t &d) {
+                                           for (std::size_t i = 0u; i < n_primes; ++i) {
+                                               res[i] = accs[i][d];
+                                           }
+                                           crt.reconstruct(out, res.data(), work.data());
+                                       });
+        return true;
+    }
+    template <typename T = Series, typename std::enable_if<!mppp::is_integer<cf_t<T>>::value, int>::type = 0>
+    bool dense_kronecker_multimodular(const std::size_t &, const std::vector<std::size_t> &, Series &) const
+    {
+        return false;
+    }
+#endif
+    // Accumulate into acc all the term-by-term products of the dense multiplication, via the functor
+    // acc_fma(acc_element, c1_element, c2_element).
+    template <typename Acc, typename V, typename F>
+    void dense_kronecker_accumulate(const std::vector<std::size_t> &weights, const std::vector<V> &c1,
+                                    const std::vector<V> &c2, std::vector<Acc> &acc, const F &acc_fma) const
+    {
+        using int_type = typename Series::term_type::key_type::value_type;
+        using dv_type = std::vector<std::pair<std::size_t, V>>;
+        const auto &args = this->m_ss;
+        const auto n_vars = weights.size();
+        const std::size_t dsize = acc.size();
+        piranha_assert(n_vars == args.size() && n_vars == m_minmax1.size());
+        // Minimum exponents of the operands.
+        std::vector<int_type> min1, min2;
+        for (decltype(m_minmax1.size()) i = 0u; i < n_vars; ++i) {
+            min1.push_back(static_cast<int_type>(m_minmax1[i].first));
+            min2.push_back(static_cast<int_type>(m_minmax2[i].first));
+        }
+        // Compute the dense offsets of the terms of an operand, and sort them.
+        auto dv_builder = [&args, &weights, n_vars](const typename base::v_ptr &v, const std::vector<V> &c,
+                                                    const std::vector<int_type> &mins) {
+            piranha_assert(v.size() == c.size());
+            dv_type retval;
+            retval.reserve(v.size());
+            for (decltype(v.size()) j = 0u; j < v.size(); ++j) {
+                const auto tmp = v[j]->m_key.unpack(args);
+                std::size_t offset = 0u;
+                for (decltype(weights.size()) i = 0u; i < n_vars; ++i) {
+                    offset += static_cast<std::size_t>(tmp[static_cast<decltype(tmp.size())>(i)] - mins[i])
+                              * weights[i];
+                }
+                retval.emplace_back(offset, c[j]);
+            }
+            std::sort(retval.begin(), retval.end(),
+                      [](const typename dv_type::value_type &a, const typename dv_type::value_type &b) {
+                          return a.first < b.first;
+                      });
+            return retval;
+        };
+        const auto dv1 = dv_builder(this->m_v1, c1, min1), dv2 = dv_builder(this->m_v2, c2, min2);
+        // Accumulate all the term-by-term multiplications whose dense index is in the [a,b[ range.
+        auto slab_consume = [&dv1, &dv2, &acc, &acc_fma](const std::size_t &a, const std::size_t &b) {
+            auto off_cmp = [](const typename dv_type::value_type &p, const std::size_t &n) { return p.first < n; };
+            for (const auto &p1 : dv1) {
+                // dv1 is sorted, so all the next terms will write past the slab.
+                if (p1.first >= b) {
+                    break;
+                }
+                const auto lo = static_cast<std::size_t>(a > p1.first ? a - p1.first : 0u);
+                const auto hi = static_cast<std::size_t>(b - p1.first);
+                auto it = std::lower_bound(dv2.begin(), dv2.end(), lo, off_cmp);
+                const auto it_end = std::lower_bound(it, dv2.end(), hi, off_cmp);
+                const auto &cf1 = p1.second;
+                const auto acc_ptr = acc.data() + p1.first;
+                for (; it != it_end; ++it) {
+                    acc_fma(acc_ptr[it->first], cf1, it->second);
+                }
+            }
+        };
+        if (this->m_n_threads == 1u) {
+            slab_consume(0u, dsize);
+        } else {
+            // NOTE: the number of slabs per thread is a tuning parameter.
+            const unsigned spt = 10u;
+            const std::size_t n_slabs = static_cast<std::size_t>(this->m_n_threads) * spt;
+            const std::size_t slab_size = dsize / n_slabs + 1u;
+            std::atomic<std::size_t> next_slab(0u);
+            auto thread_func = [&next_slab, n_slabs, slab_size, dsize, &slab_consume]() {
+                for (auto i = next_slab++; i < n_slabs; i = next_slab++) {
+                    const auto a = std::min(i * slab_size, dsize), b = std::min(a + slab_size, dsize);
+                    slab_consume(a, b);
+                }
+            };
+            future_list<decltype(thread_func())> ft_list;
+            try {
+                for (unsigned i = 0u; i < this->m_n_threads; ++i) {
+                    ft_list.push_back(thread_pool::enqueue(i, thread_func));
+                }
+                // First let's wait for everything to finish.
+                ft_list.wait_all();
+                // Then, let's handle the exceptions.
+                ft_list.get_all();
+            } catch (...) {
+                ft_list.wait_all();
+                throw;
+            }
+        }
+    }
+    // Build the result of the dense multiplication from the nonzero elements of the accumulator, as determined
+    // by the functor is_zero(index). The coefficient of the term at a given index is written by the functor
+    // move(cf, index).
+    template <typename Z, typename M>
+    Series dense_kronecker_build(const std::size_t &dsize, const std::vector<std::size_t> &weights, const Z &is_zero,
+                                 const M &move) const
+    {
+        using term_type = typename Series::term_type;
+        using int_type = typename term_type::key_type::value_type;
+        using ka = kronecker_array<int_type>;
+        using bucket_size_type = typename base::bucket_size_type;
+        const auto &args = this->m_ss;
+        const auto n_vars = weights.size();
+        piranha_assert(n_vars == args.size() && n_vars == m_minmax1.size());
+        // Kronecker codes of the unit vectors and of the minimum exponents of the result. The codification is
+        // linear, so the code of a monomial in the box can be computed from its mixed-radix digits.
+        std::vector<int_type> tmp_v(n_vars, int_type(0)), strides;
+        for (decltype(tmp_v.size()) i = 0u; i < n_vars; ++i) {
+            tmp_v[i] = int_type(1);
+            strides.push_back(ka::encode(tmp_v));
+            tmp_v[i] = int_type(0);
+        }
+        for (decltype(tmp_v.size()) i = 0u; i < n_vars; ++i) {
+            tmp_v[i] = static_cast<int_type>(m_minmax1[i].first + m_minmax2[i].first);
+        }
+        const int_type base_code = ka::encode(tmp_v);
+        // Build the return value from the nonzero coefficients in the accumulator.
+        Series retval;
+        retval.set_symbol_set(args);
+        this->setup_node_arena(retval);
+        auto &container = retval._container();
+        try {
+            std::size_t count = 0u;
+            for (std::size_t d = 0u; d < dsize; ++d) {
+                count += static_cast<std::size_t>(!is_zero(d));
+            }
+            container.rehash(boost::numeric_cast<bucket_size_type>(
+                std::ceil(static_cast<double>(count) / container.max_load_factor())));
+            term_type tmp_term;
+            for (std::size_t d = 0u; d < dsize; ++d) {
+                if (is_zero(d)) {
+                    continue;
+                }
+                int_type code = base_code;
+                std::size_t rem = d;
+                for (auto i = n_vars; i > 0u; --i) {
+                    code = static_cast<int_type>(code + static_cast<int_type>(rem / weights[i - 1u]) * strides[i - 1u]);
+                    rem %= weights[i - 1u];
+                }
+                move(tmp_term.m_cf, d);
+                tmp_term.m_key.set_int(code);
+                const auto bucket_idx = container._bucket(tmp_term);
+                container._unique_insert(std::move(tmp_term), bucket_idx);
+            }
+            container._update_size(piranha::safe_cast<bucket_size_type>(count));
+            this->finalise_series(retval);
+        } catch (...) {
+            container.clear();
+            throw;
+        }
         return retval;
     }
+    // Insert the new term tmp_term into the bucket bucket_idx of container. If the coefficient type
+    // is recyclable, tmp_term is moved into the container and its coefficient is refilled from the
+    // thread-local pool of coefficients, otherwise tmp_term is copied so that the resources allocated
+    // in its coefficient can be reused for the next term.
+    template <typename Container, typename Term,
+              enable_if_t<detail::is_recyclable_cf<typename Term::cf_type>::value, int> = 0>
+    static void insert_new_term(Container &container, Term &tmp_term, const typename Container::size_type &bucket_idx)
+    {
+        container._unique_insert(std::move(tmp_term), bucket_idx);
+        detail::cf_recycler<typename Term::cf_type>::refill(tmp_term.m_cf);
+    }
+    template <typename Container, typename Term,
+              enable_if_t<!detail::is_recyclable_cf<typename Term::cf_type>::value, int> = 0>
+    static void insert_new_term(Container &container, Term &tmp_term, const typename Container::size_type &bucket_idx)
+    {
+        container._unique_insert(tmp_term, bucket_idx);
+    }
     void sparse_kronecker_multiplication(Series &retval) const
     {
         using bucket_size_type = typename base::bucket_size_type;
@@ -1690,6 +2778,35 @@ private:
         auto term_cmp = [&r_bucket](term_type const *p1, term_type const *p2) { return r_bucket(p1) < r_bucket(p2); };
         std::stable_sort(v1.begin(), v1.end(), term_cmp);
         std::stable_sort(v2.begin(), v2.end(), term_cmp);
+        // Packed copies of the sorted operands: the multiplication loop will stream over
+        // contiguous arrays of codes instead of dereferencing the term pointers. The coefficients
+        // are referred to via pointers, and they are not copied.
+        // NOTE: this will have to be adapted for kd_monomial.
+        auto key_packer = [](const typename term_type::key_type &k) { return k.get_int(); };
+        const auto p1 = this->pack_terms(v1, key_packer), p2 = this->pack_terms(v2, key_packer);
+        // Small-integer fast path: if the coefficients fit in machine words (see word_cfs()), the products
+        // are accumulated in 128-bit integers. Each thread appends the accumulators of the terms it inserts
+        // into retval to its own vector, and the coefficient of the inserted term stores the index of the
+        // accumulator, with the thread index in the lowest t_bits bits. All the products contributing to a term
+        // are computed by the thread which consumes the zone of the term, thus each vector is accessed by one
+        // thread only. The accumulators are moved into the coefficients by sparse_acc_finalise().
+        bool small = false;
+        unsigned t_bits = 0u;
+        std::vector<long long> w1, w2;
+        std::vector<std::vector<sparse_acc_type>> accs;
+#if defined(PIRANHA_HAVE_GCC_INT128)
+        while ((1ull << t_bits) < this->m_n_threads) {
+            ++t_bits;
+        }
+        // NOTE: the fast path is not used if retval already contains terms (see kronecker_multiply_accumulate()),
+        // as their coefficients are not accumulator indices. The indices of the accumulators must be
+        // representable as nonnegative machine words.
+        small = container.size() == 0u && word_cfs(v1, v2, w1, w2)
+                && integer(size1) * size2 < (integer(1) << (62u - t_bits));
+        if (small) {
+            accs.resize(this->m_n_threads);
+        }
+#endif
         // Task comparator. It will compare the bucket index of the terms resulting from
         // the multiplication of the term in the first series by the first term in the block
         // of the second series. This is essentially the first bucket index of retval in which the task
@@ -1700,8 +2817,9 @@ private:
             return r_bucket(v1[std::get<0u>(t1)]) + r_bucket(v2[std::get<1u>(t1)])
                    < r_bucket(v1[std::get<0u>(t2)]) + r_bucket(v2[std::get<1u>(t2)]);
         };
-        // Task block size.
-        const size_type block_size = piranha::safe_cast<size_type>(tuning::get_multiplication_block_size());
+        // Task block size. The tasks read contiguously the packed copy of the second series.
+        const std::size_t packed_fp = sizeof(p2.m_keys[0]) + sizeof(p2.m_cfs[0]);
+        const size_type block_size = this->tile_sizes(packed_fp, packed_fp).second;
         // Task splitter: split a task in block_size sized tasks and append them to out.
         auto task_split = [block_size](const task_type &t, std::vector<task_type> &out) {
             size_type start = std::get<1u>(t), end = std::get<2u>(t);
@@ -1716,42 +2834,83 @@ private:
         // End of the container, always the same value.
         const auto it_end = container.end();
         // Function to perform all the term-by-term multiplications in a task, using tmp_term
-        // as a temporary value for the computation of the result.
-        auto task_consume = [&v1, &v2, &container, it_end, this](const task_type &task, term_type &tmp_term) {
-            // Get the term in the first series.
-            auto t1 = v1[std::get<0u>(task)];
-            // Get pointers to the second series.
-            // NOTE: don't use the subscript operator[] here, as these could point
-            // one past the end of the vector.
-            auto start2 = v2.data() + std::get<1u>(task);
-            auto end2 = v2.data() + std::get<2u>(task);
-            // NOTE: these will have to be adapted for kd_monomial.
-            using int_type = decltype(t1->m_key.get_int());
-            // Get shortcuts to cf and key in t1.
-            const auto &cf1 = t1->m_cf;
-            const int_type key1 = t1->m_key.get_int();
-            // Iterate over the task.
-            for (; start2 != end2; ++start2) {
-                // Const ref to the current term in the second series.
-                const auto &cur = **start2;
-                // Add the keys.
+        // as a temporary value for the computation of the result. The products are processed in batches:
+        // first the codes and the destination buckets of all the products in the batch are computed and the
+        // buckets are prefetched, then the products are located in retval and accumulated. This way the
+        // memory accesses into retval for a batch are in flight at the same time. The batch size is the
+        // prefetch distance from the tuning settings (a zero distance disables the prefetching).
+        const auto prefetch_distance = tuning::get_prefetch_distance();
+        const auto batch_size = static_cast<size_type>(prefetch_distance ? prefetch_distance : 1u);
+        auto task_consume = [&p1, &p2, &container, it_end, this, prefetch_distance, batch_size, small, &w1, &w2,
+                             &accs, t_bits](const task_type &task, term_type &tmp_term, const unsigned &thread_idx) {
+            using int_type = typename decltype(p1.m_keys)::value_type;
+            // Get shortcuts to cf and key of the term in the first series.
+            const auto &cf1 = *p1.m_cfs[std::get<0u>(task)];
+            const int_type key1 = p1.m_keys[std::get<0u>(task)];
+            // Codes and destination buckets of the products in the current batch.
+            std::array<int_type, tuning::get_max_prefetch_distance()> b_keys;
+            std::array<bucket_size_type, tuning::get_max_prefetch_distance()> b_idx;
+            piranha_assert(batch_size <= b_keys.size());
+            const auto end2 = std::get<2u>(task);
+            for (auto start2 = std::get<1u>(task); start2 != end2;) {
+                const auto n = std::min(static_cast<size_type>(end2 - start2), batch_size);
+                // Pointers to the keys and coefficients of the second series in the batch.
+                const auto key2 = p2.m_keys.data() + start2;
+                const auto cf2 = p2.m_cfs.data() + start2;
+                // Add the keys. This loop operates on contiguous arrays and it can be vectorised.
                 // NOTE: this will have to be adapted for kd_monomial.
-                tmp_term.m_key.set_int(static_cast<int_type>(key1 + cur.m_key.get_int()));
-                // Try to locate the term into retval.
-                auto bucket_idx = container._bucket(tmp_term);
-                const auto it = container._find(tmp_term, bucket_idx);
-                if (it == it_end) {
-                    // NOTE: for coefficient series, we might want to insert with move() below,
-                    // as we are not going to re-use the allocated resources in tmp.m_cf.
-                    // Take care of multiplying the coefficient.
-                    cf_mult_impl(tmp_term.m_cf, cf1, cur.m_cf);
-                    container._unique_insert(tmp_term, bucket_idx);
-                } else {
-                    // NOTE: here we need to decide if we want to give the same treatment to fmp as we did with
-                    // cf_mult_impl.
-                    // For the moment it is an implementation detail of this class.
-                    this->fma_wrap(it->m_cf, cf1, cur.m_cf);
+                for (size_type i = 0u; i < n; ++i) {
+                    b_keys[i] = static_cast<int_type>(key1 + key2[i]);
                 }
+                // Compute the destination buckets and prefetch them.
+                for (size_type i = 0u; i < n; ++i) {
+                    tmp_term.m_key.set_int(b_keys[i]);
+                    b_idx[i] = container._bucket(tmp_term);
+                    if (prefetch_distance) {
+                        container._prefetch_bucket(b_idx[i]);
+                    }
+                }
+                // Locate the terms into retval and accumulate.
+                for (size_type i = 0u; i < n; ++i) {
+                    tmp_term.m_key.set_int(b_keys[i]);
+                    const auto it = container._find(tmp_term, b_idx[i]);
+#if defined(PIRANHA_HAVE_GCC_INT128)
+                    if (small) {
+                        const auto prod = static_cast<detail::int128_t>(w1[std::get<0u>(task)]) * w2[start2 + i];
+                        auto &acc = accs[thread_idx];
+                        if (it == it_end) {
+                            int128_to_cf(tmp_term.m_cf, static_cast<long long>((acc.size() << t_bits) | thread_idx));
+                            acc.push_back(prod);
+                            container._unique_insert(tmp_term, b_idx[i]);
+                        } else {
+                            piranha_assert(static_cast<unsigned>(sparse_acc_idx(it->m_cf) & ((1ll << t_bits) - 1))
+                                       == thread_idx);
+                            acc[static_cast<std::size_t>(sparse_acc_idx(it->m_cf) >> t_bits)] += prod;
+                        }
+                        continue;
+                    }
+#else
+                    (void)small;
+                    (void)w1;
+                    (void)w2;
+                    (void)accs;
+                    (void)t_bits;
+                    (void)thread_idx;
+#endif
+                    if (it == it_end) {
+                        // NOTE: for coefficient series, we might want to insert with move() below,
+                        // as we are not going to re-use the allocated resources in tmp.m_cf.
+                        // Take care of multiplying the coefficient.
+                        cf_mult_impl(tmp_term.m_cf, cf1, *cf2[i]);
+                        insert_new_term(container, tmp_term, b_idx[i]);
+                    } else {
+                        // NOTE: here we need to decide if we want to give the same treatment to fmp as we did with
+                        // cf_mult_impl.
+                        // For the moment it is an implementation detail of this class.
+                        this->fma_wrap(it->m_cf, cf1, *cf2[i]);
+                    }
+                }
+                start2 = static_cast<size_type>(start2 + n);
             }
         };
         if (this->m_n_threads == 1u) {
@@ -1767,8 +2926,13 @@ private:
                 // Iterate over the tasks and run the multiplication.
                 term_type tmp_term;
                 for (const auto &t : tasks) {
-                    task_consume(t, tmp_term);
+                    task_consume(t, tmp_term, 0u);
+                }
+#if defined(PIRANHA_HAVE_GCC_INT128)
+                if (small) {
+                    sparse_acc_finalise(retval, accs, t_bits);
                 }
+#endif
                 this->sanitise_series(retval, this->m_n_threads);
                 this->finalise_series(retval);
             } catch (...) {
@@ -1784,11 +2948,20 @@ private:
         // NOTE: zm is a tuning parameter.
         const unsigned zm = 10u;
         const bucket_size_type n_zones = static_cast<bucket_size_type>(integer(this->m_n_threads) * zm);
-        // Number of buckets per zone (can be zero).
-        const bucket_size_type bpz = static_cast<bucket_size_type>(bucket_count / n_zones);
-        // For each zone, we need to define a vector of tasks that will write only into that zone.
-        std::vector<std::vector<task_type>> task_table;
-        task_table.resize(piranha::safe_cast<decltype(task_table.size())>(n_zones));
+        // A zone of the output container, that is, a range of buckets [a,b[ in retval together
+        // with the tasks that write only into that range. The cost of the zone is the total number
+        // of term-by-term multiplications in its tasks.
+        struct zone_type {
+            bucket_size_type a;
+            bucket_size_type b;
+            integer cost;
+            std::vector<task_type> tasks;
+        };
+        // Maximum cost of a zone: zones costing more than zs times the average cost will be split
+        // in halves (along the bucket range) until they become cheaper or they consist of a single bucket.
+        // NOTE: zs is a tuning parameter.
+        const unsigned zs = 2u;
+        const integer max_cost = (integer(size1) * size2 * zs) / n_zones;
         // Lower bound implementation. Adapted from:
         // http://en.cppreference.com/w/cpp/algorithm/lower_bound
         // Given the [first,last[ index range in v2, find the first index idx in the v2 range such that the i-th
@@ -1821,45 +2994,79 @@ private:
             }
             return first;
         };
+        // Compute the tasks and the cost of the zone z, given its bucket range.
+        auto zone_filler = [bucket_count, size1, size2, &l_bound, &task_split, &task_cmp](zone_type &z) {
+            const auto a = z.a, b = z.b;
+            z.tasks.clear();
+            z.cost = 0;
+            // First batch of tasks.
+            for (size_type i = 0u; i < size1; ++i) {
+                auto t = std::make_tuple(i, l_bound(0u, size2, a, i), l_bound(0u, size2, b, i));
+                if (std::get<1u>(t) == 0u && std::get<2u>(t) == 0u) {
+                    // This means that all the next tasks we will compute will be empty,
+                    // no sense in calculating them.
+                    break;
+                }
+                z.cost += std::get<2u>(t) - std::get<1u>(t);
+                task_split(t, z.tasks);
+            }
+            // Second batch of tasks.
+            // Note: we can always compute a,b + bucket_count because of the limits on the maximum value of
+            // bucket_count.
+            for (size_type i = 0u; i < size1; ++i) {
+                auto t = std::make_tuple(i, l_bound(0u, size2, static_cast<bucket_size_type>(a + bucket_count), i),
+                                         l_bound(0u, size2, static_cast<bucket_size_type>(b + bucket_count), i));
+                if (std::get<1u>(t) == 0u && std::get<2u>(t) == 0u) {
+                    break;
+                }
+                z.cost += std::get<2u>(t) - std::get<1u>(t);
+                task_split(t, z.tasks);
+            }
+            // Sort the task vector.
+            std::stable_sort(z.tasks.begin(), z.tasks.end(), task_cmp);
+        };
+        // The zones filled by each thread. Each thread fills zm contiguous zones, splitting the expensive ones.
+        // The zones of a thread cover the range of buckets assigned to the thread by detail::thread_partition(),
+        // which is the same range of buckets the thread initialised when rehashing retval in parallel
+        // (see tuning::get_parallel_memory_set()). This way, the buckets of the zones owned by a thread
+        // are allocated in its NUMA node.
+        std::vector<std::vector<zone_type>> thread_zones;
+        thread_zones.resize(piranha::safe_cast<decltype(thread_zones.size())>(this->m_n_threads));
         // Fill the task table.
-        auto table_filler = [&task_table, bpz, this, bucket_count, size1, size2, &l_bound, &task_split,
-                             &task_cmp](const unsigned &thread_idx) {
+        auto table_filler = [&thread_zones, this, bucket_count, &max_cost, &zone_filler](const unsigned &thread_idx) {
+            auto &out = thread_zones[static_cast<decltype(thread_zones.size())>(thread_idx)];
+            // The range of buckets of the thread, and the number of buckets per zone (can be zero).
+            const auto t_range = detail::thread_partition(bucket_count, this->m_n_threads, thread_idx);
+            const bucket_size_type bpz = static_cast<bucket_size_type>((t_range.second - t_range.first) / zm);
+            // Stack of the bucket ranges still to be processed.
+            std::vector<std::pair<bucket_size_type, bucket_size_type>> pending;
             for (unsigned n = 0u; n < zm; ++n) {
-                std::vector<task_type> cur_tasks;
                 // [a,b[ is the container zone.
-                bucket_size_type a = static_cast<bucket_size_type>(thread_idx * bpz * zm + n * bpz);
+                bucket_size_type a = static_cast<bucket_size_type>(t_range.first + n * bpz);
                 bucket_size_type b;
-                if (n == zm - 1u && thread_idx == this->m_n_threads - 1u) {
-                    // Special casing if this is the last zone in the container.
-                    b = bucket_count;
+                if (n == zm - 1u) {
+                    // Special casing if this is the last zone of the thread.
+                    b = t_range.second;
                 } else {
                     b = static_cast<bucket_size_type>(a + bpz);
                 }
-                // First batch of tasks.
-                for (size_type i = 0u; i < size1; ++i) {
-                    auto t = std::make_tuple(i, l_bound(0u, size2, a, i), l_bound(0u, size2, b, i));
-                    if (std::get<1u>(t) == 0u && std::get<2u>(t) == 0u) {
-                        // This means that all the next tasks we will compute will be empty,
-                        // no sense in calculating them.
-                        break;
-                    }
-                    task_split(t, cur_tasks);
-                }
-                // Second batch of tasks.
-                // Note: we can always compute a,b + bucket_count because of the limits on the maximum value of
-                // bucket_count.
-                for (size_type i = 0u; i < size1; ++i) {
-                    auto t = std::make_tuple(i, l_bound(0u, size2, static_cast<bucket_size_type>(a + bucket_count), i),
-                                             l_bound(0u, size2, static_cast<bucket_size_type>(b + bucket_count), i));
-                    if (std::get<1u>(t) == 0u && std::get<2u>(t) == 0u) {
-                        break;
+                pending.emplace_back(a, b);
+                while (!pending.empty()) {
+                    zone_type z;
+                    z.a = pending.back().first;
+                    z.b = pending.back().second;
+                    pending.pop_back();
+                    zone_filler(z);
+                    if (z.cost > max_cost && z.b - z.a > 1u) {
+                        // The zone is too expensive: split it in two halves. The second half
+                        // is pushed first so that the zones are emitted in bucket order.
+                        const auto mid = static_cast<bucket_size_type>(z.a + (z.b - z.a) / 2u);
+                        pending.emplace_back(mid, z.b);
+                        pending.emplace_back(z.a, mid);
+                        continue;
                     }
-                    task_split(t, cur_tasks);
+                    out.push_back(std::move(z));
                 }
-                // Sort the task vector.
-                std::stable_sort(cur_tasks.begin(), cur_tasks.end(), task_cmp);
-                // Move the vector of tasks in the table.
-                task_table[static_cast<decltype(task_table.size())>(thread_idx * zm + n)] = std::move(cur_tasks);
             }
         };
         // Go with the threads to fill the task table.
@@ -1876,70 +3083,92 @@ private:
             ff_list.wait_all();
             throw;
         }
+        // Flatten the zones into the task table. The zones filled by the i-th thread
+        // will be in the [zone_offsets[i],zone_offsets[i + 1][ range of the table.
+        std::vector<zone_type> task_table;
+        std::vector<std::size_t> zone_offsets(1u, 0u);
+        for (auto &v : thread_zones) {
+            std::move(v.begin(), v.end(), std::back_inserter(task_table));
+            zone_offsets.push_back(piranha::safe_cast<std::size_t>(task_table.size()));
+            v.clear();
+        }
         // Check the consistency of the table for debug purposes.
-        auto table_checker = [&task_table, size1, size2, &r_bucket, bpz, bucket_count, &v1, &v2]() -> bool {
+        auto table_checker = [&task_table, size1, size2, &r_bucket, bucket_count, &p1, &p2]() -> bool {
             // Total number of term-by-term multiplications. Needs to be equal
             // to size1 * size2 at the end.
             integer tot_n(0);
             // Tmp term for multiplications.
             term_type tmp_term;
-            for (decltype(task_table.size()) i = 0u; i < task_table.size(); ++i) {
-                const auto &v = task_table[i];
+            // The zones must cover the container contiguously.
+            bucket_size_type prev_b = 0u;
+            for (const auto &z : task_table) {
                 // Bucket limits of each zone.
-                bucket_size_type a = static_cast<bucket_size_type>(bpz * i), b;
-                // Special casing for the last zone in the table.
-                if (i == task_table.size() - 1u) {
-                    b = bucket_count;
-                } else {
-                    b = static_cast<bucket_size_type>(a + bpz);
+                const bucket_size_type a = z.a, b = z.b;
+                if (a != prev_b || b < a) {
+                    return false;
                 }
-                for (const auto &t : v) {
+                prev_b = b;
+                integer z_cost(0);
+                for (const auto &t : z.tasks) {
                     auto idx1 = std::get<0u>(t), start2 = std::get<1u>(t), end2 = std::get<2u>(t);
-                    using int_type = decltype(v1[idx1]->m_key.get_int());
+                    using int_type = typename decltype(p1.m_keys)::value_type;
                     piranha_assert(start2 <= end2);
                     tot_n += end2 - start2;
+                    z_cost += end2 - start2;
                     for (; start2 != end2; ++start2) {
-                        tmp_term.m_key.set_int(
-                            static_cast<int_type>(v1[idx1]->m_key.get_int() + v2[start2]->m_key.get_int()));
+                        tmp_term.m_key.set_int(static_cast<int_type>(p1.m_keys[idx1] + p2.m_keys[start2]));
                         auto b_idx = r_bucket(&tmp_term);
                         if (b_idx < a || b_idx >= b) {
                             return false;
                         }
                     }
                 }
+                if (z_cost != z.cost) {
+                    return false;
+                }
             }
-            return tot_n == integer(size1) * size2;
+            return prev_b == bucket_count && tot_n == integer(size1) * size2;
         };
         (void)table_checker;
         piranha_assert(table_checker());
+        // Zone comparator: more expensive zones come first.
+        auto zone_cmp = [&task_table](const std::size_t &i1, const std::size_t &i2) {
+            return task_table[i1].cost > task_table[i2].cost;
+        };
+        // The order in which the idle threads will steal zones from the other threads: most expensive first,
+        // so that the cheap zones are left for the end of the computation.
+        std::vector<std::size_t> steal_order(
+            piranha::safe_cast<std::vector<std::size_t>::size_type>(task_table.size()));
+        std::iota(steal_order.begin(), steal_order.end(), std::size_t(0u));
+        std::stable_sort(steal_order.begin(), steal_order.end(), zone_cmp);
         // Init the vector of atomic flags.
         detail::atomic_flag_array af(piranha::safe_cast<std::size_t>(task_table.size()));
         // Thread functor.
-        auto thread_functor = [&task_table, &af, &task_consume](const unsigned &thread_idx) {
-            using t_size_type = decltype(task_table.size());
+        auto thread_functor = [&task_table, &zone_offsets, &steal_order, &zone_cmp, &af,
+                               &task_consume](const unsigned &thread_idx) {
             // Temporary term_type for caching.
             term_type tmp_term;
-            // The starting index in the task table.
-            auto t_idx = static_cast<t_size_type>(t_size_type(thread_idx) * zm);
-            const auto start_t_idx = t_idx;
-            while (true) {
-                // If this returns false, it means that the tasks still need to be consumed;
-                if (!af[static_cast<std::size_t>(t_idx)].test_and_set()) {
-                    // Current vector of tasks.
-                    const auto &cur_tasks = task_table[t_idx];
-                    for (const auto &t : cur_tasks) {
-                        task_consume(t, tmp_term);
+            // Consume the zone at index idx, if no other thread claimed it yet.
+            auto zone_consume = [&task_table, &af, &task_consume, &tmp_term, thread_idx](const std::size_t &idx) {
+                // If this returns false, it means that the tasks still need to be consumed.
+                if (!af[idx].test_and_set()) {
+                    for (const auto &t : task_table[idx].tasks) {
+                        task_consume(t, tmp_term, thread_idx);
                     }
                 }
-                // Update the index, wrapping around if necessary.
-                t_idx = static_cast<t_size_type>(t_idx + 1u);
-                if (t_idx == task_table.size()) {
-                    t_idx = 0u;
-                }
-                // If we got back to the original index, get out.
-                if (t_idx == start_t_idx) {
-                    break;
-                }
+            };
+            // The local queue of this thread: the zones it filled, most expensive first.
+            std::vector<std::size_t> local(static_cast<std::vector<std::size_t>::size_type>(
+                zone_offsets[static_cast<std::vector<std::size_t>::size_type>(thread_idx + 1u)]
+                - zone_offsets[thread_idx]));
+            std::iota(local.begin(), local.end(), zone_offsets[thread_idx]);
+            std::stable_sort(local.begin(), local.end(), zone_cmp);
+            for (const auto &idx : local) {
+                zone_consume(idx);
+            }
+            // When the local queue is exhausted, steal the remaining zones from the other threads.
+            for (const auto &idx : steal_order) {
+                zone_consume(idx);
             }
         };
         // Go with the multiplication threads.
@@ -1952,6 +3181,11 @@ private:
             ft_list.wait_all();
             // Then, let's handle the exceptions.
             ft_list.get_all();
+#if defined(PIRANHA_HAVE_GCC_INT128)
+            if (small) {
+                sparse_acc_finalise(retval, accs, t_bits);
+            }
+#endif
             // Finally, fix and finalise the series.
             this->sanitise_series(retval, this->m_n_threads);
             this->finalise_series(retval);
@@ -1962,6 +3196,11 @@ private:
             throw;
         }
     }
+
+private:
+    // Per-variable exponent bounds of the operands, computed by check_bounds() for Kronecker monomials.
+    std::vector<std::pair<integer, integer>> m_minmax1;
+    std::vector<std::pair<integer, integer>> m_minmax2;
 };
 }
 
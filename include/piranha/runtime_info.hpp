@@ -71,6 +71,7 @@ extern "C" {
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <piranha/config.hpp>
 #include <piranha/detail/init.hpp>
@@ -215,6 +216,159 @@ public:
         return 0u;
 #endif
     }
+    /// Size of the data cache.
+    /**
+     * This method will return the size of the data cache (or of the unified cache, if the cache at the requested level
+     * holds both data and instructions) of level \p level. The detection is currently implemented only on Linux and
+     * OSX, and only for the first three cache levels.
+     *
+     * @param level the cache level (e.g., 1 for the L1 cache).
+     *
+     * @return the size of the data cache of level \p level (in bytes), or 0 if the value cannot be determined.
+     */
+    static unsigned long get_cache_size(unsigned level)
+    {
+#if defined(__linux__)
+        long cs = 0;
+        switch (level) {
+            case 1u:
+                cs = ::sysconf(_SC_LEVEL1_DCACHE_SIZE);
+                break;
+            case 2u:
+                cs = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+                break;
+            case 3u:
+                cs = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+                break;
+            default:
+                return 0u;
+        }
+        // As above, this can fail on some systems: try reading the /sys entries, looking for a non-instruction
+        // cache of the requested level. The size is reported in KB, e.g., "32K".
+        if (cs <= 0) {
+            cs = 0;
+            for (unsigned idx = 0u; idx < 10u && !cs; ++idx) {
+                const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(idx) + "/";
+                std::ifstream level_file(dir + "level"), type_file(dir + "type"), size_file(dir + "size");
+                if (!level_file.good() || !type_file.good() || !size_file.good()) {
+                    break;
+                }
+                try {
+                    std::string level_str, type_str, size_str;
+                    std::getline(level_file, level_str);
+                    std::getline(type_file, type_str);
+                    std::getline(size_file, size_str);
+                    if (boost::lexical_cast<unsigned>(level_str) != level || type_str == "Instruction"
+                        || size_str.empty() || size_str.back() != 'K') {
+                        continue;
+                    }
+                    size_str.pop_back();
+                    cs = boost::lexical_cast<long>(size_str) * 1024l;
+                } catch (...) {
+                    cs = 0;
+                }
+            }
+        }
+        if (cs > 0) {
+            unsigned long retval = 0u;
+            try {
+                retval = piranha::safe_cast<unsigned long>(cs);
+            } catch (...) {
+            }
+            return retval;
+        }
+        return 0u;
+#elif defined(__APPLE_CC__)
+        const char *name;
+        switch (level) {
+            case 1u:
+                name = "hw.l1dcachesize";
+                break;
+            case 2u:
+                name = "hw.l2cachesize";
+                break;
+            case 3u:
+                name = "hw.l3cachesize";
+                break;
+            default:
+                return 0u;
+        }
+        std::uint64_t cs;
+        std::size_t size = sizeof(cs);
+        try {
+            return ::sysctlbyname(name, &cs, &size, NULL, 0) ? 0u : piranha::safe_cast<unsigned long>(cs);
+        } catch (...) {
+            return 0u;
+        }
+#else
+        (void)level;
+        return 0u;
+#endif
+    }
+    /// Processors in NUMA order.
+    /**
+     * This method will return a permutation of the indices of the processors, from 0 to
+     * get_hardware_concurrency() (excluded), in which the processors are grouped by NUMA node: first all the
+     * processors of the first node, then all the processors of the second node, etc. The detection of the NUMA
+     * topology is currently implemented only on Linux. If the topology cannot be determined, the processors are
+     * returned in their natural order.
+     *
+     * @return the indices of the processors grouped by NUMA node, or an empty vector if
+     * get_hardware_concurrency() returns 0.
+     *
+     * @throws std::bad_alloc in case of memory allocation errors.
+     */
+    static std::vector<unsigned> get_numa_proc_order()
+    {
+        const auto hc = get_hardware_concurrency();
+        std::vector<unsigned> retval;
+#if defined(__linux__)
+        // Read the list of the processors of each node from the /sys entries. The format of the list
+        // is a comma-separated list of indices and ranges of indices, e.g., "0-7,16-23".
+        try {
+            std::vector<bool> seen(hc, false);
+            for (unsigned node = 0u;; ++node) {
+                std::ifstream cpulist_file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                if (!cpulist_file.good()) {
+                    break;
+                }
+                std::string line;
+                std::getline(cpulist_file, line);
+                std::string::size_type pos = 0u;
+                while (pos < line.size()) {
+                    auto comma = line.find(',', pos);
+                    if (comma == std::string::npos) {
+                        comma = line.size();
+                    }
+                    const auto item = line.substr(pos, comma - pos);
+                    pos = comma + 1u;
+                    const auto dash = item.find('-');
+                    const auto first = boost::lexical_cast<unsigned>(item.substr(0u, dash)),
+                               last = dash == std::string::npos ? first
+                                                                : boost::lexical_cast<unsigned>(item.substr(dash + 1u));
+                    for (auto cpu = first; cpu <= last && cpu < hc; ++cpu) {
+                        if (!seen[cpu]) {
+                            seen[cpu] = true;
+                            retval.push_back(cpu);
+                        }
+                    }
+                }
+            }
+        } catch (...) {
+            retval.clear();
+        }
+        // The topology must cover all the processors.
+        if (retval.size() != hc) {
+            retval.clear();
+        }
+#endif
+        if (retval.empty()) {
+            for (unsigned i = 0u; i < hc; ++i) {
+                retval.push_back(i);
+            }
+        }
+        return retval;
+    }
 };
 }
 
@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filtering_streambuf.hpp>
@@ -57,10 +58,15 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 #include <vector>
 
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
 #include <piranha/config.hpp>
 #include <piranha/convert_to.hpp>
 #include <piranha/detail/debug_access.hpp>
+#include <piranha/detail/evaluation_plan.hpp>
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/pow_cache.hpp>
 #include <piranha/detail/series_fwd.hpp>
 #include <piranha/detail/sfinae_types.hpp>
 #include <piranha/exceptions.hpp>
@@ -83,6 +89,8 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/term.hpp>
+#include <piranha/thread_pool.hpp>
+#include <piranha/tuning.hpp>
 #include <piranha/type_traits.hpp>
 
 namespace piranha
@@ -734,7 +742,116 @@ class series_operators
         = decltype(dispatch_in_place_sub(std::declval<T &>(), std::declval<const typename std::decay<U>::type &>()...));
     template <typename T, typename... U>
     using in_place_sub_enabler = typename std::enable_if<true_tt<in_place_sub_type<T, U...>>::value, int>::type;
+    // In-place transformation of the coefficients of the series s via the functor f, followed by the removal of the
+    // terms which became zero. The keys are not touched, hence the table does not need to be rebuilt. The
+    // transformation is parallelised over ranges of buckets, the removal of the zero terms is done in a single
+    // final pass, and only if needed. In case of errors, s is cleared.
+    template <typename T, typename F>
+    static void in_place_cf_transform(T &s, const F &f)
+    {
+        using bucket_size_type = typename T::container_type::size_type;
+        auto &cont = s.m_container;
+        const unsigned n_threads = cont.size() ? thread_pool::use_threads(
+                                                     integer(cont.size()), integer(settings::get_min_work_per_thread()))
+                                               : 1u;
+        const bucket_size_type b_count = cont.bucket_count(), bpt = b_count / n_threads;
+        // Flags signalling the presence of zero terms after the transformation, one per thread.
+        std::vector<char> zero_flags(n_threads, 0);
+        auto worker = [&cont, &s, &f, &zero_flags, n_threads, b_count, bpt](unsigned t_idx) {
+            const auto start = static_cast<bucket_size_type>(bpt * t_idx);
+            const auto end
+                = t_idx == n_threads - 1u ? b_count : static_cast<bucket_size_type>(bpt * (t_idx + 1u));
+            for (auto i = start; i != end; ++i) {
+                const auto &bl = cont._get_bucket_list(i);
+                for (auto it = bl.begin(); it != bl.end(); ++it) {
+                    // NOTE: the coefficient is a mutable member of the term, and
+                    // each bucket is accessed by a single thread.
+                    f(it->m_cf);
+                    // NOTE: no need to check for compatibility, as it depends only on the key type and here
+                    // we are only acting on the coefficient.
+                    if (unlikely(it->is_zero(s.m_symbol_set))) {
+                        zero_flags[t_idx] = 1;
+                    }
+                }
+            }
+        };
+        try {
+            if (n_threads == 1u) {
+                worker(0u);
+            } else {
+                future_list<void> f_list;
+                try {
+                    for (unsigned i = 0u; i < n_threads; ++i) {
+                        f_list.push_back(thread_pool::enqueue(i, worker, i));
+                    }
+                    // First let's wait for everything to finish.
+                    f_list.wait_all();
+                    // Then, let's handle the exceptions.
+                    f_list.get_all();
+                } catch (...) {
+                    f_list.wait_all();
+                    throw;
+                }
+            }
+            // Compaction pass.
+            if (std::any_of(zero_flags.begin(), zero_flags.end(), [](char flag) { return flag != 0; })) {
+                const auto it_f = cont.end();
+                for (auto it = cont.begin(); it != it_f;) {
+                    if (it->is_zero(s.m_symbol_set)) {
+                        // Erase will return the next iterator.
+                        it = cont.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+        } catch (...) {
+            cont.clear();
+            throw;
+        }
+    }
     // Multiplication.
+    // Detect if the multiplication of a series of type T by an object of type U can be performed
+    // in-place on the coefficients of T: U must not be a series, and the coefficients of T must be multipliable
+    // in-place by U.
+    template <typename T, typename U>
+    using cf_in_place_mul = std::integral_constant<
+        bool, bso_type<T, U, 2>::value == 4u && !is_series<typename std::decay<U>::type>::value
+                  && is_multipliable_in_place<bso_cf_t<typename std::decay<T>::type>,
+                                              typename std::decay<U>::type>::value>;
+    // Detect if an automatic truncation is active for the series type T (e.g., the automatic degree truncation of
+    // polynomials). The series multiplier applies the truncation, whereas the in-place multiplication of the
+    // coefficients does not.
+    template <typename T>
+    static auto auto_truncation_active(int) -> decltype(std::get<0u>(T::get_auto_truncate_degree()) != 0, bool())
+    {
+        return std::get<0u>(T::get_auto_truncate_degree()) != 0;
+    }
+    template <typename T>
+    static bool auto_truncation_active(...)
+    {
+        return false;
+    }
+    // Multiply s by y via the series multiplier if an automatic truncation is active. Returns true if the
+    // multiplication was performed, false otherwise. If T cannot be constructed from y, the multiplication by y never
+    // goes through the series multiplier, and the in-place path is always used.
+    template <typename T, typename U,
+              typename std::enable_if<std::is_constructible<T, const U &>::value, int>::type = 0>
+    static bool truncated_scalar_mul(T &s, const U &y)
+    {
+        if (likely(!auto_truncation_active<T>(0))) {
+            return false;
+        }
+        T y1(y);
+        s = dispatch_binary_mul(std::move(s), std::move(y1));
+        return true;
+    }
+    template <typename T, typename U,
+              typename std::enable_if<!std::is_constructible<T, const U &>::value, int>::type = 0>
+    static bool truncated_scalar_mul(T &, const U &)
+    {
+        return false;
+    }
     struct binary_mul_impl {
         template <typename T, typename U>
         series_common_type<T, U, 2> operator()(T &&x, U &&y) const
@@ -751,7 +868,8 @@ class series_operators
         return series_merge_f(std::forward<T>(x), std::forward<U>(y), binary_mul_impl{});
     }
     template <typename T, typename U,
-              typename std::enable_if<(bso_type<T, U, 2>::value == 1u || bso_type<T, U, 2>::value == 4u)
+              typename std::enable_if<(bso_type<T, U, 2>::value == 1u
+                                       || (bso_type<T, U, 2>::value == 4u && !cf_in_place_mul<T, U>::value))
                                           && std::is_constructible<typename std::decay<T>::type,
                                                                    const typename std::decay<U>::type &>::value,
                                       int>::type
@@ -761,6 +879,50 @@ class series_operators
         typename std::decay<T>::type y1(std::forward<U>(y));
         return dispatch_binary_mul(std::forward<T>(x), std::move(y1));
     }
+    // Multiplication by a non-series object which results in the same series type: the multiplication by y
+    // does not change the keys, and it can be performed in-place on the coefficients of a copy of x. If an
+    // automatic truncation is active, we go instead through the series multiplier, which applies it.
+    template <typename T, typename U, typename std::enable_if<cf_in_place_mul<T, U>::value, int>::type = 0>
+    static series_common_type<T, U, 2> dispatch_binary_mul(T &&x, U &&y)
+    {
+        using ret_type = series_common_type<T, U, 2>;
+        static_assert(std::is_same<typename std::decay<T>::type, ret_type>::value, "Invalid type.");
+        using term_type = typename ret_type::term_type;
+        using cf_type = typename term_type::cf_type;
+        using key_type = typename term_type::key_type;
+        ret_type retval(std::forward<T>(x));
+        if (truncated_scalar_mul(retval, y)) {
+            return retval;
+        }
+        if (retval.empty()) {
+            // Special case: if x is empty, we insert a single term consisting of 0 * y. This mirrors
+            // the behaviour of the series multiplier when zero is not absorbing (e.g., 0 * inf gives NaN).
+            // NOTE: the insertion will discard the term if the coefficient is zero.
+            cf_type tmp(0);
+#if defined(PIRANHA_COMPILER_IS_GCC)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+            tmp *= y;
+#if defined(PIRANHA_COMPILER_IS_GCC)
+#pragma GCC diagnostic pop
+#endif
+            retval.insert(term_type{std::move(tmp), key_type{retval.get_symbol_set()}});
+            return retval;
+        }
+        // NOTE: x is not used any more.
+        in_place_cf_transform(retval, [&y](cf_type &c) {
+#if defined(PIRANHA_COMPILER_IS_GCC)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+            c *= y;
+#if defined(PIRANHA_COMPILER_IS_GCC)
+#pragma GCC diagnostic pop
+#endif
+        });
+        return retval;
+    }
     template <typename T, typename U, typename std::enable_if<bso_type<T, U, 2>::value == 2u, int>::type = 0>
     static auto dispatch_binary_mul(T &&x, U &&y)
         -> decltype(dispatch_binary_mul(std::forward<U>(y), std::forward<T>(x)))
@@ -906,37 +1068,24 @@ class series_operators
             return retval;
         }
         static_assert(std::is_same<typename std::decay<T>::type, ret_type>::value, "Invalid type.");
+        using cf_type = typename ret_type::term_type::cf_type;
         // Create a copy of x and work on it. This is always possible.
         ret_type retval(std::forward<T>(x));
-        // NOTE: x is not used any more.
-        const auto it_f = retval.m_container.end();
-        try {
-            for (auto it = retval.m_container.begin(); it != it_f;) {
+        // NOTE: x is not used any more. In case of errors (e.g., division by zero), retval is cleared
+        // and the exception re-thrown.
+        in_place_cf_transform(retval, [&y](cf_type &c) {
 #if defined(PIRANHA_COMPILER_IS_GCC)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #endif
-                // NOTE: here the original requirement is that cf / y is defined, but we know
-                // that cf / y results in another cf, and we assume always that cf /= y is exactly equivalent
-                // to cf = cf / y. And cf must be move-assignable. So this should be possible.
-                it->m_cf /= y;
+            // NOTE: here the original requirement is that cf / y is defined, but we know
+            // that cf / y results in another cf, and we assume always that cf /= y is exactly equivalent
+            // to cf = cf / y. And cf must be move-assignable. So this should be possible.
+            c /= y;
 #if defined(PIRANHA_COMPILER_IS_GCC)
 #pragma GCC diagnostic pop
 #endif
-                // NOTE: no need to check for compatibility, as it depends only on the key type and here
-                // we are only acting on the coefficient.
-                if (unlikely(it->is_zero(retval.m_symbol_set))) {
-                    // Erase will return the next iterator.
-                    it = retval.m_container.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-        } catch (...) {
-            // In case of errors clear out the series.
-            retval.m_container.clear();
-            throw;
-        }
+        });
         return retval;
     }
     // NOTE: the trailing decltype() syntax is used here to make sure we can actually call the other overload of the
@@ -1441,6 +1590,9 @@ private:
     {
         const auto it_f = s.m_container.end();
         try {
+            if (parallel_merge<Sign>(s.m_container)) {
+                return;
+            }
             for (auto it = s.m_container.begin(); it != it_f; ++it) {
                 insert<Sign>(*it);
             }
@@ -1484,6 +1636,128 @@ private:
     static void swap_for_merge(container_type &&, OtherContainerType &&, bool &)
     {
     }
+    // Parallel merge of the terms in c into this. The terms are moved out of c if c is an rvalue reference.
+    // Returns false, without merging any term, if the merge should be done serially.
+    // The destination table is first rehashed so that it can hold all the terms of both series. Then the terms of c
+    // are distributed, in parallel, in as many lists as there are threads, according to the range of their destination
+    // buckets. Finally, each thread merges one list into its own range of buckets, so that each bucket is written by
+    // one thread only. As in insert(), ignorable terms are discarded. If c contains incompatible terms, the merge
+    // is left to the serial path, which will throw at the first incompatible term. In case of errors during the
+    // merge, the state of this is unspecified and it must be cleared by the caller.
+    template <bool Sign, typename C>
+    bool parallel_merge(C &&c)
+    {
+        static_assert(std::is_same<uncvref_t<C>, container_type>::value, "Invalid container type.");
+        using term_ref
+            = typename std::conditional<is_nonconst_rvalue_ref<C &&>::value, term_type &&, const term_type &>::type;
+        using bucket_size_type = typename container_type::size_type;
+        const unsigned n_threads
+            = c.size() ? thread_pool::use_threads(integer(c.size()), integer(settings::get_min_work_per_thread())) : 1u;
+        if (n_threads == 1u) {
+            return false;
+        }
+        // Presize the destination table. Do not do anything in case of overflows.
+        if (unlikely(m_container.size() > std::numeric_limits<size_type>::max() - c.size())) {
+            return false;
+        }
+        const auto n_buckets = boost::numeric_cast<size_type>(
+            std::ceil(static_cast<double>(m_container.size() + c.size()) / m_container.max_load_factor()));
+        if (m_container.bucket_count() < n_buckets) {
+            m_container.rehash(n_buckets, n_threads);
+        }
+        // Buckets per thread in the destination table.
+        const bucket_size_type b_count = m_container.bucket_count(), bpt = b_count / n_threads;
+        if (unlikely(!bpt)) {
+            return false;
+        }
+        const bucket_size_type src_b_count = c.bucket_count(), src_bpt = src_b_count / n_threads;
+        // The lists of terms to be merged, together with their destination buckets. lists[i][j] contains the terms
+        // examined by the thread i with destination in the bucket range of the thread j.
+        using entry_type = std::pair<const term_type *, bucket_size_type>;
+        std::vector<std::vector<std::vector<entry_type>>> lists(n_threads,
+                                                                std::vector<std::vector<entry_type>>(n_threads));
+        std::atomic<bool> incompatible(false);
+        auto distribute = [&c, &lists, &incompatible, this, n_threads, bpt, src_bpt, src_b_count](unsigned t_idx) {
+            const auto start = static_cast<bucket_size_type>(src_bpt * t_idx);
+            const auto end
+                = t_idx == n_threads - 1u ? src_b_count : static_cast<bucket_size_type>(src_bpt * (t_idx + 1u));
+            auto &l = lists[t_idx];
+            for (auto i = start; i != end; ++i) {
+                const auto &bl = c._get_bucket_list(i);
+                for (auto it = bl.begin(); it != bl.end(); ++it) {
+                    if (unlikely(!it->is_compatible(this->m_symbol_set))) {
+                        incompatible.store(true);
+                        return;
+                    }
+                    if (unlikely(it->is_zero(this->m_symbol_set))) {
+                        continue;
+                    }
+                    const auto b_idx = this->m_container._bucket(*it);
+                    l[std::min(static_cast<unsigned>(b_idx / bpt), n_threads - 1u)].emplace_back(&*it, b_idx);
+                }
+            }
+        };
+        // Net change in the number of terms of this.
+        std::mutex m;
+        integer delta(0);
+        auto merge = [&lists, &m, &delta, this, n_threads](unsigned t_idx) {
+            auto &cont = this->m_container;
+            const auto it_end = cont.end();
+            integer local_delta(0);
+            for (unsigned i = 0u; i < n_threads; ++i) {
+                for (const auto &p : lists[i][t_idx]) {
+                    // NOTE: the terms of c are not const objects, they are accessed via const references
+                    // only because of the interface of hash_set. In the move case, they are moved out of c,
+                    // which is cleared by the caller after the merge.
+                    auto &term = const_cast<term_type &>(*p.first);
+                    auto it = cont._find(term, p.second);
+                    if (it == it_end) {
+                        it = cont._unique_insert(static_cast<term_ref>(term), p.second);
+                        ++local_delta;
+                        if (!Sign) {
+                            math::negate(it->m_cf);
+                        }
+                    } else {
+                        insertion_cf_arithmetics<Sign>(it, static_cast<term_ref>(term));
+                    }
+                    if (unlikely(it->is_zero(this->m_symbol_set))) {
+                        // NOTE: must use _erase to avoid concurrent modifications
+                        // to the number of elements in the table.
+                        cont._erase(it);
+                        --local_delta;
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(m);
+            delta += local_delta;
+        };
+        // Run f in all the threads.
+        auto run = [n_threads](const std::function<void(unsigned)> &f) {
+            future_list<void> f_list;
+            try {
+                for (unsigned i = 0u; i < n_threads; ++i) {
+                    f_list.push_back(thread_pool::enqueue(i, f, i));
+                }
+                // First let's wait for everything to finish.
+                f_list.wait_all();
+                // Then, let's handle the exceptions.
+                f_list.get_all();
+            } catch (...) {
+                f_list.wait_all();
+                throw;
+            }
+        };
+        run(distribute);
+        if (incompatible.load()) {
+            return false;
+        }
+        const auto old_size = m_container.size();
+        // NOTE: if the merge fails, the number of elements in the table is inconsistent. The callers
+        // clear this in case of errors.
+        run(merge);
+        m_container._update_size(safe_cast<size_type>(old_size + delta));
+        return true;
+    }
     // Overload if we can move objects from series.
     template <bool Sign, typename T>
     void merge_terms_impl1(T &&s, typename std::enable_if<is_nonconst_rvalue_ref<T &&>::value>::type * = nullptr)
@@ -1492,9 +1766,11 @@ private:
         // Try to steal memory from other.
         swap_for_merge(std::move(m_container), std::move(s.m_container), swap);
         try {
-            const auto it_f = s.m_container._m_end();
-            for (auto it = s.m_container._m_begin(); it != it_f; ++it) {
-                insert<Sign>(std::move(*it));
+            if (!parallel_merge<Sign>(std::move(s.m_container))) {
+                const auto it_f = s.m_container._m_end();
+                for (auto it = s.m_container._m_begin(); it != it_f; ++it) {
+                    insert<Sign>(std::move(*it));
+                }
             }
             // If we swapped the operands and a negative merge was performed, we need to change
             // the signs of all coefficients.
@@ -1948,18 +2224,81 @@ private:
             return a.is_identical(b);
         }
     };
+    // Estimate of the memory footprint of a series in the pow cache: the buckets of the container
+    // (which store the first node of each chain in place) and the overflow nodes. The memory allocated
+    // by the coefficients and by the keys is not accounted for.
+    struct series_byte_size {
+        template <typename T>
+        std::size_t operator()(const T &s) const
+        {
+            const auto &c = s._container();
+            return sizeof(T) + (c.bucket_count() + c.size()) * (sizeof(typename T::term_type) + sizeof(void *));
+        }
+    };
     template <typename Series>
-    using pow_map_type = std::unordered_map<Series, std::vector<pow_m_type<Series>>, series_hasher, series_equal_to>;
+    using pow_cache_type
+        = detail::pow_cache<Series, pow_m_type<Series>, series_hasher, series_equal_to, series_byte_size>;
     // NOTE: here, as in the custom derivative machinery, we need to pass through a static function
     // to get the cache because Derived is an incomplete type and we cannot thus use a static data member
     // involving Derived in series. Also, we need the Series template argument to inhibit the instantiation
     // of the function for series types that do not support exponentiation.
     template <typename Series = Derived>
-    static pow_map_type<Series> &get_pow_cache()
+    static pow_cache_type<Series> &get_pow_cache()
     {
-        static pow_map_type<Series> s_pow_cache;
+        static pow_cache_type<Series> s_pow_cache;
         return s_pow_cache;
     }
+    // Coefficient types for which all the exponentiation algorithms yield the same result. Only for these
+    // types the automatic exponentiation strategy selects an algorithm other than the cached one.
+    template <typename Series>
+    using pow_exact_cf = disjunction<mppp::is_integer<typename Series::term_type::cf_type>,
+                                     mppp::is_rational<typename Series::term_type::cf_type>>;
+    // Exponentiation by squaring. The powers are computed as M objects, with the base constructed via next(init()).
+    // This is available only if M * M results in M.
+    template <typename M>
+    using pow_binary_enabler
+        = enable_if_t<std::is_same<M, decltype(std::declval<const M &>() * std::declval<const M &>())>::value, int>;
+    template <typename M, typename Ret, typename Init, typename Next, pow_binary_enabler<M> = 0>
+    static bool pow_binary(Ret &retval, std::size_t n, bool force, const Init &init, const Next &next)
+    {
+        piranha_assert(n > 1u);
+        const M x1 = next(init());
+        M base = x1 * x1;
+        // NOTE: repeated squaring pays off only if the number of terms grows slowly with the exponent (e.g.,
+        // dense univariate series), otherwise the last multiplications, involving two large operands, dominate
+        // the runtime. As a cheap proxy, we give up if the square of the base has more terms than a linear
+        // growth would produce.
+        if (!force && base.size() > 2u * x1.size() - 1u) {
+            return false;
+        }
+        bool have_result = n % 2u != 0u;
+        M result = have_result ? x1 : M{};
+        n /= 2u;
+        while (true) {
+            if (n % 2u != 0u) {
+                if (have_result) {
+                    result = result * base;
+                } else {
+                    result = base;
+                    have_result = true;
+                }
+            }
+            n /= 2u;
+            if (!n) {
+                break;
+            }
+            base = base * base;
+        }
+        retval = Ret(std::move(result));
+        return true;
+    }
+    template <typename M, typename Ret, typename Init, typename Next,
+              enable_if_t<!std::is_same<M, decltype(std::declval<const M &>() * std::declval<const M &>())>::value,
+                          int> = 0>
+    static bool pow_binary(Ret &, std::size_t, bool, const Init &, const Next &)
+    {
+        return false;
+    }
     // Empty for sfinae.
     template <typename T, typename U, typename = void>
     struct pow_ret_type_ {
@@ -2307,11 +2646,17 @@ public:
      * - if \p x is zero (as established by piranha::is_zero()), a series with a single term
      *   with unitary key and coefficient constructed from the integer numeral "1" is returned (i.e., any series raised
      *   to the power of zero is 1 - including empty series);
-     * - if \p x represents a non-negative integral value, the return value is constructed via repeated multiplications;
+     * - if \p x represents a non-negative integral value, the return value is constructed via repeated multiplications
+     *   or via repeated squaring, depending on piranha::tuning::get_pow_strategy() (in automatic mode, repeated
+     *   squaring is considered only for mp++ integer and rational coefficients, and only if the power is not
+     *   in the cache already);
      * - otherwise, an exception will be raised.
      *
      * An internal thread-safe cache of natural powers of series is maintained in order to improve performance during,
-     * e.g., substitution operations. This cache can be cleared with clear_pow_cache().
+     * e.g., substitution operations. Exponentiations of different series can run concurrently, as only the entry of
+     * the cache relative to the base is locked while the missing powers are computed. The estimated memory footprint
+     * of the cache is bounded by a budget (see set_pow_cache_budget()): when the budget is exceeded, the least
+     * recently used bases are evicted from the cache. The cache can be cleared with clear_pow_cache().
      *
      * @param x exponent.
      *
@@ -2372,23 +2717,31 @@ public:
         if (n.sgn() < 0) {
             piranha_throw(std::invalid_argument, "invalid argument for series exponentiation: negative integral value");
         }
-        // Lock the cache for the rest of the method.
-        std::lock_guard<std::mutex> lock(s_pow_mutex);
-        auto &v = get_pow_cache()[*static_cast<Derived const *>(this)];
-        using s_type = decltype(v.size());
-        // Init the vector, if needed.
-        if (!v.size()) {
+        const auto n_s = piranha::safe_cast<std::size_t>(n);
+        // NOTE: only the entry of this in the cache is locked while the missing powers are computed.
+        auto init = []() -> m_type {
             m_type tmp;
             tmp.insert(m_term_type(m_cf_type(1), m_key_type(symbol_fset{})));
-            v.push_back(std::move(tmp));
-        }
-        // Fill in the missing powers.
-        while (v.size() <= n) {
-            // NOTE: for series it seems like it is better to run the dumb algorithm instead of, e.g.,
-            // exponentiation by squaring - the growth in number of terms seems to be slower.
-            v.push_back(v.back() * (*static_cast<Derived const *>(this)));
+            return tmp;
+        };
+        auto next = [this](const m_type &p) -> m_type { return p * (*static_cast<Derived const *>(this)); };
+        // NOTE: for series it is in general better to run the dumb algorithm instead of exponentiation by
+        // squaring, as the growth in number of terms is usually slower and all the intermediate powers end up
+        // in the cache. In automatic mode, squaring is attempted only for exact coefficient types (so that
+        // the result does not depend on the algorithm) and if the power is not in the cache already.
+        // NOTE: the threshold on the exponent is a tuning parameter.
+        const auto strategy = tuning::get_pow_strategy();
+        if (n_s > 1u && (strategy == pow_strategy::binary || (strategy == pow_strategy::automatic && n_s >= 4u
+                                                              && pow_exact_cf<Derived>::value))) {
+            ret_type retval;
+            if (strategy == pow_strategy::automatic && pow_cache_find(n_s, retval)) {
+                return retval;
+            }
+            if (pow_binary<m_type>(retval, n_s, strategy == pow_strategy::binary, init, next)) {
+                return retval;
+            }
         }
-        return ret_type(v[static_cast<s_type>(n)]);
+        return get_pow_cache().template get<ret_type>(*static_cast<Derived const *>(this), n_s, init, next);
     }
     /// Clear the internal cache of natural powers.
     /**
@@ -2399,9 +2752,72 @@ public:
     template <typename T = Derived, is_identical_enabler<T> = 0>
     static void clear_pow_cache()
     {
-        std::lock_guard<std::mutex> lock(s_pow_mutex);
         get_pow_cache().clear();
     }
+    /// Remove a base from the internal cache of natural powers.
+    /**
+     * This method will remove from the cache maintained by piranha::series::pow() the powers of \p x.
+     *
+     * @param x the base whose powers will be removed from the cache.
+     *
+     * @return \p true if the powers of \p x were in the cache, \p false otherwise.
+     *
+     * @throws unspecified any exception thrown by threading primitives, hash() or is_identical().
+     */
+    template <typename T = Derived, is_identical_enabler<T> = 0>
+    static bool erase_pow_cache(const Derived &x)
+    {
+        return get_pow_cache().erase(x);
+    }
+    /// Set the budget of the internal cache of natural powers.
+    /**
+     * This method will set the budget, in bytes, on the estimated memory footprint of the cache maintained by
+     * piranha::series::pow(). If the current footprint exceeds the new budget, the least recently used bases will
+     * be evicted. The footprint is estimated from the number of buckets and terms of the cached series, excluding
+     * the memory allocated by coefficients and keys. The default budget is 1 GB.
+     *
+     * @param budget the desired budget.
+     *
+     * @throws unspecified any exception thrown by threading primitives or by memory errors in standard containers.
+     */
+    template <typename T = Derived, is_identical_enabler<T> = 0>
+    static void set_pow_cache_budget(std::size_t budget)
+    {
+        get_pow_cache().set_budget(budget);
+    }
+    /// Get the budget of the internal cache of natural powers.
+    /**
+     * @return the budget, in bytes, set by set_pow_cache_budget().
+     */
+    template <typename T = Derived, is_identical_enabler<T> = 0>
+    static std::size_t get_pow_cache_budget()
+    {
+        return get_pow_cache().get_budget();
+    }
+    /// Get the statistics of the internal cache of natural powers.
+    /**
+     * The counters of hits, misses and evictions are accumulated since the program start or since the last call to
+     * reset_pow_cache_stats().
+     *
+     * @return the statistics of the cache maintained by piranha::series::pow().
+     *
+     * @throws unspecified any exception thrown by threading primitives.
+     */
+    template <typename T = Derived, is_identical_enabler<T> = 0>
+    static pow_cache_stats get_pow_cache_stats()
+    {
+        return get_pow_cache().get_stats();
+    }
+    /// Reset the counters of the internal cache of natural powers.
+    /**
+     * This method will reset to zero the counters of hits, misses and evictions of the cache maintained by
+     * piranha::series::pow().
+     */
+    template <typename T = Derived, is_identical_enabler<T> = 0>
+    static void reset_pow_cache_stats()
+    {
+        get_pow_cache().reset_stats();
+    }
     /// Partial derivative.
     /**
      * \note
@@ -2828,6 +3244,26 @@ public:
     }
     //@}
 protected:
+    /// Look up a power of the calling series in the cache of natural powers.
+    /**
+     * This method is meant to be used by the overrides of pow() in the implementation of the automatic selection
+     * of the exponentiation strategy (see piranha::tuning::get_pow_strategy()). The cache is not modified
+     * if the power is not found.
+     *
+     * @param n the exponent.
+     * @param retval the object that will be assigned the <tt>n</tt>-th power of \p this, if found in the cache.
+     *
+     * @return \p true if the <tt>n</tt>-th power of \p this was found in the cache of natural powers,
+     * \p false otherwise.
+     *
+     * @throws unspecified any exception thrown by threading primitives, hash(), is_identical(), or the
+     * construction and assignment of \p Ret.
+     */
+    template <typename Ret, typename T = Derived>
+    bool pow_cache_find(std::size_t n, Ret &retval) const
+    {
+        return get_pow_cache<T>().find(*static_cast<Derived const *>(this), n, retval);
+    }
     /// Symbol set.
     symbol_fset m_symbol_set;
     /// Terms container.
@@ -2836,16 +3272,11 @@ protected:
 private:
     // Custom derivatives machinery.
     static std::mutex s_cp_mutex;
-    // Pow cache machinery;
-    static std::mutex s_pow_mutex;
 };
 
 template <typename Cf, typename Key, typename Derived>
 std::mutex series<Cf, Key, Derived>::s_cp_mutex;
 
-template <typename Cf, typename Key, typename Derived>
-std::mutex series<Cf, Key, Derived>::s_pow_mutex;
-
 inline namespace impl
 {
 
@@ -3438,6 +3869,26 @@ using series_eval_type = decltype(
     * std::declval<const typename Series::term_type::key_type &>().evaluate(std::declval<const std::vector<T> &>(),
                                                                             std::declval<const symbol_fset &>()));
 
+// Detect if a series can be evaluated via a series_evaluation_plan: the key must expose its exponents via
+// key_power_exponents, the exponents must be C++ integrals and the type of the powers of the values must be
+// the evaluation type of the key.
+template <typename Series, typename T, typename = void>
+struct series_has_evaluation_plan : std::false_type {
+};
+
+template <typename Series, typename T>
+struct series_has_evaluation_plan<
+    Series, T,
+    enable_if_t<conjunction<
+        std::is_integral<key_power_exponents_t<typename Series::term_type::key_type>>,
+        std::is_same<decltype(piranha::pow(
+                         std::declval<const T &>(),
+                         std::declval<const key_power_exponents_t<typename Series::term_type::key_type> &>())),
+                     decltype(std::declval<const typename Series::term_type::key_type &>().evaluate(
+                         std::declval<const std::vector<T> &>(), std::declval<const symbol_fset &>()))>>::value>>
+    : std::true_type {
+};
+
 template <typename Series, typename T>
 using math_series_evaluate_enabler
     = enable_if_t<conjunction<is_series<Series>, is_addable_in_place<series_eval_type<Series, T>>,
@@ -3460,17 +3911,22 @@ template <typename Series, typename T>
 class evaluate_impl<Series, T, math_series_evaluate_enabler<Series, T>>
 {
     using eval_type = series_eval_type<Series, T>;
-    // Wrapper to do multadd either via math::multiply_accumulate(), if supported, or just
-    // plain math operators.
-    template <typename E, enable_if_t<has_multiply_accumulate<E>::value, int> = 0>
-    static void multadd(E &retval, const E &a, const E &b)
+    // Evaluation via a plan.
+    template <typename U = Series, enable_if_t<series_has_evaluation_plan<U, T>::value, int> = 0>
+    static eval_type impl(const Series &s, const std::vector<T> &evec, const symbol_fmap<T> &dict)
     {
-        math::multiply_accumulate(retval, a, b);
+        return detail::series_evaluation_plan<Series>(s).evaluate(evec, dict);
     }
-    template <typename E1, typename E2, typename E3>
-    static void multadd(E1 &retval, const E2 &a, const E3 &b)
+    // Term-by-term evaluation.
+    template <typename U = Series, enable_if_t<!series_has_evaluation_plan<U, T>::value, int> = 0>
+    static eval_type impl(const Series &s, const std::vector<T> &evec, const symbol_fmap<T> &dict)
     {
-        retval += a * b;
+        const auto &ss = s.get_symbol_set();
+        eval_type retval(0);
+        for (const auto &t : s._container()) {
+            detail::series_eval_multadd(retval, math::evaluate(t.m_cf, dict), t.m_key.evaluate(evec, ss));
+        }
+        return retval;
     }
 
 public:
@@ -3481,6 +3937,15 @@ public:
      * of all terms in the series via the product of the evaluations of the coefficient-key pairs in each term.
      * The input dictionary \p dict specifies with which value each symbolic quantity will be evaluated.
      *
+     * If the key type of \p Series is a monomial with C++ integral exponents whose evaluation is computed via
+     * piranha::pow(), the exponents of the terms are first unpacked in a flat array and, for each symbol, a table of
+     * the powers of its value is built, so that the evaluation of the keys reduces to lookups and multiplications.
+     * If the evaluation type is a C++ integral type or an mp++ integer or rational, large series are evaluated in
+     * parallel, according to the value returned by piranha::settings::get_min_work_per_thread(). Otherwise, the
+     * evaluation is single-threaded, so that the result does not depend on the number of threads. In both cases,
+     * the result is the same as the one of the term-by-term evaluation. piranha::math::lambdified stores the
+     * unpacked exponents, so that they can be reused across evaluations.
+     *
      * @param s the series to be evaluated.
      * @param dict the dictionary that will be used for evaluation.
      *
@@ -3491,7 +3956,9 @@ public:
      * - coefficient and key evaluation,
      * - memory errors in standard containers,
      * - the copy constructor of \p T,
-     * - arithmetic operations on the evaluation type.
+     * - arithmetic operations on the evaluation type,
+     * - piranha::pow(),
+     * - failure(s) in threading primitives.
      */
     eval_type operator()(const Series &s, const symbol_fmap<T> &dict) const
     {
@@ -3521,7 +3988,7 @@ public:
             if (unlikely(it_dict == it_dict_f || it_dict->first != sym)) {
                 // The it_ss value was not found: we cannot evaluate.
                 piranha_throw(std::invalid_argument, "cannot evaluate series: the symbol '" + sym
-                                                         + "' is missing from the series evaluation dictionary'");
+                                                         + "' is missing from the series evaluation dictionary");
             }
             // Append the value mapped to the current ss symbol to the vector.
             evec.push_back(it_dict->second);
@@ -3533,12 +4000,7 @@ public:
         }
         piranha_assert(evec.size() == ss.size());
 
-        // Init the return value and accumulate it.
-        eval_type retval(0);
-        for (const auto &t : s._container()) {
-            multadd(retval, math::evaluate(t.m_cf, dict), t.m_key.evaluate(evec, ss));
-        }
-        return retval;
+        return impl(s, evec, dict);
     }
 };
 }
@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/subs_batcher.hpp>
 #include <piranha/forwarding.hpp>
 #include <piranha/math.hpp>
 #include <piranha/series.hpp>
@@ -83,23 +84,27 @@ class substitutable_series : public Series, detail::substitutable_series_tag
         = std::integral_constant<unsigned,
                                  static_cast<unsigned>(has_subs<typename Term::cf_type, T>::value)
                                      + (static_cast<unsigned>(key_has_subs<typename Term::key_type, T>::value) << 1u)>;
+    // NOTE: in cases 1 and 2, the terms are grouped according to the values resulting from the substitution
+    // (see detail::subs_batcher), so that a single multiplication per group is needed, instead of one multiplication
+    // per term.
     // Case 1: subs only on cf.
     template <typename T, typename Term>
     using cf_subs_type
         = decltype(math::subs(std::declval<typename Term::cf_type const &>(), std::declval<const symbol_fmap<T> &>()));
     template <typename T, typename Term>
     using ret_type_1 = decltype(std::declval<const cf_subs_type<T, Term> &>() * std::declval<Derived const &>());
-    template <typename T, typename Term, enable_if_t<subs_term_score<Term, T>::value == 1u, int> = 0>
-    static ret_type_1<T, Term> subs_term_impl(const Term &t, const symbol_fmap<T> &dict, const symbol_idx_fmap<T> &,
-                                              const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              enable_if_t<subs_term_score<Term, T>::value == 1u, int> = 0>
+    static ret_type_1<T, Term> subs_impl(const typename Series::container_type &c, const symbol_fmap<T> &dict,
+                                         const symbol_idx_fmap<T> &, const symbol_fset &s_set)
     {
-        // NOTE: in these functions we could probably have optimised implementations, like in series'
-        // partial, that use term insertion instead of arithmetics if the types allow it.
-        Derived tmp;
-        tmp.set_symbol_set(s_set);
-        tmp.insert(Term(typename Term::cf_type(1), t.m_key));
+        detail::subs_batcher<cf_subs_type<T, Term>, Derived> batcher(s_set);
+        for (const auto &t : c) {
+            batcher.add(math::subs(t.m_cf, dict), Term(typename Term::cf_type(1), t.m_key));
+        }
         // NOTE: use moves here in case the multiplication can take advantage.
-        return math::subs(t.m_cf, dict) * std::move(tmp);
+        return batcher.template accumulate<ret_type_1<T, Term>>(
+            [](cf_subs_type<T, Term> &&v, Derived &&tmp) { return std::move(v) * std::move(tmp); });
     }
     // Case 2: subs only on key.
     template <typename T, typename Term>
@@ -111,48 +116,54 @@ class substitutable_series : public Series, detail::substitutable_series_tag
     using ret_type_2 = enable_if_t<conjunction<is_addable_in_place<ret_type_2_<T, Term>>,
                                                std::is_constructible<ret_type_2_<T, Term>, const int &>>::value,
                                    ret_type_2_<T, Term>>;
-    template <typename T, typename Term, enable_if_t<subs_term_score<Term, T>::value == 2u, int> = 0>
-    static ret_type_2<T, Term> subs_term_impl(const Term &t, const symbol_fmap<T> &, const symbol_idx_fmap<T> &idx,
-                                              const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              enable_if_t<subs_term_score<Term, T>::value == 2u, int> = 0>
+    static ret_type_2<T, Term> subs_impl(const typename Series::container_type &c, const symbol_fmap<T> &,
+                                         const symbol_idx_fmap<T> &idx, const symbol_fset &s_set)
     {
-        ret_type_2<T, Term> retval(0);
-        auto ksubs = t.m_key.subs(idx, s_set);
-        for (auto &p : ksubs) {
-            Derived tmp;
-            tmp.set_symbol_set(s_set);
-            tmp.insert(Term{t.m_cf, std::move(p.second)});
-            // NOTE: possible use of multadd here in the future.
-            retval += std::move(tmp) * std::move(p.first);
+        detail::subs_batcher<k_subs_type<T, Term>, Derived> batcher(s_set);
+        for (const auto &t : c) {
+            auto ksubs = t.m_key.subs(idx, s_set);
+            for (auto &p : ksubs) {
+                batcher.add(std::move(p.first), Term{t.m_cf, std::move(p.second)});
+            }
         }
-        return retval;
+        return batcher.template accumulate<ret_type_2<T, Term>>(
+            [](k_subs_type<T, Term> &&v, Derived &&tmp) { return std::move(tmp) * std::move(v); });
     }
     // Case 3: subs on cf and key.
     // NOTE: the checks on type 2 are already present in the alias above.
     template <typename T, typename Term>
     using ret_type_3
         = decltype(std::declval<const cf_subs_type<T, Term> &>() * std::declval<const ret_type_2<T, Term> &>());
-    template <typename T, typename Term, enable_if_t<subs_term_score<Term, T>::value == 3u, int> = 0>
-    static ret_type_3<T, Term> subs_term_impl(const Term &t, const symbol_fmap<T> &dict, const symbol_idx_fmap<T> &idx,
-                                              const symbol_fset &s_set)
+    template <typename T, typename Term = typename Series::term_type,
+              enable_if_t<subs_term_score<Term, T>::value == 3u, int> = 0>
+    static ret_type_3<T, Term> subs_impl(const typename Series::container_type &c, const symbol_fmap<T> &dict,
+                                         const symbol_idx_fmap<T> &idx, const symbol_fset &s_set)
     {
-        // Accumulator for the sum below. This is the same type resulting from case 2.
-        ret_type_2<T, Term> acc(0);
-        auto ksubs = t.m_key.subs(idx, s_set);
-        auto cf_subs = math::subs(t.m_cf, dict);
-        for (auto &p : ksubs) {
-            Derived tmp;
-            tmp.set_symbol_set(s_set);
-            tmp.insert(Term(typename Term::cf_type(1), std::move(p.second)));
-            // NOTE: multadd chance.
-            acc += std::move(tmp) * std::move(p.first);
+        ret_type_3<T, Term> retval(0);
+        for (const auto &t : c) {
+            // Accumulator for the sum below. This is the same type resulting from case 2.
+            ret_type_2<T, Term> acc(0);
+            auto ksubs = t.m_key.subs(idx, s_set);
+            auto cf_subs = math::subs(t.m_cf, dict);
+            for (auto &p : ksubs) {
+                Derived tmp;
+                tmp.set_symbol_set(s_set);
+                tmp.insert(Term(typename Term::cf_type(1), std::move(p.second)));
+                // NOTE: multadd chance.
+                acc += std::move(tmp) * std::move(p.first);
+            }
+            retval += std::move(cf_subs) * std::move(acc);
         }
-        return std::move(cf_subs) * std::move(acc);
+        return retval;
     }
     // Initial definition of the subs type.
     template <typename T>
-    using subs_type_ = decltype(
-        subs_term_impl(std::declval<typename Series::term_type const &>(), std::declval<const symbol_fmap<T> &>(),
-                       std::declval<const symbol_idx_fmap<T> &>(), std::declval<symbol_fset const &>()));
+    using subs_type_
+        = decltype(subs_impl(std::declval<typename Series::container_type const &>(),
+                             std::declval<const symbol_fmap<T> &>(), std::declval<const symbol_idx_fmap<T> &>(),
+                             std::declval<symbol_fset const &>()));
     // Enable conditionally based on the common requirements in the subs() method, plus on the fact that
     // the subs type must be returnable.
     // NOTE: the returnable check here should be enough, as the functions above will not be called if the check
@@ -206,6 +217,11 @@ public:
      * This method will return an object resulting from the substitution in \p this of the symbols in \p dict
      * with the mapped values.
      *
+     * If only the coefficients or only the keys support substitution, the terms of the series are grouped according
+     * to the values produced by the substitution (e.g., all the terms of a polynomial with the same exponent of the
+     * substituted symbol), and the result is computed with one multiplication per group, instead of one
+     * multiplication per term. If there are enough groups, the multiplications are run in parallel.
+     *
      * @param dict a dictionary mapping a set of symbols to the values that will be substituted for them.
      *
      * @return the result of the substitution.
@@ -219,11 +235,7 @@ public:
     subs_type<T> subs(const symbol_fmap<T> &dict) const
     {
         const auto idx = sm_intersect_idx(this->m_symbol_set, dict);
-        subs_type<T> retval(0);
-        for (const auto &t : this->m_container) {
-            retval += subs_term_impl(t, dict, idx, this->m_symbol_set);
-        }
-        return retval;
+        return subs_impl(this->m_container, dict, idx, this->m_symbol_set);
     }
 };
 
@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 
 #include <piranha/detail/init.hpp>
+#include <piranha/detail/subs_batcher.hpp>
 #include <piranha/forwarding.hpp>
 #include <piranha/math.hpp>
 #include <piranha/series.hpp>
@@ -91,6 +92,8 @@ class t_substitutable_series : public Series, detail::t_substitutable_series_tag
     struct t_subs_utils {
         static_assert(t_subs_term_score<Term, T, U>::value == 0u, "Wrong t_subs_term_score value.");
     };
+    // NOTE: the terms are grouped according to the values resulting from the substitution (see
+    // detail::subs_batcher), so that a single multiplication per group is needed.
     // Case 1: t_subs on cf only.
     template <typename T, typename U, typename Term>
     struct t_subs_utils<T, U, Term, enable_if_t<t_subs_term_score<Term, T, U>::value == 1u>> {
@@ -104,13 +107,20 @@ class t_substitutable_series : public Series, detail::t_substitutable_series_tag
                                             && is_addable_in_place<return_type_<T1, U1, Term1>>::value,
                                         return_type_<T1, U1, Term1>>;
         template <typename T1, typename U1, typename Term1>
-        static return_type<T1, U1, Term1> subs(const Term1 &t, const std::string &name, const symbol_idx &, const T1 &c,
-                                               const U1 &s, const symbol_fset &s_set)
+        using cf_t_subs_type
+            = decltype(math::t_subs(std::declval<typename Term1::cf_type const &>(),
+                                    std::declval<std::string const &>(), std::declval<T1 const &>(),
+                                    std::declval<U1 const &>()));
+        template <typename T1, typename U1, typename Term1 = Term>
+        static return_type<T1, U1, Term1> subs(const typename Series::container_type &cont, const std::string &name,
+                                               const symbol_idx &, const T1 &c, const U1 &s, const symbol_fset &s_set)
         {
-            Derived tmp;
-            tmp.m_symbol_set = s_set;
-            tmp.insert(Term1(typename Term1::cf_type(1), t.m_key));
-            return math::t_subs(t.m_cf, name, c, s) * tmp;
+            detail::subs_batcher<cf_t_subs_type<T1, U1, Term1>, Derived> batcher(s_set);
+            for (const auto &t : cont) {
+                batcher.add(math::t_subs(t.m_cf, name, c, s), Term1(typename Term1::cf_type(1), t.m_key));
+            }
+            return batcher.template accumulate<return_type<T1, U1, Term1>>(
+                [](cf_t_subs_type<T1, U1, Term1> &&v, Derived &&tmp) { return std::move(v) * std::move(tmp); });
         }
     };
     // Case 2: t_subs on key only.
@@ -127,18 +137,23 @@ class t_substitutable_series : public Series, detail::t_substitutable_series_tag
                                                         && is_addable_in_place<return_type_<T1, U1, Term1>>::value,
                                                     return_type_<T1, U1, Term1>>::type;
         template <typename T1, typename U1, typename Term1>
-        static return_type<T1, U1, Term1> subs(const Term1 &t, const std::string &, const symbol_idx &idx, const T1 &c,
-                                               const U1 &s, const symbol_fset &s_set)
+        using k_t_subs_type = typename decltype(std::declval<typename Term1::key_type const &>().t_subs(
+            std::declval<const symbol_idx &>(), std::declval<T1 const &>(), std::declval<U1 const &>(),
+            std::declval<symbol_fset const &>()))::value_type::first_type;
+        template <typename T1, typename U1, typename Term1 = Term>
+        static return_type<T1, U1, Term1> subs(const typename Series::container_type &cont, const std::string &,
+                                               const symbol_idx &idx, const T1 &c, const U1 &s,
+                                               const symbol_fset &s_set)
         {
-            return_type<T1, U1, Term1> retval(0);
-            const auto key_subs = t.m_key.t_subs(idx, c, s, s_set);
-            for (const auto &x : key_subs) {
-                Derived tmp;
-                tmp.m_symbol_set = s_set;
-                tmp.insert(Term1(t.m_cf, x.second));
-                retval += x.first * tmp;
+            detail::subs_batcher<k_t_subs_type<T1, U1, Term1>, Derived> batcher(s_set);
+            for (const auto &t : cont) {
+                auto key_subs = t.m_key.t_subs(idx, c, s, s_set);
+                for (auto &x : key_subs) {
+                    batcher.add(std::move(x.first), Term1(t.m_cf, std::move(x.second)));
+                }
             }
-            return retval;
+            return batcher.template accumulate<return_type<T1, U1, Term1>>(
+                [](k_t_subs_type<T1, U1, Term1> &&v, Derived &&tmp) { return std::move(v) * std::move(tmp); });
         }
     };
 // NOTE: we have no way of testing this at the moment, so better leave it out at present time.
@@ -158,7 +173,7 @@ class t_substitutable_series : public Series, detail::t_substitutable_series_tag
     // Final type definition.
     template <typename T, typename U>
     using t_subs_type
-        = decltype(t_subs_utils<T, U>::subs(std::declval<typename Series::term_type const &>(),
+        = decltype(t_subs_utils<T, U>::subs(std::declval<typename Series::container_type const &>(),
                                             std::declval<const std::string &>(), std::declval<const symbol_idx &>(),
                                             std::declval<const T &>(), std::declval<const U &>(),
                                             std::declval<symbol_fset const &>()));
@@ -202,6 +217,9 @@ public:
      *
      * Trigonometric substitution is the substitution of the cosine and sine of \p name for \p c and \p s.
      *
+     * The terms of the series are grouped according to the values produced by the substitution, so that the
+     * result is computed with one series multiplication per group of terms (instead of one per term).
+     *
      * @param name name of the symbol that will be subject to substitution.
      * @param c cosine of \p name.
      * @param s sine of \p name.
@@ -219,12 +237,8 @@ public:
     template <typename T, typename U>
     t_subs_type<T, U> t_subs(const std::string &name, const T &c, const U &s) const
     {
-        t_subs_type<T, U> retval(0);
         const auto idx = ss_index_of(this->m_symbol_set, name);
-        for (const auto &t : this->m_container) {
-            retval += t_subs_utils<T, U>::subs(t, name, idx, c, s, this->m_symbol_set);
-        }
-        return retval;
+        return t_subs_utils<T, U>::subs(this->m_container, name, idx, c, s, this->m_symbol_set);
     }
 };
 
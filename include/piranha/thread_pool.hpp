@@ -246,6 +246,9 @@ struct thread_pool_base {
     static thread_queues_t s_queues;
     static bool s_bind;
     static std::atomic_flag s_atf;
+    // Number of times the pool has been resized. It is used by the thread-local caches (e.g., the
+    // pools of detail::cf_recycler) to detect that they should release their contents.
+    static std::atomic<unsigned long> s_resize_count;
 };
 
 template <typename T>
@@ -257,6 +260,15 @@ std::atomic_flag thread_pool_base<T>::s_atf = ATOMIC_FLAG_INIT;
 template <typename T>
 bool thread_pool_base<T>::s_bind = false;
 
+template <typename T>
+std::atomic<unsigned long> thread_pool_base<T>::s_resize_count(0ul);
+
+// Number of times thread_pool::resize() has been called.
+inline unsigned long thread_pool_resize_count()
+{
+    return thread_pool_base<>::s_resize_count.load();
+}
+
 template <typename>
 void thread_pool_shutdown();
 }
@@ -348,10 +360,17 @@ private:
     static thread_queues_t create_new_queues(unsigned new_size, bool bind)
     {
         thread_queues_t new_queues;
+        // The processors to which the threads will be bound, grouped by NUMA node. The parallel algorithms
+        // assign contiguous ranges of memory to threads with contiguous indices, thus this way the
+        // threads sharing a NUMA node also share the memory ranges they first-touched.
+        std::vector<unsigned> procs;
+        if (bind) {
+            procs = runtime_info::get_numa_proc_order();
+        }
         // Create the task queues.
         new_queues.first.reserve(static_cast<decltype(new_queues.first.size())>(new_size));
         for (auto i = 0u; i < new_size; ++i) {
-            new_queues.first.emplace_back(::new task_queue(i, bind));
+            new_queues.first.emplace_back(::new task_queue(i < procs.size() ? procs[i] : i, bind));
         }
         // Fill in the thread ids set.
         for (const auto &ptr : new_queues.first) {
@@ -374,7 +393,9 @@ public:
     /**
      * This method will resize the internal pool to contain \p new_size threads. The method will first wait for
      * the threads to consume all the pending tasks (while forbidding the addition of new tasks), and it will then
-     * create a new pool of size \p new_size.
+     * create a new pool of size \p new_size. The thread-local caches of coefficients which piranha keeps in order
+     * to speed up the series multiplication are released as well: the caches of the threads in the old pool are
+     * destroyed with the threads, the caches of the other threads are emptied the next time they are used.
      *
      * @param new_size the new size of the pool.
      *
@@ -399,6 +420,7 @@ public:
         // NOTE: the dtor of the queues is effectively noexcept, as the program will just abort in case of errors
         // in the dtor.
         new_queues.swap(base::s_queues);
+        ++base::s_resize_count;
     }
     /// Set the thread binding policy.
     /**
@@ -406,6 +428,11 @@ public:
      * piranha::bind_to_proc(). If \p flag is \p false, then this method will unbind the threads in the pool from any
      * processor/core to which they might be bound.
      *
+     * The threads are assigned to the processors in the order returned by
+     * piranha::runtime_info::get_numa_proc_order(), so that the threads with contiguous indices are bound to
+     * processors of the same NUMA node. The memory initialised in parallel by the pool (e.g., the buckets of
+     * a piranha::hash_set) is then local to the threads that will operate on it.
+     *
      * The threads created at program startup are not bound to any specific processor/core. Any error raised by
      * piranha::bind_to_proc() (e.g., because the number of threads in the pool is larger than the number of logical
      * cores or because the thread binding functionality is not available on the platform) is silently ignored.
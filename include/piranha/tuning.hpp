@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PIRANHA_TUNING_HPP
 
 #include <atomic>
+#include <limits>
 #include <stdexcept>
 
 #include <piranha/config.hpp>
@@ -40,6 +41,23 @@ see https://www.gnu.org/licenses/. */
 namespace piranha
 {
 
+/// Exponentiation strategies.
+/**
+ * The algorithms available for the computation of the natural powers of series.
+ *
+ * @see piranha::tuning::get_pow_strategy().
+ */
+enum class pow_strategy {
+    /// Automatic selection of the algorithm.
+    automatic,
+    /// Repeated multiplications, storing all the intermediate powers in the cache of natural powers.
+    cached,
+    /// Exponentiation by squaring.
+    binary,
+    /// Multinomial recurrence (polynomials only).
+    multinomial
+};
+
 namespace detail
 {
 
@@ -47,7 +65,14 @@ template <typename = int>
 struct base_tuning {
     static std::atomic<bool> s_parallel_memory_set;
     static std::atomic<unsigned long> s_mult_block_size;
+    static std::atomic<bool> s_mult_auto_tiling;
     static std::atomic<unsigned long> s_estimate_threshold;
+    static std::atomic<bool> s_estimate_cache;
+    static std::atomic<unsigned long long> s_mult_memory_limit;
+    static std::atomic<unsigned long> s_prefetch_distance;
+    static std::atomic<bool> s_mult_multimodular;
+    static std::atomic<bool> s_node_arena;
+    static std::atomic<pow_strategy> s_pow_strategy;
 };
 
 template <typename T>
@@ -56,8 +81,29 @@ std::atomic<bool> base_tuning<T>::s_parallel_memory_set(true);
 template <typename T>
 std::atomic<unsigned long> base_tuning<T>::s_mult_block_size(256u);
 
+template <typename T>
+std::atomic<bool> base_tuning<T>::s_mult_auto_tiling(true);
+
 template <typename T>
 std::atomic<unsigned long> base_tuning<T>::s_estimate_threshold(200u);
+
+template <typename T>
+std::atomic<bool> base_tuning<T>::s_estimate_cache(false);
+
+template <typename T>
+std::atomic<unsigned long long> base_tuning<T>::s_mult_memory_limit(std::numeric_limits<unsigned long long>::max());
+
+template <typename T>
+std::atomic<unsigned long> base_tuning<T>::s_prefetch_distance(16u);
+
+template <typename T>
+std::atomic<bool> base_tuning<T>::s_mult_multimodular(false);
+
+template <typename T>
+std::atomic<bool> base_tuning<T>::s_node_arena(false);
+
+template <typename T>
+std::atomic<pow_strategy> base_tuning<T>::s_pow_strategy(pow_strategy::cached);
 }
 
 /// Performance tuning.
@@ -111,7 +157,11 @@ public:
      * Larger block have less overhead, but can degrade the performance of memory access. Smaller blocks can promote
      * faster memory access but can also incur in larger overhead.
      *
-     * The default value of this flag is 256.
+     * The default value of this flag is 256. This value is used only if automatic tiling is disabled
+     * or if the sizes of the cache memories cannot be detected on the host. Setting the block size via
+     * set_multiplication_block_size() disables automatic tiling.
+     *
+     * @see piranha::tuning::get_multiplication_auto_tiling().
      *
      * @return the block size used in some series multiplication routines.
      */
@@ -121,6 +171,9 @@ public:
     }
     /// Set the multiplication block size.
     /**
+     * This method will set the multiplication block size to \p size, and it will disable automatic tiling
+     * (see set_multiplication_auto_tiling()), so that \p size is actually used by the multiplication routines.
+     *
      * @see piranha::tuning::get_multiplication_block_size() for an explanation of the meaning of this value.
      *
      * @param size desired value for the block size.
@@ -133,16 +186,56 @@ public:
             piranha_throw(std::invalid_argument, "invalid block size");
         }
         s_mult_block_size.store(size);
+        s_mult_auto_tiling.store(false);
     }
     /// Reset the multiplication block size.
     /**
-     * This method will reset the multiplication block size to its default value.
+     * This method will reset the multiplication block size to its default value, and it will enable
+     * automatic tiling.
      *
      * @see piranha::tuning::get_multiplication_block_size() for an explanation of the meaning of this value.
      */
     static void reset_multiplication_block_size()
     {
         s_mult_block_size.store(256u);
+        s_mult_auto_tiling.store(true);
+    }
+    /// Get the automatic tiling flag.
+    /**
+     * If this flag is \p true, the series multiplication routines will compute the sizes of the blocks
+     * into which the input operands are divided from the sizes of the L1 and L2 caches (as reported by
+     * piranha::runtime_info::get_cache_size()), the cache line size and the memory footprint of the terms
+     * of the operands. The two operands will in general be divided in blocks of different sizes. If this flag
+     * is \p false, or if the sizes of the caches cannot be detected, the value returned by
+     * get_multiplication_block_size() will be used instead for both operands.
+     *
+     * The default value of this flag is \p true.
+     *
+     * @return \p true if the multiplication block sizes are computed automatically, \p false otherwise.
+     */
+    static bool get_multiplication_auto_tiling()
+    {
+        return s_mult_auto_tiling.load();
+    }
+    /// Set the automatic tiling flag.
+    /**
+     * @see piranha::tuning::get_multiplication_auto_tiling() for an explanation of the meaning of this value.
+     *
+     * @param flag desired value for the automatic tiling flag.
+     */
+    static void set_multiplication_auto_tiling(bool flag)
+    {
+        s_mult_auto_tiling.store(flag);
+    }
+    /// Reset the automatic tiling flag.
+    /**
+     * This method will set the automatic tiling flag to \p true.
+     *
+     * @see piranha::tuning::get_multiplication_auto_tiling() for an explanation of the meaning of this value.
+     */
+    static void reset_multiplication_auto_tiling()
+    {
+        s_mult_auto_tiling.store(true);
     }
     /// Get the series estimation threshold.
     /**
@@ -181,6 +274,267 @@ public:
     {
         s_estimate_threshold.store(200u);
     }
+    /// Get the estimation cache flag.
+    /**
+     * If this flag is \p true, the series multipliers will remember the actual sizes of the results of the
+     * multiplications they performed, and they will use them instead of the statistical estimation when multiplying
+     * again operands with the same sizes and the same keys (as determined by a hash of the keys of the operands).
+     * The cache is separate for each series type, and it holds only the results of a few recent multiplications.
+     *
+     * Note that the cached value is only used to size the container of the result: hash collisions or
+     * different cancellations in the coefficients may result in a suboptimal allocation, but
+     * they never affect the correctness of the result.
+     *
+     * The default value of this flag is \p false.
+     *
+     * @return the estimation cache flag.
+     */
+    static bool get_estimate_cache()
+    {
+        return s_estimate_cache.load();
+    }
+    /// Set the estimation cache flag.
+    /**
+     * @see piranha::tuning::get_estimate_cache() for an explanation of the meaning of this value.
+     *
+     * @param flag desired value for the estimation cache flag.
+     */
+    static void set_estimate_cache(bool flag)
+    {
+        s_estimate_cache.store(flag);
+    }
+    /// Reset the estimation cache flag.
+    /**
+     * This method will set the estimation cache flag to \p false.
+     *
+     * @see piranha::tuning::get_estimate_cache() for an explanation of the meaning of this value.
+     */
+    static void reset_estimate_cache()
+    {
+        s_estimate_cache.store(false);
+    }
+    /// Get the multiplication memory limit.
+    /**
+     * Some series multiplication algorithms (e.g., the plain multiplication of piranha::base_series_multiplier)
+     * pre-allocate the container of the result based on an estimate of the final size of the product.
+     * If the estimated memory footprint of such a container exceeds this limit (in bytes), the multiplication will
+     * be performed in chunked mode: the output hash space is partitioned in ranges which are computed one at a
+     * time, and the nonzero terms of each range are moved into the final result before the next range is computed.
+     *
+     * The chunked mode caps the amount of memory allocated in excess of the final result (e.g., because of the
+     * overestimation of the final size or because of terms cancelling out during the multiplication) to roughly
+     * the value of this limit, at the price of repeating the term-by-term multiplications once per range.
+     *
+     * The default value of this flag is the maximum value representable by <tt>unsigned long long</tt>
+     * (i.e., the chunked mode is disabled).
+     *
+     * @return the multiplication memory limit, in bytes.
+     */
+    static unsigned long long get_multiplication_memory_limit()
+    {
+        return s_mult_memory_limit.load();
+    }
+    /// Set the multiplication memory limit.
+    /**
+     * @see piranha::tuning::get_multiplication_memory_limit() for an explanation of the meaning of this value.
+     *
+     * @param limit desired value for the multiplication memory limit, in bytes.
+     *
+     * @throws std::invalid_argument if \p limit is zero.
+     */
+    static void set_multiplication_memory_limit(unsigned long long limit)
+    {
+        if (unlikely(limit == 0u)) {
+            piranha_throw(std::invalid_argument, "invalid multiplication memory limit");
+        }
+        s_mult_memory_limit.store(limit);
+    }
+    /// Reset the multiplication memory limit.
+    /**
+     * This method will reset the multiplication memory limit to its default value.
+     *
+     * @see piranha::tuning::get_multiplication_memory_limit() for an explanation of the meaning of this value.
+     */
+    static void reset_multiplication_memory_limit()
+    {
+        s_mult_memory_limit.store(std::numeric_limits<unsigned long long>::max());
+    }
+    /// Get the prefetch distance.
+    /**
+     * In series multiplication, each term-by-term product results in a random access into the hash table of the
+     * result. In order to hide the latency of these accesses, some multiplication algorithms prefetch the destination
+     * buckets of the products ahead of time. This value establishes how many products are prefetched
+     * in advance: larger values can hide more latency, but they also increase the pressure on the cache.
+     * A value of zero disables the prefetching.
+     *
+     * The optimal value depends on the latency of the memory subsystem of the host machine.
+     * The default value of this flag is 16.
+     *
+     * @return the prefetch distance used in some series multiplication routines.
+     */
+    static unsigned long get_prefetch_distance()
+    {
+        return s_prefetch_distance.load();
+    }
+    /// Set the prefetch distance.
+    /**
+     * @see piranha::tuning::get_prefetch_distance() for an explanation of the meaning of this value.
+     *
+     * @param distance desired value for the prefetch distance.
+     *
+     * @throws std::invalid_argument if \p distance is greater than get_max_prefetch_distance().
+     */
+    static void set_prefetch_distance(unsigned long distance)
+    {
+        if (unlikely(distance > get_max_prefetch_distance())) {
+            piranha_throw(std::invalid_argument, "invalid prefetch distance");
+        }
+        s_prefetch_distance.store(distance);
+    }
+    /// Reset the prefetch distance.
+    /**
+     * This method will reset the prefetch distance to its default value.
+     *
+     * @see piranha::tuning::get_prefetch_distance() for an explanation of the meaning of this value.
+     */
+    static void reset_prefetch_distance()
+    {
+        s_prefetch_distance.store(16u);
+    }
+    /// Maximum prefetch distance.
+    /**
+     * @return the maximum value accepted by set_prefetch_distance().
+     */
+    static constexpr unsigned long get_max_prefetch_distance()
+    {
+        return 64u;
+    }
+    /// Get the multimodular multiplication flag.
+    /**
+     * If this flag is \p true, the dense multiplication of polynomials with Kronecker monomials and integral
+     * coefficients (see piranha::series_multiplier) will reduce the coefficients of the operands modulo a set of
+     * word-sized primes, multiply the operands modulo each prime with machine arithmetic, and reconstruct the
+     * coefficients of the result via the Chinese remainder theorem. The number of primes is chosen so that their
+     * product exceeds twice a bound on the absolute value of the coefficients of the result, so that the
+     * reconstruction is exact.
+     *
+     * This mode is faster than the multiprecision accumulation of the products when the coefficients of the
+     * operands are large, but it is used only if the coefficient bound requires at most 16 primes of 63 bits
+     * (i.e., if twice the bound is less than about \f$ 2^{1008} \f$).
+     *
+     * The default value of this flag is \p false.
+     *
+     * @return the multimodular multiplication flag.
+     */
+    static bool get_multimodular_multiplication()
+    {
+        return s_mult_multimodular.load();
+    }
+    /// Set the multimodular multiplication flag.
+    /**
+     * @see piranha::tuning::get_multimodular_multiplication() for an explanation of the meaning of this value.
+     *
+     * @param flag desired value for the multimodular multiplication flag.
+     */
+    static void set_multimodular_multiplication(bool flag)
+    {
+        s_mult_multimodular.store(flag);
+    }
+    /// Reset the multimodular multiplication flag.
+    /**
+     * This method will set the multimodular multiplication flag to \p false.
+     *
+     * @see piranha::tuning::get_multimodular_multiplication() for an explanation of the meaning of this value.
+     */
+    static void reset_multimodular_multiplication()
+    {
+        s_mult_multimodular.store(false);
+    }
+    /// Get the node arena flag.
+    /**
+     * If this flag is \p true, the series multipliers will enable the node arena in the hash set of the result of
+     * the multiplication (see piranha::hash_set::_set_node_arena()). With the node arena, the terms of the result
+     * which do not fit in the array of buckets are allocated from large slabs of memory instead of individually,
+     * and they are freed all at once when the series is destroyed. This reduces the cost of building and
+     * destroying large series, at the price of a slightly higher memory usage.
+     *
+     * The default value of this flag is \p false.
+     *
+     * @return the node arena flag.
+     */
+    static bool get_node_arena()
+    {
+        return s_node_arena.load();
+    }
+    /// Set the node arena flag.
+    /**
+     * @see piranha::tuning::get_node_arena() for an explanation of the meaning of this value.
+     *
+     * @param flag desired value for the node arena flag.
+     */
+    static void set_node_arena(bool flag)
+    {
+        s_node_arena.store(flag);
+    }
+    /// Reset the node arena flag.
+    /**
+     * This method will set the node arena flag to \p false.
+     *
+     * @see piranha::tuning::get_node_arena() for an explanation of the meaning of this value.
+     */
+    static void reset_node_arena()
+    {
+        s_node_arena.store(false);
+    }
+    /// Get the exponentiation strategy.
+    /**
+     * This value determines the algorithm used by piranha::series::pow() (and by its overrides) to compute the
+     * natural powers of series with more than one term:
+     * - piranha::pow_strategy::cached computes all the powers up to the requested one via repeated multiplications
+     *   by the base, and stores them in the cache of natural powers, so that subsequent exponentiations of the same
+     *   base are cheap;
+     * - piranha::pow_strategy::binary computes the power via repeated squaring, without using the cache (if the
+     *   multiplication of the intermediate powers is not supported, the cached strategy is used);
+     * - piranha::pow_strategy::multinomial computes the power of a polynomial with a nonzero constant term
+     *   homogeneous component by homogeneous component, via the recurrence of J.C.P. Miller (see
+     *   piranha::polynomial::pow()), without using the cache. For other series (or if the recurrence is not
+     *   applicable), the cached strategy is used;
+     * - with piranha::pow_strategy::automatic, the cached strategy is used if the power is already in the cache,
+     *   or if the coefficients are not mp++ integers or rationals (so that, with floating-point coefficients, the
+     *   result does not depend on the history of the cache). Otherwise, the multinomial recurrence (for
+     *   polynomials) or the repeated squaring (for series whose square does not have many more terms than the
+     *   base) are used instead, if they are expected to be faster. The results of these algorithms are not
+     *   stored in the cache, so that repeated exponentiations of the same base to consecutive exponents (as
+     *   performed, e.g., by the substitution methods of series) compute each power from scratch.
+     *
+     * The default value is piranha::pow_strategy::cached.
+     *
+     * @return the exponentiation strategy.
+     */
+    static pow_strategy get_pow_strategy()
+    {
+        return s_pow_strategy.load();
+    }
+    /// Set the exponentiation strategy.
+    /**
+     * @see piranha::tuning::get_pow_strategy() for an explanation of the meaning of this value.
+     *
+     * @param s desired exponentiation strategy.
+     */
+    static void set_pow_strategy(pow_strategy s)
+    {
+        s_pow_strategy.store(s);
+    }
+    /// Reset the exponentiation strategy.
+    /**
+     * This method will set the exponentiation strategy to piranha::pow_strategy::cached.
+     *
+     * @see piranha::tuning::get_pow_strategy() for an explanation of the meaning of this value.
+     */
+    static void reset_pow_strategy()
+    {
+        s_pow_strategy.store(pow_strategy::cached);
+    }
 };
 }
 
@@ -46,6 +46,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/python/stl_iterator.hpp>
 #include <boost/python/tuple.hpp>
 #include <cstddef>
+#include <cstring>
 #include <ios>
 #include <limits>
 #include <locale>
@@ -287,6 +288,89 @@ inline auto lambdified_call_operator(piranha::math::lambdified<T, U> &l, bp::obj
     return l(values);
 }
 
+// RAII wrapper for Python buffers.
+struct buffer_guard {
+    explicit buffer_guard(Py_buffer &view) : m_view(view) {}
+    ~buffer_guard()
+    {
+        ::PyBuffer_Release(&m_view);
+    }
+    Py_buffer &m_view;
+};
+
+// Batch evaluation of double-precision lambdified objects on a bidimensional C- or Fortran-contiguous
+// buffer of doubles (e.g., a NumPy array), read without copies. Returns false if o is not such a buffer.
+template <typename T>
+inline bool lambdified_buffer_batch(piranha::math::lambdified<T, double> &l, bp::object o, bp::list &retval)
+{
+    if (!::PyObject_CheckBuffer(o.ptr())) {
+        return false;
+    }
+    Py_buffer view;
+    if (::PyObject_GetBuffer(o.ptr(), &view, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+        ::PyErr_Clear();
+        return false;
+    }
+    buffer_guard bg(view);
+    if (view.ndim != 2 || view.itemsize != static_cast<Py_ssize_t>(sizeof(double)) || view.format == nullptr
+        || std::strcmp(view.format, "d") != 0) {
+        return false;
+    }
+    const auto n_points = view.shape[0], n_names = view.shape[1];
+    piranha::math::points_layout layout;
+    if (view.strides[1] == view.itemsize && view.strides[0] == view.itemsize * n_names) {
+        layout = piranha::math::points_layout::row_major;
+    } else if (view.strides[0] == view.itemsize && view.strides[1] == view.itemsize * n_points) {
+        layout = piranha::math::points_layout::col_major;
+    } else {
+        return false;
+    }
+    if (static_cast<std::size_t>(n_names) != l.get_names().size()) {
+        ::PyErr_SetString(PyExc_ValueError, "the number of columns of the array of points differs from the "
+                                            "number of evaluation variables");
+        bp::throw_error_already_set();
+    }
+    for (const auto &r :
+         l.evaluate_batch(static_cast<const double *>(view.buf), static_cast<std::size_t>(n_points), layout)) {
+        retval.append(r);
+    }
+    return true;
+}
+
+template <typename T, typename U>
+inline bool lambdified_buffer_batch(piranha::math::lambdified<T, U> &, bp::object, bp::list &)
+{
+    return false;
+}
+
+// Batch evaluation wrapper. The points are given as a sequence of points, each one being a sequence of values.
+template <typename T, typename U>
+inline bp::list lambdified_evaluate_batch(piranha::math::lambdified<T, U> &l, bp::object o)
+{
+    bp::list retval;
+    if (lambdified_buffer_batch(l, o, retval)) {
+        return retval;
+    }
+    const auto n_names = l.get_names().size();
+    std::vector<U> points;
+    std::size_t n_points = 0u;
+    bp::stl_input_iterator<bp::object> it(o), end;
+    for (; it != end; ++it, ++n_points) {
+        bp::stl_input_iterator<U> it_p(*it), end_p;
+        const auto old_size = points.size();
+        points.insert(points.end(), it_p, end_p);
+        if (points.size() - old_size != n_names) {
+            ::PyErr_SetString(PyExc_ValueError,
+                              "the number of values of a point differs from the number of evaluation variables");
+            bp::throw_error_already_set();
+        }
+    }
+    for (const auto &r : l.evaluate_batch(points, n_points)) {
+        retval.append(r);
+    }
+    return retval;
+}
+
 template <typename T, typename U>
 inline std::string lambdified_repr(const piranha::math::lambdified<T, U> &l)
 {
@@ -326,6 +410,8 @@ inline void generic_expose_lambdified()
     class_inst.def("__deepcopy__", generic_deepcopy_wrapper<l_type>);
     // The call operator.
     class_inst.def("__call__", lambdified_call_operator<S, U>);
+    // Batch evaluation.
+    class_inst.def("evaluate_batch", lambdified_evaluate_batch<S, U>);
     // The repr.
     class_inst.def("__repr__", lambdified_repr<S, U>);
     // Update the exposition counter.
@@ -920,6 +920,17 @@ def lambdify(t, x, names, extra_map={}):
 
     The output value is :math:`1+2+\\sqrt{5}`.
 
+    The returned object also has an ``evaluate_batch()`` method, which evaluates *x* at many points at once. The
+    points are passed as a sequence of collections of length ``len(names)``, and the method returns a list with the
+    results of the evaluation at each point. If *t* is :class:`float`, bidimensional C- or Fortran-contiguous
+    arrays of doubles (e.g., NumPy arrays) are read without copies, the points being the rows of the array.
+    Non-contiguous arrays, arrays of other types and any input if *t* is not :class:`float` are iterated over
+    as sequences of points, whose values are copied and converted to *t*. In all cases, the results are returned
+    in a Python :class:`list`:
+
+    >>> l.evaluate_batch([[1.,2.],[3.,1.]]) # doctest: +ELLIPSIS
+    [5.236067977..., 7.162277660...]
+
     :param t: the type that will be used for the evaluation of *x*
     :type t: a supported evaluation type
     :param x: symbolic object that will be evaluated
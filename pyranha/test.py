@@ -607,8 +607,24 @@ class math_test_case(_ut.TestCase):
             self.assertAlmostEqual(
                 l(array([1.2, 3.4, 5.6])), 3 * 5.6**4 / 2 - 1.2 / 3 + 3.4**2)
             self.assertEqual(type(l(array([1.2, 3.4, 5.6]))), float)
+            # Batch evaluation on arrays, with both memory layouts.
+            pts = array([[1.2, 3.4, 5.6], [-1., .5, 2.], [0., 1., -3.]])
+            res = [l(list(_)) for _ in pts]
+            self.assertEqual(l.evaluate_batch(pts), res)
+            self.assertEqual(l.evaluate_batch(array(pts, order='F')), res)
+            self.assertEqual(l.evaluate_batch(pts[::2]), res[::2])
+            self.assertRaises(ValueError, lambda: l.evaluate_batch(pts[:, :2]))
         except ImportError:
             pass
+        # Batch evaluation on sequences.
+        l = lambdify(float, 3 * x**4 / 2 - y / 3 + z**2, ['y', 'z', 'x'])
+        self.assertEqual(l.evaluate_batch([[1.2, 3.4, 5.6], [-1., .5, 2.]]),
+                         [l([1.2, 3.4, 5.6]), l([-1., .5, 2.])])
+        self.assertEqual(l.evaluate_batch([]), [])
+        self.assertRaises(ValueError, lambda: l.evaluate_batch([[1.2, 3.4]]))
+        l = lambdify(F, 3 * x**4 / 2 - y / 3 + z**2, ['y', 'z'], {'x': lambda a: a[0] + a[1]})
+        self.assertEqual(l.evaluate_batch([[F(1, 2), F(3, 4)], [F(1), F(2)]]),
+                         [l([F(1, 2), F(3, 4)]), l([F(1), F(2)])])
 
 
 class polynomial_test_case(_ut.TestCase):
@@ -44,11 +44,13 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 #include <vector>
 
+#include <piranha/estimation_log.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/kronecker_monomial.hpp>
 #include <piranha/monomial.hpp>
 #include <piranha/polynomial.hpp>
 #include <piranha/rational.hpp>
+#include <piranha/runtime_info.hpp>
 #include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/tuning.hpp>
@@ -63,6 +65,7 @@ template <typename Series>
 struct m_checker : public base_series_multiplier<Series> {
     using base = base_series_multiplier<Series>;
     using size_type = typename base::size_type;
+    using mf_type = typename base::template plain_multiplier<false>;
     explicit m_checker(const Series &s1, const Series &s2) : base(s1, s2)
     {
         BOOST_CHECK(!std::is_constructible<base>::value);
@@ -155,6 +158,16 @@ struct m_checker : public base_series_multiplier<Series> {
     {
         return base::template estimate_final_series_size<N, MultFunctor>(std::forward<Args>(args)...);
     }
+    template <std::size_t N, typename MultFunctor, typename... Args>
+    typename base::size_estimate sample_final_series_size(Args &&... args) const
+    {
+        return base::template sample_final_series_size<N, MultFunctor>(std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    bool cached_final_series_size(Args &&... args) const
+    {
+        return base::cached_final_series_size(std::forward<Args>(args)...);
+    }
     template <typename... Args>
     static void sanitise_series(Args &&... args)
     {
@@ -170,6 +183,20 @@ struct m_checker : public base_series_multiplier<Series> {
     {
         base::finalise_series(std::forward<Args>(args)...);
     }
+    template <typename... Args>
+    static std::pair<typename Series::size_type, typename Series::size_type> tile_sizes(Args &&... args)
+    {
+        return base::tile_sizes(std::forward<Args>(args)...);
+    }
+    static std::size_t term_footprint()
+    {
+        return base::term_footprint();
+    }
+    template <typename F>
+    auto pack_terms(const F &f) const -> decltype(base::pack_terms(this->m_v1, f))
+    {
+        return base::pack_terms(this->m_v1, f);
+    }
     unsigned get_n_threads() const
     {
         return this->m_n_threads;
@@ -267,6 +294,8 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_blocked_multiplication_test)
     // Take out one term in order to make it exactly 100 terms.
     s1 -= 1345860629046814650_z * x.pow(16) * y.pow(84);
     m_checker<pt> m0(s1, s1);
+    // Disable the automatic tiling, so that the block size set below is used.
+    tuning::set_multiplication_auto_tiling(false);
     tuning::set_multiplication_block_size(16u);
     m_functor_0 mf0;
     m0.blocked_multiplication(mf0, 0u, 100u);
@@ -382,6 +411,27 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_blocked_multiplication_test)
     BOOST_CHECK_NO_THROW(m1.blocked_multiplication(mf1, 0u, 0u));
     // Final reset of the mult block size.
     tuning::reset_multiplication_block_size();
+    // Tile sizes.
+    BOOST_CHECK(m_checker<pt>::term_footprint() > sizeof(pt::term_type));
+    BOOST_CHECK(m_checker<pt>::tile_sizes(32u, 16u) == std::make_pair(pt::size_type(256u), pt::size_type(256u)));
+    tuning::reset_multiplication_auto_tiling();
+    const auto ts = m_checker<pt>::tile_sizes(32u, 16u);
+    BOOST_CHECK(ts.first >= 16u && ts.first <= 4096u);
+    BOOST_CHECK(ts.second >= 16u && ts.second <= 4096u);
+    if (runtime_info::get_cache_size(1u) && runtime_info::get_cache_size(2u)) {
+        BOOST_CHECK(m_checker<pt>::tile_sizes(1u, 1u) == std::make_pair(pt::size_type(4096u), pt::size_type(4096u)));
+        BOOST_CHECK(m_checker<pt>::tile_sizes(1u << 20, 1u << 20)
+                    == std::make_pair(pt::size_type(16u), pt::size_type(16u)));
+    } else {
+        BOOST_CHECK(ts == std::make_pair(pt::size_type(256u), pt::size_type(256u)));
+    }
+    // Run the multiplication with the automatic tiling.
+    mf0.m_set.clear();
+    m0.blocked_multiplication(mf0, 0u, 100u);
+    BOOST_CHECK(mf0.m_set.size() == 100u * 100u);
+    mf0.m_set.clear();
+    m0.blocked_multiplication(mf0, 20u, 87u, l_functor_0{2u});
+    BOOST_CHECK(mf0.m_set.size() == (87u - 20u) * 2u);
 }
 
 BOOST_AUTO_TEST_CASE(base_series_multiplier_estimate_final_series_size_test)
@@ -445,6 +495,89 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_estimate_final_series_size_test)
     settings::reset_n_threads();
 }
 
+BOOST_AUTO_TEST_CASE(base_series_multiplier_sample_final_series_size_test)
+{
+    using pt = p_type<integer>;
+    using mf_type = m_checker<pt>::mf_type;
+    settings::set_min_work_per_thread(1u);
+    pt x("x"), y("y"), z("z"), t("t");
+    auto f = (x + y + z + t + 1).pow(6), g = f + 1;
+    // Dense operands.
+    settings::set_n_threads(1u);
+    const auto se1 = m_checker<pt>(f, g).sample_final_series_size<1u, mf_type>();
+    BOOST_CHECK(se1.m_lower <= se1.m_value && se1.m_value <= se1.m_upper);
+    BOOST_CHECK(se1.m_lower >= 1u);
+    BOOST_CHECK(se1.m_n_trials >= 15u && se1.m_n_trials <= 60u && se1.m_n_trials % 15u == 0u);
+    BOOST_CHECK_EQUAL(se1.m_n_saturated, 0u);
+    // The result does not depend on the number of threads.
+    for (auto nt = 2u; nt < 4u; ++nt) {
+        settings::set_n_threads(nt);
+        const auto se2 = m_checker<pt>(f, g).sample_final_series_size<1u, mf_type>();
+        BOOST_CHECK_EQUAL(se1.m_value, se2.m_value);
+        BOOST_CHECK_EQUAL(se1.m_lower, se2.m_lower);
+        BOOST_CHECK_EQUAL(se1.m_upper, se2.m_upper);
+        BOOST_CHECK_EQUAL(se1.m_n_trials, se2.m_n_trials);
+    }
+    // Very sparse operands: no duplicates can be found.
+    pt a = y - y, b = x - x;
+    for (int i = 0; i < 30; ++i) {
+        a += x.pow(i);
+        b += y.pow(i);
+    }
+    const auto se3 = m_checker<pt>(a, b).sample_final_series_size<1u, mf_type>();
+    BOOST_CHECK_EQUAL(se3.m_value, 900u);
+    BOOST_CHECK_EQUAL(se3.m_n_saturated, se3.m_n_trials);
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
+BOOST_AUTO_TEST_CASE(base_series_multiplier_estimation_cache_test)
+{
+    using pt = p_type<integer>;
+    using mf_type = m_checker<pt>::mf_type;
+    pt x("x"), y("y"), z("z"), t("t");
+    auto f = (x + y + z + t + 1).pow(10), g = f + 1;
+    estimation_log::clear();
+    BOOST_CHECK(!estimation_log::get_enabled());
+    BOOST_CHECK(!tuning::get_estimate_cache());
+    // Nothing is logged or cached while disabled.
+    auto res = f * g;
+    BOOST_CHECK(estimation_log::get_records().empty());
+    pt::size_type cached = 0u;
+    BOOST_CHECK(!m_checker<pt>(f, g).cached_final_series_size(cached));
+    estimation_log::set_enabled(true);
+    tuning::set_estimate_cache(true);
+    res = f * g;
+    auto records = estimation_log::get_records();
+    BOOST_CHECK_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(records[0].m_size1, f.size());
+    BOOST_CHECK_EQUAL(records[0].m_size2, g.size());
+    BOOST_CHECK_EQUAL(records[0].m_actual, res.size());
+    BOOST_CHECK(records[0].m_estimate > 0u);
+    // The actual size is now in the cache, also for swapped operands.
+    BOOST_CHECK(m_checker<pt>(f, g).cached_final_series_size(cached));
+    BOOST_CHECK_EQUAL(cached, res.size());
+    BOOST_CHECK(m_checker<pt>(g, f).cached_final_series_size(cached));
+    BOOST_CHECK_EQUAL(cached, res.size());
+    BOOST_CHECK_EQUAL((m_checker<pt>(f, g).estimate_final_series_size<1u, mf_type>()), res.size());
+    // Different operands are not in the cache.
+    BOOST_CHECK(!m_checker<pt>(f, g * x).cached_final_series_size(cached));
+    // Truncated estimations do not use the cache.
+    BOOST_CHECK((m_checker<pt>(f, g).estimate_final_series_size<1u, mf_type>(l_functor_0{0u})) == 1u);
+    // The second multiplication is logged with the exact estimate.
+    res = f * g;
+    records = estimation_log::get_records();
+    BOOST_CHECK_EQUAL(records.size(), 2u);
+    BOOST_CHECK_EQUAL(records[1].m_estimate, res.size());
+    BOOST_CHECK_EQUAL(records[1].m_actual, res.size());
+    estimation_log::set_enabled(false);
+    res = f * g;
+    BOOST_CHECK_EQUAL(estimation_log::get_records().size(), 2u);
+    estimation_log::clear();
+    BOOST_CHECK(estimation_log::get_records().empty());
+    tuning::reset_estimate_cache();
+}
+
 BOOST_AUTO_TEST_CASE(base_series_multiplier_sanitise_series_test)
 {
     using pt = p_type<integer>;
@@ -673,7 +806,7 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_finalise_test)
         using mt = m_checker<pt>;
         for (unsigned nt = 1u; nt <= 4u; ++nt) {
             settings::set_n_threads(nt);
-            // Setup a multiplier for a polyomial with two variables and lcm 6.
+            // Setup a multiplier for two polyomials with two variables and lcms 3 and 2.
             auto tmp1 = pt{"x"} / 3 + pt{"y"}, tmp2 = pt{"y"} / 2 + pt{"x"};
             mt m0{tmp1, tmp2};
             // First let's try with an empty retval.
@@ -684,11 +817,11 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_finalise_test)
             // Put in one term.
             r += pt{"x"};
             BOOST_CHECK_NO_THROW(m0.finalise_series(r));
-            BOOST_CHECK_EQUAL(r, pt{"x"} / 36);
+            BOOST_CHECK_EQUAL(r, pt{"x"} / 6);
             // Put in another term.
             r += 12 * pt{"y"};
             BOOST_CHECK_NO_THROW(m0.finalise_series(r));
-            BOOST_CHECK_EQUAL(r, pt{"x"} / 36 + pt{"y"} / 3);
+            BOOST_CHECK_EQUAL(r, pt{"x"} / 6 + 2 * pt{"y"});
         }
     }
     {
@@ -697,7 +830,7 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_finalise_test)
         using mt = m_checker<pt>;
         for (unsigned nt = 1u; nt <= 4u; ++nt) {
             settings::set_n_threads(nt);
-            // Setup a multiplier for a polyomial with two variables and lcm 6.
+            // Setup a multiplier for two polyomials with two variables and lcms 3 and 2.
             auto tmp1 = pt{"x"} / 3 + pt{"y"}, tmp2 = pt{"y"} / 2 + pt{"x"};
             mt m0{tmp1, tmp2};
             // First let's try with an empty retval.
@@ -708,14 +841,50 @@ BOOST_AUTO_TEST_CASE(base_series_multiplier_finalise_test)
             // Put in one term.
             r += pt{"x"};
             BOOST_CHECK_NO_THROW(m0.finalise_series(r));
-            BOOST_CHECK_EQUAL(r, pt{"x"} / 36);
+            BOOST_CHECK_EQUAL(r, pt{"x"} / 6);
             // Put in another term.
             r += 12 * pt{"y"};
             BOOST_CHECK_NO_THROW(m0.finalise_series(r));
-            BOOST_CHECK_EQUAL(r, pt{"x"} / 36 + pt{"y"} / 3);
+            BOOST_CHECK_EQUAL(r, pt{"x"} / 6 + 2 * pt{"y"});
         }
     }
     // Reset.
     settings::reset_n_threads();
     settings::reset_min_work_per_thread();
 }
+
+BOOST_AUTO_TEST_CASE(base_series_multiplier_pack_terms_test)
+{
+    {
+        using pt = polynomial<integer, k_monomial>;
+        using mt = m_checker<pt>;
+        pt x{"x"}, y{"y"};
+        const auto p1 = (x + 2 * y + 3).pow(4), p2 = x - y;
+        mt m0{p1, p2};
+        const auto packed = m0.pack_terms([](const k_monomial &k) { return k.get_int(); });
+        BOOST_CHECK((std::is_same<decltype(packed.m_keys), std::vector<k_monomial::value_type>>::value));
+        BOOST_CHECK_EQUAL(packed.m_keys.size(), p1.size());
+        BOOST_CHECK_EQUAL(packed.m_cfs.size(), p1.size());
+        // Check that each packed key/cf pair corresponds to a term of p1.
+        for (decltype(packed.m_keys.size()) i = 0u; i < packed.m_keys.size(); ++i) {
+            const auto it = p1._container().find(pt::term_type{integer{}, k_monomial(packed.m_keys[i])});
+            BOOST_CHECK(it != p1._container().end());
+            BOOST_CHECK_EQUAL(it->m_cf, *packed.m_cfs[i]);
+        }
+        // Empty series.
+        mt m1{pt{}, pt{}};
+        BOOST_CHECK(m1.pack_terms([](const k_monomial &k) { return k.get_int(); }).m_keys.empty());
+    }
+    {
+        // Rational coefficients are packed after the rescaling to integral values.
+        using pt = p_type<rational>;
+        using mt = m_checker<pt>;
+        pt x{"x"}, y{"y"};
+        mt m0{x / 3 + y / 2, x * y};
+        const auto packed = m0.pack_terms([](const monomial<int> &m) { return m.size(); });
+        BOOST_CHECK_EQUAL(packed.m_cfs.size(), 2u);
+        for (const auto c : packed.m_cfs) {
+            BOOST_CHECK_EQUAL(c->get_den(), 1);
+        }
+    }
+}
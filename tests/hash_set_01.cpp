@@ -32,6 +32,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/included/unit_test.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <boost/integer_traits.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
@@ -52,6 +53,7 @@ see https://www.gnu.org/licenses/. */
 #include <type_traits>
 
 #include <piranha/config.hpp>
+#include <piranha/detail/atomic_flag_array.hpp>
 #include <piranha/exceptions.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/s11n.hpp>
@@ -675,6 +677,229 @@ BOOST_AUTO_TEST_CASE(hash_set_mt_test)
     }
 }
 
+// An int with a counter which is not considered in hashing and comparison.
+struct counted_int {
+    bool operator==(const counted_int &other) const
+    {
+        return m_n == other.m_n;
+    }
+    int m_n;
+    mutable int m_count;
+};
+
+struct counted_int_hasher {
+    std::size_t operator()(const counted_int &c) const
+    {
+        return std::hash<int>{}(c.m_n);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(hash_set_concurrent_insert_test)
+{
+    using h_type = hash_set<counted_int, counted_int_hasher>;
+    const int n_items = 10000;
+    for (unsigned n_threads = 1u; n_threads <= 4u; ++n_threads) {
+        thread_pool::resize(n_threads);
+        // Try with lock arrays smaller than, equal to and larger than the number of buckets.
+        for (std::size_t n_locks = 1u; n_locks <= 1u << 16u; n_locks <<= 5u) {
+            h_type h(n_items / 10);
+            detail::atomic_flag_array locks(n_locks);
+            // Each thread inserts the same items, so that most insertions will find an existing item.
+            std::atomic<int> tot_inserted(0);
+            auto inserter = [&h, &locks, &tot_inserted, n_items]() {
+                int n_inserted = 0;
+                for (int i = 0; i < n_items; ++i) {
+                    const counted_int tmp{i, 1};
+                    n_inserted += h._concurrent_insert(tmp, h._bucket(tmp), locks,
+                                                       [](const counted_int &c, const counted_int &) { ++c.m_count; });
+                }
+                tot_inserted += n_inserted;
+            };
+            future_list<void> f_list;
+            for (unsigned i = 0u; i < n_threads; ++i) {
+                f_list.push_back(thread_pool::enqueue(i, inserter));
+            }
+            f_list.wait_all();
+            f_list.get_all();
+            BOOST_CHECK_EQUAL(tot_inserted.load(), n_items);
+            h._update_size(static_cast<h_type::size_type>(n_items));
+            BOOST_CHECK_EQUAL(h.size(), static_cast<h_type::size_type>(n_items));
+            for (int i = 0; i < n_items; ++i) {
+                const auto it = h.find(counted_int{i, 0});
+                BOOST_CHECK(it != h.end());
+                BOOST_CHECK_EQUAL(it->m_count, static_cast<int>(n_threads));
+            }
+        }
+    }
+    thread_pool::resize(1u);
+}
+
+BOOST_AUTO_TEST_CASE(hash_set_pipeline_test)
+{
+    using h_type = hash_set<counted_int, counted_int_hasher>;
+    std::uniform_int_distribution<int> dist(0, 999);
+    for (h_type::size_type distance = 0u; distance <= 64u; distance = distance ? distance * 4u : 1u) {
+        h_type h(1000u);
+        std::map<int, int> cmp;
+        h_type::_pipeline<void (*)(const counted_int &, const counted_int &)> pipeline(
+            h, [](const counted_int &c, const counted_int &other) { c.m_count += other.m_count; }, distance);
+        for (int i = 0; i < ntries * 10; ++i) {
+            const auto n = dist(rng);
+            // Alternate between lvalue and rvalue pushes.
+            if (i % 2) {
+                const counted_int tmp{n, i};
+                pipeline.push(tmp);
+            } else {
+                pipeline.push(counted_int{n, i});
+            }
+            cmp[n] += i;
+        }
+        pipeline.flush();
+        // Flushing an empty pipeline is a no-op.
+        pipeline.flush();
+        h._update_size(static_cast<h_type::size_type>(cmp.size()));
+        BOOST_CHECK_EQUAL(h.size(), cmp.size());
+        for (const auto &p : cmp) {
+            const auto it = h.find(counted_int{p.first, 0});
+            BOOST_CHECK(it != h.end());
+            BOOST_CHECK_EQUAL(it->m_count, p.second);
+        }
+    }
+    using p_type = h_type::_pipeline<void (*)(const counted_int &, const counted_int &)>;
+    auto adder = [](const counted_int &c, const counted_int &other) { c.m_count += other.m_count; };
+    // The destructor discards the pending insertions.
+    BOOST_CHECK(std::is_nothrow_destructible<p_type>::value);
+    {
+        h_type h2(100u);
+        {
+            p_type pipeline(h2, adder, 16u);
+            for (int i = 0; i < 10; ++i) {
+                pipeline.push(counted_int{i, 1});
+            }
+        }
+        for (int i = 0; i < 10; ++i) {
+            BOOST_CHECK(h2.find(counted_int{i, 0}) == h2.end());
+        }
+    }
+    // Also when the pipeline is destroyed because of an exception.
+    {
+        h_type h2(100u);
+        try {
+            p_type pipeline(h2, adder, 16u);
+            for (int i = 0; i < 10; ++i) {
+                pipeline.push(counted_int{i, 1});
+            }
+            throw std::runtime_error("");
+        } catch (const std::runtime_error &) {
+        }
+        for (int i = 0; i < 10; ++i) {
+            BOOST_CHECK(h2.find(counted_int{i, 0}) == h2.end());
+        }
+    }
+    // Check prefetching is harmless.
+    h_type h(10u);
+    for (h_type::size_type i = 0u; i < h.bucket_count(); ++i) {
+        h._prefetch_bucket(i);
+    }
+    BOOST_CHECK(h.empty());
+}
+
+struct node_arena_tester {
+    template <typename T>
+    void operator()(const T &)
+    {
+        // NOTE: use spaced values in order to have long collision chains.
+        auto lc = [](int n) { return boost::lexical_cast<T>(n * 64); };
+        hash_set<T> h;
+        BOOST_CHECK(!h._has_node_arena());
+        h._set_node_arena(true);
+        BOOST_CHECK(h._has_node_arena());
+        for (int i = 0; i < N; ++i) {
+            BOOST_CHECK(h.insert(lc(i)).second);
+        }
+        BOOST_CHECK_EQUAL(h.size(), unsigned(N));
+        BOOST_CHECK(h._has_node_arena());
+        BOOST_CHECK_THROW(h._set_node_arena(false), std::invalid_argument);
+        // Erase half of the elements, and insert them back, so that the nodes are recycled.
+        for (int i = 0; i < N; i += 2) {
+            h.erase(h.find(lc(i)));
+        }
+        BOOST_CHECK_EQUAL(h.size(), unsigned(N / 2));
+        for (int i = 0; i < N; ++i) {
+            BOOST_CHECK((h.find(lc(i)) == h.end()) == (i % 2 == 0));
+        }
+        for (int i = 0; i < N; i += 2) {
+            BOOST_CHECK(h.insert(lc(i)).second);
+        }
+        BOOST_CHECK_EQUAL(h.size(), unsigned(N));
+        // Copy, move and swap.
+        auto h2(h);
+        BOOST_CHECK(h2._has_node_arena());
+        BOOST_CHECK_EQUAL(h2.size(), unsigned(N));
+        for (int i = 0; i < N; ++i) {
+            BOOST_CHECK(h2.find(lc(i)) != h2.end());
+        }
+        auto h3(std::move(h2));
+        BOOST_CHECK(h3._has_node_arena());
+        BOOST_CHECK(!h2._has_node_arena());
+        hash_set<T> h4;
+        h4.swap(h3);
+        BOOST_CHECK(h4._has_node_arena());
+        BOOST_CHECK(!h3._has_node_arena());
+        h3 = h4;
+        BOOST_CHECK(h3._has_node_arena());
+        BOOST_CHECK_EQUAL(h3.size(), unsigned(N));
+        // Rehash.
+        h4.rehash(h4.bucket_count() * 4u);
+        BOOST_CHECK(h4._has_node_arena());
+        BOOST_CHECK_EQUAL(h4.size(), unsigned(N));
+        for (int i = 0; i < N; ++i) {
+            BOOST_CHECK(h4.find(lc(i)) != h4.end());
+        }
+        // Clearing the set preserves the arena.
+        h4.clear();
+        BOOST_CHECK(h4._has_node_arena());
+        BOOST_CHECK(h4.insert(lc(0)).second);
+        BOOST_CHECK(h4.insert(lc(1)).second);
+        h4.clear();
+        h4._set_node_arena(false);
+        BOOST_CHECK(!h4._has_node_arena());
+        BOOST_CHECK(h4.insert(lc(0)).second);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(hash_set_node_arena_test)
+{
+    boost::mpl::for_each<key_types>(node_arena_tester());
+    // Concurrent insertions.
+    using h_type = hash_set<counted_int, counted_int_hasher>;
+    const int n_items = 10000;
+    for (unsigned n_threads = 1u; n_threads <= 4u; ++n_threads) {
+        thread_pool::resize(n_threads);
+        h_type h;
+        h._set_node_arena(true);
+        h.rehash(n_items / 64);
+        detail::atomic_flag_array locks(1024u);
+        auto inserter = [&h, &locks, n_items](unsigned t_idx, unsigned n) {
+            for (int i = static_cast<int>(t_idx); i < n_items; i += static_cast<int>(n)) {
+                const counted_int tmp{i * 64, 1};
+                h._concurrent_insert(tmp, h._bucket(tmp), locks, [](const counted_int &, const counted_int &) {});
+            }
+        };
+        future_list<void> f_list;
+        for (unsigned i = 0u; i < n_threads; ++i) {
+            f_list.push_back(thread_pool::enqueue(i, inserter, i, n_threads));
+        }
+        f_list.wait_all();
+        f_list.get_all();
+        h._update_size(static_cast<h_type::size_type>(n_items));
+        for (int i = 0; i < n_items; ++i) {
+            BOOST_CHECK(h.find(counted_int{i * 64, 0}) != h.end());
+        }
+    }
+    thread_pool::resize(1u);
+}
+
 #if defined(PIRANHA_WITH_BOOST_S11N)
 
 BOOST_AUTO_TEST_CASE(hash_set_serialization_test)
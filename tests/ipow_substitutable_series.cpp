@@ -410,6 +410,24 @@ BOOST_AUTO_TEST_CASE(ipow_subs_series_subs_test)
         auto tmp = (x1.pow(3) * x2.pow(2) * y * z * 4 / 3_q + 2 * t).ipow_subs("x", 2, 3);
         BOOST_CHECK_EQUAL(tmp, x1 * 3 * 3 * y * z * 4 / 3_q + 2 * t);
     }
+    {
+        // Batched substitution: compare with the substitution computed term by term.
+        stype0 x{"x"}, y{"y"}, z{"z"};
+        stype0 p{1};
+        for (int i = 0; i < 12; ++i) {
+            p = p * (x + 2 * y - z / 3 + 1);
+        }
+        for (int n = 1; n < 4; ++n) {
+            stype0 ref{0};
+            for (const auto &t : p._container()) {
+                stype0 tmp;
+                tmp.set_symbol_set(p.get_symbol_set());
+                tmp.insert(t);
+                ref += tmp.ipow_subs("x", n, z - 2);
+            }
+            BOOST_CHECK_EQUAL(p.ipow_subs("x", n, z - 2), ref);
+        }
+    }
 }
 
 #if defined(PIRANHA_WITH_BOOST_S11N)
@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE lambdify_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <cstddef>
 #include <random>
 #include <stdexcept>
 #include <string>
@@ -41,8 +42,10 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/integer.hpp>
 #include <piranha/kronecker_monomial.hpp>
 #include <piranha/math.hpp>
+#include <piranha/monomial.hpp>
 #include <piranha/polynomial.hpp>
 #include <piranha/rational.hpp>
+#include <piranha/settings.hpp>
 
 using namespace piranha;
 using math::evaluate;
@@ -289,3 +292,97 @@ BOOST_AUTO_TEST_CASE(lambdify_test_02)
     en = l2.get_extra_names();
     BOOST_CHECK((en == std::vector<std::string>{"t", "a"} || en == std::vector<std::string>{"a", "t"}));
 }
+
+BOOST_AUTO_TEST_CASE(lambdify_test_03)
+{
+    // Batch evaluation.
+    using p_type = polynomial<rational, k_monomial>;
+    p_type x{"x"}, y{"y"}, z{"z"};
+    std::uniform_real_distribution<double> dist(-2., 2.);
+    const auto p = (x + y / 3 - z + 1).pow(8) * y.pow(-2) + x * z.pow(30) / 7;
+    auto l0 = lambdify<double>(p, {"z", "x", "y", "t"});
+    const std::size_t n_points = 1000u;
+    std::vector<double> rm, cm(4u * n_points);
+    std::vector<double> cmp;
+    for (std::size_t i = 0u; i < n_points; ++i) {
+        std::vector<double> point;
+        for (std::size_t j = 0u; j < 4u; ++j) {
+            point.push_back(dist(rng));
+            cm[j * n_points + i] = point.back();
+        }
+        rm.insert(rm.end(), point.begin(), point.end());
+        cmp.push_back(l0(point));
+    }
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        settings::set_min_work_per_thread(1u);
+        const auto res_rm = l0.evaluate_batch(rm, n_points);
+        BOOST_CHECK(res_rm == cmp);
+        const auto res_cm = l0.evaluate_batch(cm.data(), n_points, math::points_layout::col_major);
+        BOOST_CHECK(res_cm == cmp);
+    }
+    settings::reset_n_threads();
+    settings::reset_min_work_per_thread();
+    // Exponent types narrower than int, with exponents of both signs.
+    {
+        using ps_type = polynomial<rational, monomial<short>>;
+        ps_type xs{"x"}, ys{"y"};
+        const auto ps = (xs + ys / 3 + 1).pow(6) * xs.pow(-3) + ys.pow(-5) - xs * ys.pow(-2);
+        auto ls = lambdify<double>(ps, {"x", "y"});
+        std::vector<double> spoints, scmp;
+        for (std::size_t i = 0u; i < 100u; ++i) {
+            const std::vector<double> point{dist(rng), dist(rng)};
+            spoints.insert(spoints.end(), point.begin(), point.end());
+            scmp.push_back(ls(point));
+        }
+        BOOST_CHECK(ls.evaluate_batch(spoints, 100u) == scmp);
+        auto lq = lambdify<rational>(ps, {"x", "y"});
+        BOOST_CHECK(lq.evaluate_batch(std::vector<rational>{1 / 2_q, -3 / 2_q, -2 / 3_q, 5 / 4_q}, 2u)
+                    == (std::vector<rational>{evaluate<rational>(ps, {{"x", 1 / 2_q}, {"y", -3 / 2_q}}),
+                                              evaluate<rational>(ps, {{"x", -2 / 3_q}, {"y", 5 / 4_q}})}));
+    }
+    // Empty batches and errors.
+    BOOST_CHECK(l0.evaluate_batch(nullptr, 0u).empty());
+    BOOST_CHECK(l0.evaluate_batch(std::vector<double>{}, 0u).empty());
+    BOOST_CHECK_THROW(l0.evaluate_batch(nullptr, 1u), std::invalid_argument);
+    BOOST_CHECK_THROW(l0.evaluate_batch(std::vector<double>{1., 2., 3.}, 1u), std::invalid_argument);
+    BOOST_CHECK_THROW(l0.evaluate_batch(std::vector<double>{1., 2., 3., 4.}, 2u), std::invalid_argument);
+    auto l1 = lambdify<double>(p, {"z", "x"});
+    BOOST_CHECK_THROW(l1.evaluate_batch(std::vector<double>{1., 2.}, 1u), std::invalid_argument);
+    BOOST_CHECK_THROW(l1({1., 2.}), std::invalid_argument);
+    // The evaluation plan is reused across calls, and rebuilt by the copies.
+    BOOST_CHECK(l0(std::vector<double>(rm.begin(), rm.begin() + 4)) == cmp[0u]);
+    auto l0c(l0);
+    BOOST_CHECK(l0c(std::vector<double>(rm.begin() + 4, rm.begin() + 8)) == cmp[1u]);
+    BOOST_CHECK(l0c.evaluate_batch(rm, n_points) == cmp);
+    // Constant series and series without symbols.
+    auto l2 = lambdify<double>(p_type{3}, {});
+    BOOST_CHECK(l2.evaluate_batch(nullptr, 2u) == (std::vector<double>{3., 3.}));
+    auto l3 = lambdify<integer>(p_type{}, {"x"});
+    BOOST_CHECK(l3.evaluate_batch(std::vector<integer>{1_z, 2_z}, 2u) == (std::vector<rational>{0, 0}));
+    // Extra map.
+    const auto p2 = (x + y / 3 - z + 1).pow(5) + x * z.pow(7) / 7;
+    auto l4 = lambdify<integer>(p2, {"x", "y"}, {{"z", [](const std::vector<integer> &v) { return v[0] * v[1]; }}});
+    std::vector<integer> ipoints;
+    std::vector<rational> icmp;
+    for (int i = 1; i < 50; ++i) {
+        ipoints.push_back(integer(i));
+        ipoints.push_back(integer(-i));
+        icmp.push_back(evaluate<integer>(p2, {{"x", integer(i)}, {"y", integer(-i)}, {"z", integer(-i * i)}}));
+    }
+    BOOST_CHECK(l4.evaluate_batch(ipoints, 49u) == icmp);
+    // Series with series coefficients are evaluated point by point.
+    using pp_type = polynomial<p_type, k_monomial>;
+    BOOST_CHECK((!detail::lambdified_has_batch_plan<pp_type, double>::value));
+    BOOST_CHECK((detail::lambdified_has_batch_plan<p_type, double>::value));
+    pp_type a{"a"}, b{"b"};
+    const auto q = (a * x + b / 2 - 1).pow(4);
+    auto l5 = lambdify<double>(q, {"a", "x", "b"});
+    const std::vector<double> qpoints{1., 2., 3., -1., .5, 4.};
+    const auto qres = l5.evaluate_batch(qpoints, 2u);
+    BOOST_CHECK(qres.size() == 2u);
+    BOOST_CHECK(qres[0u] == l5({1., 2., 3.}));
+    BOOST_CHECK(qres[1u] == l5({-1., .5, 4.}));
+    BOOST_CHECK(l5.evaluate_batch(std::vector<double>{1., -1., 2., .5, 3., 4.}, 2u, math::points_layout::col_major)
+                == qres);
+}
@@ -40,6 +40,7 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <mp++/config.hpp>
 #include <mp++/rational.hpp>
@@ -50,6 +51,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/integer.hpp>
 #include <piranha/invert.hpp>
 #include <piranha/key_is_multipliable.hpp>
+#include <piranha/kronecker_monomial.hpp>
 #include <piranha/math.hpp>
 #include <piranha/math/pow.hpp>
 #include <piranha/monomial.hpp>
@@ -61,6 +63,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/series_multiplier.hpp>
 #include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
+#include <piranha/tuning.hpp>
 
 using namespace piranha;
 
@@ -282,3 +285,125 @@ BOOST_AUTO_TEST_CASE(polynomial_subs_test)
             .template subs<integer>({{"x", integer(0)}, {"y", integer(0)}, {"z", integer(0)}, {"k", integer()}}),
         0);
 }
+
+struct pow_strategy_tester {
+    template <typename Cf>
+    void operator()(const Cf &) const
+    {
+        using p_type = polynomial<Cf, monomial<int>>;
+        p_type x{"x"}, y{"y"}, z{"z"}, t{"t"};
+        // Compute the powers via repeated multiplications.
+        auto naive_pow = [](const p_type &p, unsigned n) {
+            p_type retval{1};
+            for (unsigned i = 0u; i < n; ++i) {
+                retval = retval * p;
+            }
+            return retval;
+        };
+        std::vector<p_type> bases{1 + x + y + z + t, 3 - 2 * x + x * y * z - 4 * t * t, x + y * z, x * y - 1,
+                                  2 + x * x * x};
+        if (!std::is_same<Cf, integer>::value) {
+            // Negative degrees and non-unitary keys with zero degree.
+            bases.push_back(1 + x.pow(-1));
+            bases.push_back(1 + x * y.pow(-1));
+        }
+        for (auto s : {pow_strategy::cached, pow_strategy::binary, pow_strategy::multinomial,
+                       pow_strategy::automatic}) {
+            tuning::set_pow_strategy(s);
+            for (const auto &b : bases) {
+                for (unsigned n = 0u; n < 8u; ++n) {
+                    p_type::clear_pow_cache();
+                    const auto ref = naive_pow(b, n);
+                    BOOST_CHECK_EQUAL(b.pow(n), ref);
+                    // Run again, possibly using the cache.
+                    BOOST_CHECK_EQUAL(b.pow(n), ref);
+                }
+            }
+            // Auto-truncation.
+            p_type::set_auto_truncate_degree(3);
+            p_type::clear_pow_cache();
+            BOOST_CHECK_EQUAL((1 + x + y).pow(5), naive_pow(1 + x + y, 5));
+            p_type::unset_auto_truncate_degree();
+            // Invalid exponent.
+            BOOST_CHECK_THROW((1 + x).pow(-1), std::invalid_argument);
+        }
+        // In automatic mode, the multinomial recurrence is used only for exact coefficient types, its results
+        // are not stored in the cache and the powers already in the cache are reused.
+        tuning::set_pow_strategy(pow_strategy::automatic);
+        p_type::clear_pow_cache();
+        p_type::reset_pow_cache_stats();
+        const auto f = 1 + x + y + z + t;
+        BOOST_CHECK_EQUAL(f.pow(5), naive_pow(f, 5));
+        if (std::is_floating_point<Cf>::value) {
+            BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().entries, 1u);
+            BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().misses, 1u);
+        } else {
+            BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().entries, 0u);
+            BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().misses, 0u);
+            tuning::set_pow_strategy(pow_strategy::cached);
+            BOOST_CHECK_EQUAL(f.pow(5), naive_pow(f, 5));
+            BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().misses, 1u);
+            tuning::set_pow_strategy(pow_strategy::automatic);
+        }
+        BOOST_CHECK_EQUAL(f.pow(4), naive_pow(f, 4));
+        BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().hits, 1u);
+        BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().misses, 1u);
+        p_type::clear_pow_cache();
+        tuning::reset_pow_strategy();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(polynomial_pow_strategy_test)
+{
+    boost::mpl::for_each<cf_types>(pow_strategy_tester());
+    // Multivariate polynomials with Kronecker monomials, as in Fateman's benchmarks.
+    using p_type = polynomial<integer, k_monomial>;
+    p_type x{"x"}, y{"y"}, z{"z"}, t{"t"};
+    const auto f = 1 + x + y + z + t;
+    p_type::clear_pow_cache();
+    const auto ref = f.pow(10);
+    for (auto s : {pow_strategy::binary, pow_strategy::multinomial, pow_strategy::automatic}) {
+        tuning::set_pow_strategy(s);
+        p_type::clear_pow_cache();
+        BOOST_CHECK_EQUAL(f.pow(10), ref);
+        BOOST_CHECK_EQUAL(piranha::pow(f, 10), ref);
+    }
+    tuning::reset_pow_strategy();
+    // By default, the powers of exact coefficient types are stored in the cache, so that exponentiations
+    // to consecutive exponents require a single multiplication each.
+    p_type::clear_pow_cache();
+    p_type::reset_pow_cache_stats();
+    BOOST_CHECK_EQUAL(f.pow(10), ref);
+    BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().entries, 1u);
+    BOOST_CHECK_EQUAL(f.pow(11), ref * f);
+    BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().misses, 2u);
+    BOOST_CHECK_EQUAL(f.pow(10), ref);
+    BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().hits, 1u);
+    p_type::clear_pow_cache();
+}
+
+// With floating-point coefficients, the result of the exponentiation in automatic mode must not depend
+// on the history of the cache of natural powers.
+BOOST_AUTO_TEST_CASE(polynomial_pow_double_test)
+{
+    using p_type = polynomial<double, k_monomial>;
+    p_type x{"x"}, y{"y"};
+    const auto p = .1 + x + y / 3.;
+    tuning::set_pow_strategy(pow_strategy::automatic);
+    p_type::clear_pow_cache();
+    const auto r3 = p.pow(3), r5 = p.pow(5);
+    for (int i = 0; i < 3; ++i) {
+        BOOST_CHECK_EQUAL(p.pow(3), r3);
+        BOOST_CHECK_EQUAL(p.pow(5), r5);
+    }
+    p_type::clear_pow_cache();
+    BOOST_CHECK_EQUAL(p.pow(5), r5);
+    BOOST_CHECK_EQUAL(p.pow(3), r3);
+    p_type::clear_pow_cache();
+    const auto q = .1 + x;
+    const auto q3 = q.pow(3);
+    BOOST_CHECK_EQUAL(q.pow(3), q3);
+    BOOST_CHECK_EQUAL(piranha::pow(q, 3), q3);
+    p_type::clear_pow_cache();
+    tuning::reset_pow_strategy();
+}
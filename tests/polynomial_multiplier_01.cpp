@@ -33,12 +33,18 @@ see https://www.gnu.org/licenses/. */
 
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/vector.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <piranha/detail/cf_recycler.hpp>
+#include <piranha/detail/debug_access.hpp>
+#include <piranha/estimation_log.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/kronecker_array.hpp>
 #include <piranha/kronecker_monomial.hpp>
@@ -46,7 +52,9 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/monomial.hpp>
 #include <piranha/rational.hpp>
 #include <piranha/settings.hpp>
+#include <piranha/tuning.hpp>
 #include <piranha/symbol_utils.hpp>
+#include <piranha/thread_pool.hpp>
 
 using namespace piranha;
 
@@ -247,3 +255,348 @@ BOOST_AUTO_TEST_CASE(polynomial_multiplier_multiplication_test)
     }
     settings::reset_n_threads();
 }
+
+struct dense_tester {
+    template <typename Cf>
+    void operator()(const Cf &)
+    {
+        using pt = polynomial<Cf, k_monomial>;
+        settings::set_min_work_per_thread(1u);
+        for (unsigned nt = 1u; nt <= 4u; ++nt) {
+            settings::set_n_threads(nt);
+            // Products whose exponents are confined in a small box, including negative exponents,
+            // so that the dense multiplication is used. Check the result against the sum of the
+            // products of f by the single terms of g.
+            pt x{"x"}, y{"y"}, z{"z"}, t{"t"};
+            // Use non-unitary denominators with rational coefficients.
+            const bool is_q = std::is_same<Cf, rational>::value;
+            const Cf c1 = is_q ? Cf(1) / Cf(3) : Cf(3), c2 = is_q ? Cf(1) / Cf(5) : Cf(5);
+            const auto f = (1 + x + y + z + t).pow(8) * x.pow(-2) * c1,
+                       g = (1 - x + y - z + t).pow(8) * (y * t).pow(-3) * c2 + 1;
+            const auto res = f * g;
+            pt cmp;
+            for (const auto &p : g._container()) {
+                pt tmp;
+                tmp.set_symbol_set(g.get_symbol_set());
+                tmp.insert(p);
+                cmp += f * tmp;
+            }
+            BOOST_CHECK_EQUAL(res, cmp);
+            // Cancellations.
+            BOOST_CHECK_EQUAL(f * (g - 1) - (res - f), 0);
+            // Check the dense path is disabled by a low memory limit, and that the result is the same.
+            tuning::set_multiplication_memory_limit(1024u);
+            BOOST_CHECK_EQUAL(f * g, cmp);
+            tuning::reset_multiplication_memory_limit();
+        }
+        settings::reset_min_work_per_thread();
+        settings::reset_n_threads();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_dense_test)
+{
+    boost::mpl::for_each<boost::mpl::vector<double, integer, rational>>(dense_tester());
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_dense_small_integer_test)
+{
+    // Integer coefficients fitting in a machine word, whose products are accumulated in 128-bit integers
+    // by the dense multiplication. The coefficients of the result do not fit in a machine word.
+    using pt = polynomial<integer, k_monomial>;
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        pt x{"x"}, y{"y"}, z{"z"};
+        const integer c1 = integer(1ll << 45), c2 = 1 - integer(1ll << 44);
+        const auto f0 = (1 + x + y + z).pow(8) * x.pow(-2), g0 = (1 - x + y - z).pow(8) * y.pow(-3) + 1;
+        const auto f = f0 * c1, g = g0 * c2;
+        const auto res = f * g;
+        BOOST_CHECK_EQUAL(res, f0 * g0 * (c1 * c2));
+        // Cancellations.
+        BOOST_CHECK_EQUAL(f * (g - c2) - (res - f * c2), 0);
+        // Coefficients not fitting in a machine word disable the fast path.
+        const integer c3 = integer(1ll << 35) * integer(1ll << 35);
+        BOOST_CHECK_EQUAL((f * c3) * g, res * c3);
+        BOOST_CHECK_EQUAL((f + c3) * g, res + g * c3);
+        // Coefficients fitting in a machine word whose accumulated products might overflow 128 bits.
+        const integer c4 = integer(1ll << 50);
+        BOOST_CHECK_EQUAL((f0 * c4) * (g0 * c4), f0 * g0 * (c4 * c4));
+    }
+    {
+        // Rational coefficients, lifted to integral values by the lcms of the denominators of the operands.
+        using pq = polynomial<rational, k_monomial>;
+        for (unsigned nt = 1u; nt <= 4u; ++nt) {
+            settings::set_n_threads(nt);
+            pq x{"x"}, y{"y"}, z{"z"};
+            const auto f = (1 + x / 3 + y + z / 5).pow(8), g = (1 - x + y / 7 - z / 2).pow(8) + 1 / 11_q;
+            const auto res = f * g;
+            BOOST_CHECK_EQUAL(res, g * f);
+            BOOST_CHECK_EQUAL(res - f / 11, f * (1 - x + y / 7 - z / 2).pow(8));
+            // Cancellations.
+            BOOST_CHECK_EQUAL(f * (g - 1 / 11_q) - (res - f / 11), 0);
+        }
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_sparse_small_integer_test)
+{
+    // Integer coefficients fitting in a machine word, whose products are accumulated in 128-bit integers
+    // by the sparse multiplication. The exponents are spread out so that the dense multiplication is not used.
+    using pt = polynomial<integer, k_monomial>;
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        pt x{"x"}, y{"y"}, z{"z"};
+        const integer c1 = integer(1ll << 45), c2 = 1 - integer(1ll << 44);
+        const auto f0 = (1 + x.pow(100) + y.pow(-77) + z.pow(531)).pow(6),
+                   g0 = (1 - x.pow(31) + y.pow(1000) - z.pow(-13)).pow(6) + 1;
+        const auto f = f0 * c1, g = g0 * c2;
+        const auto res = f * g;
+        BOOST_CHECK_EQUAL(res, f0 * g0 * (c1 * c2));
+        BOOST_CHECK_EQUAL(res, g * f);
+        // Cancellations.
+        BOOST_CHECK_EQUAL(f * (g - c2) - (res - f * c2), 0);
+        BOOST_CHECK_EQUAL(f * (f0 * c2) - (f0 * c1) * (f0 * c2), 0);
+        // Coefficients not fitting in a machine word disable the fast path.
+        const integer c3 = integer(1ll << 35) * integer(1ll << 35);
+        BOOST_CHECK_EQUAL((f * c3) * g, res * c3);
+        BOOST_CHECK_EQUAL((f + c3) * g, res + g * c3);
+    }
+    {
+        // Rational coefficients.
+        using pq = polynomial<rational, k_monomial>;
+        for (unsigned nt = 1u; nt <= 4u; ++nt) {
+            settings::set_n_threads(nt);
+            pq x{"x"}, y{"y"}, z{"z"};
+            const auto f = (1 + x.pow(100) / 3 + y.pow(-77) + z.pow(531) / 5).pow(6),
+                       g = (1 - x.pow(31) + y.pow(1000) / 7 - z.pow(-13) / 2).pow(6) + 1 / 11_q;
+            const auto res = f * g;
+            BOOST_CHECK_EQUAL(res, g * f);
+            BOOST_CHECK_EQUAL(res - f / 11, f * (1 - x.pow(31) + y.pow(1000) / 7 - z.pow(-13) / 2).pow(6));
+        }
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
+#if defined(PIRANHA_HAVE_GCC_INT128)
+
+struct multimodular_tag {
+};
+
+namespace piranha
+{
+template <>
+class debug_access<multimodular_tag>
+{
+public:
+    // Run the multimodular dense multiplication of f by g, writing the result into out. Returns false if the
+    // multimodular path was not taken.
+    template <typename S>
+    static bool run(const S &f, const S &g, S &out)
+    {
+        const series_multiplier<S> sm(f, g);
+        std::vector<std::size_t> weights;
+        const auto dsize = sm.dense_kronecker_setup(std::numeric_limits<typename S::size_type>::max(), weights);
+        BOOST_CHECK(dsize != 0u);
+        return dsize != 0u && sm.dense_kronecker_multimodular(dsize, weights, out);
+    }
+};
+}
+
+using mm_tester = debug_access<multimodular_tag>;
+
+#endif
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_dense_multimodular_test)
+{
+    // Integer coefficients not fitting in a machine word, multiplied via the multimodular mode. The bound
+    // on the coefficients of the result requires about 10 primes.
+    using pt = polynomial<integer, k_monomial>;
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        pt x{"x"}, y{"y"}, z{"z"};
+        const integer c1 = math::pow(integer(2), 100) + 3, c2 = 1 - 3 * math::pow(integer(2), 98);
+        const auto f = (c1 + x - c2 * y + z).pow(3) * x.pow(-2), g = (c2 - x + y - c1 * z).pow(3) * y.pow(-3) + c1;
+        const auto res = f * g;
+#if defined(PIRANHA_HAVE_GCC_INT128)
+        pt out;
+        BOOST_CHECK(mm_tester::run(f, g, out));
+        BOOST_CHECK_EQUAL(out, res);
+        BOOST_CHECK(mm_tester::run(f, g - c1, out));
+        BOOST_CHECK_EQUAL(out, res - f * c1);
+        // Cancellations.
+        BOOST_CHECK(mm_tester::run(f, -f, out));
+        BOOST_CHECK_EQUAL(out, -(f * f));
+#endif
+        tuning::set_multimodular_multiplication(true);
+        BOOST_CHECK_EQUAL(f * g, res);
+        BOOST_CHECK_EQUAL(f * (g - c1) - (res - f * c1), 0);
+        // Coefficients whose bound requires more primes than available: the multimodular path is not taken.
+        const auto c3 = math::pow(integer(2), 1100);
+#if defined(PIRANHA_HAVE_GCC_INT128)
+        BOOST_CHECK(!mm_tester::run(pt(f * c3), g, out));
+#endif
+        BOOST_CHECK_EQUAL((f * c3) * g, res * c3);
+        tuning::reset_multimodular_multiplication();
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_sparse_estimation_test)
+{
+    // Very sparse operands, in which most of the sampling trials do not find duplicate terms. Each term of
+    // x**i * y**j * z of the result is generated twice, the other terms once.
+    using p_type = polynomial<integer, kronecker_monomial<>>;
+    p_type x{"x"}, y{"y"}, z{"z"};
+    p_type a, b;
+    for (int i = 0; i < 400; ++i) {
+        a += x.pow(i) + x.pow(i) * z;
+        b += y.pow(i) + y.pow(i) * z;
+    }
+    settings::set_min_work_per_thread(1u);
+    estimation_log::clear();
+    estimation_log::set_enabled(true);
+    for (unsigned nt = 1u; nt <= 3u; ++nt) {
+        settings::set_n_threads(nt);
+        const auto res = a * b;
+        BOOST_CHECK_EQUAL(res.size(), 480000u);
+        const auto records = estimation_log::get_records();
+        BOOST_CHECK_EQUAL(records.size(), nt);
+        BOOST_CHECK_EQUAL(records.back().m_actual, 480000u);
+        // The estimate is much closer to the actual size than the number of term-by-term products.
+        BOOST_CHECK(records.back().m_estimate >= 450000u);
+        BOOST_CHECK(records.back().m_estimate <= 550000u);
+    }
+    estimation_log::set_enabled(false);
+    estimation_log::clear();
+    settings::reset_n_threads();
+    settings::reset_min_work_per_thread();
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_node_arena_test)
+{
+    // Results allocated with the node arena, with the sparse Kronecker, dense and plain multiplications.
+    using p_type = polynomial<integer, kronecker_monomial<>>;
+    using p_type2 = polynomial<integer, monomial<int>>;
+    p_type x{"x"}, y{"y"}, z{"z"};
+    p_type2 x2{"x"}, y2{"y"}, z2{"z"};
+    const auto f = (x + y + z + 1).pow(10), g = (x - y + z - 3).pow(10), h = (x * y.pow(100) - z.pow(30) + 1).pow(10);
+    const auto f2 = (x2 + y2 + z2 + 1).pow(8), g2 = (x2 - y2 + z2 - 3).pow(8);
+    settings::set_min_work_per_thread(1u);
+    settings::set_n_threads(1u);
+    const auto res1 = f * g, res2 = f * h, res3 = f2 * g2;
+    tuning::set_node_arena(true);
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        auto tmp1 = f * g;
+        BOOST_CHECK_EQUAL(tmp1, res1);
+        auto tmp2 = f * h;
+        BOOST_CHECK(tmp2._container()._has_node_arena());
+        BOOST_CHECK_EQUAL(tmp2, res2);
+        auto tmp3 = f2 * g2;
+        BOOST_CHECK(tmp3._container()._has_node_arena());
+        BOOST_CHECK_EQUAL(tmp3, res3);
+        // Erase terms via cancellations, and insert new ones.
+        tmp2 -= res2 - f;
+        BOOST_CHECK_EQUAL(tmp2, f);
+        tmp3 += res3;
+        BOOST_CHECK_EQUAL(tmp3, 2 * res3);
+    }
+    tuning::reset_node_arena();
+    settings::reset_n_threads();
+    settings::reset_min_work_per_thread();
+}
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_cf_recycler_test)
+{
+    // Basic checks on the pool of coefficients.
+    using int_rec = detail::cf_recycler<integer>;
+    using q_rec = detail::cf_recycler<rational>;
+    int_rec::clear();
+    q_rec::clear();
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    integer n{1};
+    // Small values are not recycled.
+    int_rec::release(std::move(n));
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    n = integer{1} << 500;
+    int_rec::release(std::move(n));
+    integer m;
+    rational q{integer{1} << 500, 3};
+    q_rec::release(std::move(q));
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+    BOOST_CHECK_EQUAL(int_rec::size(), 1u);
+    int_rec::refill(m);
+    BOOST_CHECK(m.is_dynamic());
+    BOOST_CHECK_EQUAL(q_rec::size(), 1u);
+#endif
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    q_rec::refill(q);
+    BOOST_CHECK(piranha::is_one(q.get_den()));
+    BOOST_CHECK_EQUAL(q_rec::size(), 0u);
+    // Refilling from an empty pool.
+    int_rec::refill(m);
+    BOOST_CHECK_EQUAL(m, 0);
+    // The size of the pool is bounded.
+    for (std::size_t i = 0u; i < int_rec::max_size + 10u; ++i) {
+        n = integer{1} << 500;
+        int_rec::release(std::move(n));
+    }
+    BOOST_CHECK(int_rec::size() <= int_rec::max_size);
+    int_rec::clear();
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    BOOST_CHECK_EQUAL(int_rec::limbs(), 0u);
+    // Oversized values are not recycled.
+    n = integer{1} << (int_rec::max_cf_limbs * 64u + 64u);
+    int_rec::release(std::move(n));
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    // The total number of limbs in the pool is bounded.
+    for (std::size_t i = 0u; i < int_rec::max_size; ++i) {
+        n = integer{1} << (int_rec::max_cf_limbs * 32u);
+        int_rec::release(std::move(n));
+    }
+    BOOST_CHECK(int_rec::limbs() <= int_rec::max_limbs);
+#if defined(PIRANHA_HAVE_THREAD_LOCAL)
+    BOOST_CHECK(int_rec::size() > 0u);
+    BOOST_CHECK(int_rec::size() < int_rec::max_size);
+#endif
+    // Resizing the thread pool empties the pools.
+    n = integer{1} << 500;
+    int_rec::release(std::move(n));
+    q = rational{integer{1} << 500, 3};
+    q_rec::release(std::move(q));
+    thread_pool::resize(thread_pool::size());
+    BOOST_CHECK_EQUAL(int_rec::size(), 0u);
+    BOOST_CHECK_EQUAL(int_rec::limbs(), 0u);
+    BOOST_CHECK_EQUAL(q_rec::size(), 0u);
+    // Multiplications with large coefficients and cancellations, so that the pools are
+    // used both to recycle the coefficients of the erased terms and to fill in the new ones.
+    using p_type = polynomial<integer, kronecker_monomial<>>;
+    using pq_type = polynomial<rational, kronecker_monomial<>>;
+    p_type x{"x"}, y{"y"}, ax, ay;
+    for (int i = 0; i < 60; ++i) {
+        ax += (integer{1} << (200 + i)) * x.pow(i);
+        ay += (integer{1} << (200 + i)) * y.pow(i);
+    }
+    const auto res = ax * ax - ay * ay;
+    const pq_type qx = pq_type{ax} / 3, qy = pq_type{ay} / 3, qres = pq_type{res} / 9;
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 1u; nt <= 3u; ++nt) {
+        settings::set_n_threads(nt);
+        for (int i = 0; i < 3; ++i) {
+            BOOST_CHECK_EQUAL((ax - ay) * (ax + ay), res);
+            BOOST_CHECK_EQUAL((ax + ay) * (ax - ay), res);
+            BOOST_CHECK_EQUAL((qx - qy) * (qx + qy), qres);
+        }
+    }
+    settings::reset_n_threads();
+    settings::reset_min_work_per_thread();
+    int_rec::clear();
+    q_rec::clear();
+}
@@ -38,11 +38,13 @@ see https://www.gnu.org/licenses/. */
 #include <limits>
 #include <type_traits>
 
+#include <piranha/base_series_multiplier.hpp>
 #include <piranha/integer.hpp>
 #include <piranha/kronecker_monomial.hpp>
 #include <piranha/monomial.hpp>
 #include <piranha/rational.hpp>
 #include <piranha/settings.hpp>
+#include <piranha/tuning.hpp>
 
 using namespace piranha;
 
@@ -95,6 +97,81 @@ BOOST_AUTO_TEST_CASE(polynomial_multiplier_st_vs_mt_test)
     settings::reset_n_threads();
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_skewed_mt_test)
+{
+    // A product in which most of the term-by-term multiplications end up in a small
+    // portion of the output container, so that the mt scheduler needs to split and steal zones.
+    using p_type = polynomial<integer, k_monomial>;
+    settings::set_n_threads(1u);
+    p_type x("x"), y("y");
+    auto f = (1 + x).pow(300) + y;
+    auto g = (1 - x).pow(300) + y;
+    const auto st = f * g;
+    settings::set_min_work_per_thread(1u);
+    for (auto i = 2u; i <= 16u; i *= 2u) {
+        settings::set_n_threads(i);
+        BOOST_CHECK(f * g == st);
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
+// Accessor to the plain multiplication with a known size estimate.
+template <typename Series>
+struct est_multiplier : base_series_multiplier<Series> {
+    using base = base_series_multiplier<Series>;
+    explicit est_multiplier(const Series &s1, const Series &s2) : base(s1, s2) {}
+    Series run(typename base::bucket_size_type est) const
+    {
+        return this->_plain_multiplication(est);
+    }
+};
+
+struct chunked_tester {
+    template <typename Cf>
+    struct runner {
+        template <typename Key>
+        void operator()(const Key &)
+        {
+            if (std::is_same<Cf, double>::value) {
+                return;
+            }
+            using p_type = polynomial<Cf, Key>;
+            settings::set_n_threads(1u);
+            p_type x("x"), y("y"), z("z"), t("t");
+            auto f = (1 + x + y + z + t).pow(6), g = (1 - x + y - z + t).pow(6) + 1;
+            const auto cmp = f * g;
+            // Force the chunked mode with a tiny memory limit.
+            tuning::set_multiplication_memory_limit(4096u);
+            settings::set_min_work_per_thread(1u);
+            for (auto i = 1u; i <= 4u; ++i) {
+                settings::set_n_threads(i);
+                BOOST_CHECK(f * g == cmp);
+                // Products with cancellations.
+                BOOST_CHECK(f * (g - 1) - (f * g - f) == p_type{});
+                // Estimate provided by the caller.
+                const est_multiplier<p_type> em(f, g);
+                BOOST_CHECK(em.run(cmp.size()) == cmp);
+                BOOST_CHECK(em.run(cmp.size() / 2u) == cmp);
+                BOOST_CHECK(em.run(0u) == cmp);
+            }
+            settings::reset_min_work_per_thread();
+            tuning::reset_multiplication_memory_limit();
+            settings::reset_n_threads();
+        }
+    };
+    template <typename Cf>
+    void operator()(const Cf &)
+    {
+        boost::mpl::for_each<k_types>(runner<Cf>());
+    }
+};
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_chunked_test)
+{
+    boost::mpl::for_each<cf_types>(chunked_tester());
+}
+
 BOOST_AUTO_TEST_CASE(polynomial_multiplier_different_cf_test)
 {
     settings::set_n_threads(1u);
@@ -33,13 +33,17 @@ see https://www.gnu.org/licenses/. */
 
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/vector.hpp>
+#include <algorithm>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include <piranha/integer.hpp>
 #include <piranha/kronecker_monomial.hpp>
 #include <piranha/monomial.hpp>
 #include <piranha/rational.hpp>
 #include <piranha/series_multiplier.hpp>
+#include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 
 using namespace piranha;
@@ -190,3 +194,139 @@ BOOST_AUTO_TEST_CASE(polynomial_multiplier_truncated_test)
     BOOST_CHECK((!has_truncated_multiplication<polynomial<short, k_monomial>>()));
     BOOST_CHECK((!has_truncated_multiplication<polynomial<char, k_monomial>>()));
 }
+
+template <typename T, typename = decltype(series_multiplier<T>(T{}, T{})._heap_multiplication())>
+constexpr bool has_heap_multiplication()
+{
+    return true;
+}
+
+template <typename T, typename... Args>
+constexpr bool has_heap_multiplication(Args &&...)
+{
+    return false;
+}
+
+struct heap_tester {
+    template <typename Cf>
+    void operator()(const Cf &)
+    {
+        using p_type = polynomial<Cf, k_monomial>;
+        p_type x{"x"}, y{"y"}, z{"z"};
+        // The multiplier needs operands with the same symbol set.
+        const auto e = x * y * z;
+        auto heap_mult = [&e](const p_type &a, const p_type &b) {
+            return series_multiplier<p_type>(a + e - e, b + e - e)._heap_multiplication();
+        };
+        // Empty and constant operands.
+        BOOST_CHECK_EQUAL(heap_mult(p_type{}, x + y), 0);
+        BOOST_CHECK_EQUAL(heap_mult(x + y, p_type{}), 0);
+        BOOST_CHECK_EQUAL(heap_mult(p_type{2}, p_type{3}), 6);
+        BOOST_CHECK_EQUAL(heap_mult(x + y, x - y), (x + y) * (x - y));
+        // Cancellations.
+        BOOST_CHECK_EQUAL(heap_mult(x + y, x - y) - x * x + y * y, 0);
+        BOOST_CHECK_EQUAL(heap_mult(x + 1, x.pow(2) - x + 1), x.pow(3) + 1);
+        // Negative exponents and operands of different sizes. Use non-unitary denominators with rational
+        // coefficients.
+        const bool is_q = std::is_same<Cf, rational>::value;
+        const Cf c1 = is_q ? Cf(1) / Cf(3) : Cf(3), c2 = is_q ? Cf(1) / Cf(5) : Cf(5);
+        const auto f = (x + y.pow(-1) + z + 1).pow(6) * c1, g = (x.pow(-2) - y + 2 * z * z).pow(4) * c2;
+        const auto fg = f * g;
+        BOOST_CHECK_EQUAL(heap_mult(f, g), fg);
+        BOOST_CHECK_EQUAL(heap_mult(g, f), fg);
+        BOOST_CHECK_EQUAL(heap_mult(f, g + 1), fg + f);
+        BOOST_CHECK_EQUAL(heap_mult(f, x), f * x);
+        // Callback form: the terms are streamed in ascending order of Kronecker code, with finalised coefficients.
+        using term_type = typename p_type::term_type;
+        p_type streamed;
+        streamed.set_symbol_set(fg.get_symbol_set());
+        using code_type = typename term_type::key_type::value_type;
+        std::vector<code_type> codes;
+        series_multiplier<p_type>(f, g)._heap_multiplication([&streamed, &codes](term_type &&t) {
+            codes.push_back(t.m_key.get_int());
+            streamed.insert(std::move(t));
+        });
+        BOOST_CHECK_EQUAL(codes.size(), fg.size());
+        BOOST_CHECK(std::adjacent_find(codes.begin(), codes.end(),
+                                       [](const code_type &a, const code_type &b) { return !(a < b); })
+                    == codes.end());
+        BOOST_CHECK_EQUAL(streamed, fg);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_heap_test)
+{
+    boost::mpl::for_each<cf_types>(heap_tester());
+    {
+        // Integer coefficients fitting in a machine word, with products accumulated in 128-bit integers.
+        using p_type = polynomial<integer, k_monomial>;
+        p_type x{"x"}, y{"y"};
+        const auto f0 = (x + y.pow(-1) + 1).pow(10), g0 = (x.pow(-2) - y + 1).pow(10) + 1;
+        const integer c1 = integer(1ll << 50), c2 = -integer(1ll << 40) - 7;
+        const integer c3 = integer(1ll << 35) * integer(1ll << 35);
+        const auto f = f0 * c1, g = g0 * c2;
+        const auto fg = series_multiplier<p_type>(f, g)._heap_multiplication();
+        BOOST_CHECK_EQUAL(fg, f0 * g0 * (c1 * c2));
+        BOOST_CHECK_EQUAL(series_multiplier<p_type>(f * c3, g)._heap_multiplication(), fg * c3);
+        BOOST_CHECK_EQUAL(series_multiplier<p_type>(f, -g)._heap_multiplication() + fg, 0);
+    }
+    BOOST_CHECK((has_heap_multiplication<polynomial<integer, k_monomial>>()));
+    BOOST_CHECK((!has_heap_multiplication<polynomial<integer, monomial<int>>>()));
+}
+
+struct sop_tester {
+    template <typename Cf>
+    struct runner {
+        template <typename Key>
+        void operator()(const Key &)
+        {
+            using p_type = polynomial<Cf, Key>;
+            settings::set_min_work_per_thread(1u);
+            for (unsigned nt = 1u; nt <= 4u; ++nt) {
+                settings::set_n_threads(nt);
+                p_type x{"x"}, y{"y"}, z{"z"}, t{"t"};
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({}), 0);
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({{x, y}}), x * y);
+                const auto a = (x + y - 2 * z + 1).pow(8), b = (x - y + z - 1).pow(8), c = (t + x * y + 3).pow(6),
+                           d = (t - z - 1).pow(6);
+                // Operands with different symbol sets.
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({{a, b}, {c, d}, {x, t}}), a * b + c * d + x * t);
+                // Cancellations.
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({{a, b}, {-b, a}}), 0);
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({{a, b}, {c, d}, {-a, b}}), c * d);
+                // Accumulation via the multiplier.
+                auto res = a * b;
+                series_multiplier<p_type>(a, a + z)._multiply_accumulate(res);
+                BOOST_CHECK_EQUAL(res, a * b + a * (a + z));
+                BOOST_CHECK_THROW(series_multiplier<p_type>(c, c)._multiply_accumulate(res), std::invalid_argument);
+                // Accumulation into one of the operands.
+                res = a * b;
+                const auto res_copy = res;
+                series_multiplier<p_type>(res, b)._multiply_accumulate(res);
+                BOOST_CHECK_EQUAL(res, res_copy + res_copy * b);
+                res = a * b;
+                series_multiplier<p_type>(a, res)._multiply_accumulate(res);
+                BOOST_CHECK_EQUAL(res, res_copy + a * res_copy);
+                res = a * b;
+                series_multiplier<p_type>(res, res)._multiply_accumulate(res);
+                BOOST_CHECK_EQUAL(res, res_copy + res_copy * res_copy);
+                // Truncation.
+                p_type::set_auto_truncate_degree(5);
+                BOOST_CHECK_EQUAL(p_type::sum_of_products({{a, b}, {c, d}}), a * b + c * d);
+                p_type::unset_auto_truncate_degree();
+            }
+            settings::reset_min_work_per_thread();
+            settings::reset_n_threads();
+        }
+    };
+    template <typename Cf>
+    void operator()(const Cf &)
+    {
+        boost::mpl::for_each<k_types>(runner<Cf>());
+    }
+};
+
+BOOST_AUTO_TEST_CASE(polynomial_multiplier_sum_of_products_test)
+{
+    boost::mpl::for_each<cf_types>(sop_tester());
+}
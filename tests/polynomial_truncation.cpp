@@ -188,3 +188,25 @@ BOOST_AUTO_TEST_CASE(polynomial_truncation_main_test)
 {
     boost::mpl::for_each<cf_types>(main_tester());
 }
+
+BOOST_AUTO_TEST_CASE(polynomial_truncation_scalar_mul_test)
+{
+    // The multiplication by scalars is done in-place on the coefficients, unless the auto truncation is active.
+    using pt = polynomial<integer, k_monomial>;
+    pt x{"x"}, y{"y"};
+    const auto p = x * x * x + x * y + x;
+    BOOST_CHECK_EQUAL(p * 2, 2 * x * x * x + 2 * x * y + 2 * x);
+    pt::set_auto_truncate_degree(2);
+    BOOST_CHECK_EQUAL(p * 2, 2 * x * y + 2 * x);
+    BOOST_CHECK_EQUAL(2 * p, 2 * x * y + 2 * x);
+    BOOST_CHECK_EQUAL(p * 2_z, 2 * x * y + 2 * x);
+    auto tmp(p);
+    tmp *= 2;
+    BOOST_CHECK_EQUAL(tmp, 2 * x * y + 2 * x);
+    pt::set_auto_truncate_degree(1, {"x"});
+    BOOST_CHECK_EQUAL(p * 2, 2 * x * y + 2 * x);
+    pt::set_auto_truncate_degree(0, {"y"});
+    BOOST_CHECK_EQUAL(p * 2, 2 * x * x * x + 2 * x);
+    pt::unset_auto_truncate_degree();
+    BOOST_CHECK_EQUAL(p * 2, 2 * x * x * x + 2 * x * y + 2 * x);
+}
@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE runtime_info_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 #include <piranha/memory.hpp>
@@ -42,6 +43,9 @@ BOOST_AUTO_TEST_CASE(runtime_info_print_test)
 {
     std::cout << "Concurrency: " << runtime_info::get_hardware_concurrency() << '\n';
     std::cout << "Cache line size: " << runtime_info::get_cache_line_size() << '\n';
+    std::cout << "L1 data cache size: " << runtime_info::get_cache_size(1u) << '\n';
+    std::cout << "L2 cache size: " << runtime_info::get_cache_size(2u) << '\n';
+    std::cout << "L3 cache size: " << runtime_info::get_cache_size(3u) << '\n';
     std::cout << "Memory alignment primitives: "
               <<
 #if defined(PIRANHA_HAVE_MEMORY_ALIGNMENT_PRIMITIVES)
@@ -57,3 +61,24 @@ BOOST_AUTO_TEST_CASE(runtime_info_settings_test)
                 || runtime_info::get_hardware_concurrency() == 0u);
     BOOST_CHECK_EQUAL(runtime_info::get_cache_line_size(), settings::get_cache_line_size());
 }
+
+BOOST_AUTO_TEST_CASE(runtime_info_cache_size_test)
+{
+    BOOST_CHECK_EQUAL(runtime_info::get_cache_size(0u), 0u);
+    BOOST_CHECK_EQUAL(runtime_info::get_cache_size(4u), 0u);
+    // The L2 cache, if detected, is not smaller than the L1 cache.
+    if (runtime_info::get_cache_size(1u) && runtime_info::get_cache_size(2u)) {
+        BOOST_CHECK(runtime_info::get_cache_size(1u) <= runtime_info::get_cache_size(2u));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(runtime_info_numa_proc_order_test)
+{
+    // The order is a permutation of the processor indices.
+    auto procs = runtime_info::get_numa_proc_order();
+    BOOST_CHECK_EQUAL(procs.size(), runtime_info::get_hardware_concurrency());
+    std::sort(procs.begin(), procs.end());
+    for (decltype(procs.size()) i = 0u; i < procs.size(); ++i) {
+        BOOST_CHECK_EQUAL(procs[i], i);
+    }
+}
@@ -48,6 +48,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/monomial.hpp>
 #include <piranha/rational.hpp>
 #include <piranha/series_multiplier.hpp>
+#include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/type_traits.hpp>
 
@@ -508,6 +509,58 @@ BOOST_AUTO_TEST_CASE(series_merge_terms_test)
     tuple_for_each(cf_types{}, merge_terms_tester());
 }
 
+BOOST_AUTO_TEST_CASE(series_parallel_merge_terms_test)
+{
+    using s_type = g_series_type<integer, int>;
+    using term_type = s_type::term_type;
+    using key_type = term_type::key_type;
+    // Two series with a partial overlap, in which the coefficients of some terms cancel out.
+    s_type s1, s2;
+    s1.set_symbol_set(symbol_fset{"x"});
+    s2.set_symbol_set(symbol_fset{"x"});
+    for (int i = 0; i < 10000; ++i) {
+        s1.insert(term_type(integer(i + 1), key_type{i}));
+        s2.insert(term_type(i % 2 ? integer(-i - 5001) : integer(i + 1), key_type{i + 5000}));
+    }
+    settings::set_n_threads(1u);
+    const auto add_cmp = s1 + s2, sub_cmp = s1 - s2;
+    BOOST_CHECK_EQUAL(add_cmp.size(), 12500u);
+    BOOST_CHECK_EQUAL(sub_cmp.size(), 15000u);
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 2u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        BOOST_CHECK(s1 + s2 == add_cmp);
+        BOOST_CHECK(s2 + s1 == add_cmp);
+        BOOST_CHECK(s1 - s2 == sub_cmp);
+        BOOST_CHECK(-(s2 - s1) == sub_cmp);
+        // Move semantics.
+        auto s1_copy(s1), s2_copy(s2);
+        BOOST_CHECK(std::move(s1_copy) + std::move(s2_copy) == add_cmp);
+        s1_copy = s1;
+        s2_copy = s2;
+        s1_copy -= std::move(s2_copy);
+        BOOST_CHECK(s1_copy == sub_cmp);
+        BOOST_CHECK_EQUAL(s1_copy.size(), 15000u);
+        // Complete cancellation.
+        s1_copy = s1;
+        s1_copy -= s1;
+        BOOST_CHECK_EQUAL(s1_copy.size(), 0u);
+        BOOST_CHECK(s1_copy.empty());
+        // Ignorable terms in the merged series are discarded.
+        auto s3(s2);
+        s3._container().insert(term_type(integer(0), key_type{-1}));
+        BOOST_CHECK_EQUAL(s3.size(), 10001u);
+        const auto s13 = s1 + s3;
+        BOOST_CHECK(s13 == add_cmp);
+        BOOST_CHECK_EQUAL(s13.size(), 12500u);
+        // Incompatible terms in the merged series.
+        s3._container().insert(term_type(integer(1), key_type{1, 2}));
+        BOOST_CHECK_THROW(s1 + s3, std::invalid_argument);
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+}
+
 struct merge_arguments_tag {
 };
 
@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #include <cstddef>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <sstream>
 #include <stdexcept>
@@ -66,6 +67,7 @@ see https://www.gnu.org/licenses/. */
 #endif
 #include <piranha/s11n.hpp>
 #include <piranha/series_multiplier.hpp>
+#include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/type_traits.hpp>
 
@@ -1908,6 +1910,58 @@ BOOST_AUTO_TEST_CASE(series_arithmetics_div_test)
     BOOST_CHECK(tmp.empty());
 }
 
+BOOST_AUTO_TEST_CASE(series_scalar_in_place_test)
+{
+    // Multiplication and division by scalars performed in-place on the coefficients.
+    using pint = g_series_type<integer, int>;
+    using term_type = pint::term_type;
+    using key_type = term_type::key_type;
+    pint s, s3, s_half;
+    s.set_symbol_set(symbol_fset{"x"});
+    s3.set_symbol_set(symbol_fset{"x"});
+    s_half.set_symbol_set(symbol_fset{"x"});
+    for (int i = 0; i < 10000; ++i) {
+        s.insert(term_type(integer(i + 1), key_type{i}));
+        s3.insert(term_type(integer(3 * (i + 1)), key_type{i}));
+        s_half.insert(term_type(integer((i + 1) / 2), key_type{i}));
+    }
+    BOOST_CHECK_EQUAL(s_half.size(), 9999u);
+    settings::set_min_work_per_thread(1u);
+    for (unsigned nt = 1u; nt <= 4u; ++nt) {
+        settings::set_n_threads(nt);
+        BOOST_CHECK_EQUAL(s * 3, s3);
+        BOOST_CHECK_EQUAL(3 * s, s3);
+        BOOST_CHECK_EQUAL(s * 3_z, s3);
+        BOOST_CHECK((s * 0).empty());
+        BOOST_CHECK_EQUAL(s3 / 3, s);
+        // Terms are erased after the transformation.
+        BOOST_CHECK_EQUAL(s / 2, s_half);
+        auto tmp(s);
+        tmp *= 3;
+        BOOST_CHECK_EQUAL(tmp, s3);
+        tmp /= 3;
+        BOOST_CHECK_EQUAL(tmp, s);
+        tmp /= 2;
+        BOOST_CHECK_EQUAL(tmp, s_half);
+        tmp *= 0;
+        BOOST_CHECK(tmp.empty());
+        // Zero division error.
+        tmp = s;
+        BOOST_CHECK_THROW(tmp /= 0, mppp::zero_division_error);
+        BOOST_CHECK(tmp.empty());
+    }
+    settings::reset_min_work_per_thread();
+    settings::reset_n_threads();
+    // Non-absorbing zero.
+    if (std::numeric_limits<double>::is_iec559) {
+        using pdouble = g_series_type<double, int>;
+        BOOST_CHECK((pdouble{} * std::numeric_limits<double>::infinity()).size() == 1u);
+        BOOST_CHECK((pdouble{} * 2.).size() == 0u);
+        BOOST_CHECK((pdouble{std::numeric_limits<double>::infinity()} * 0.).size() == 1u);
+        BOOST_CHECK((pdouble{"x"} * 0.).size() == 0u);
+    }
+}
+
 struct eq_tag {
 };
 
@@ -36,15 +36,19 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <piranha/exceptions.hpp>
 #include <piranha/forwarding.hpp>
 #include <piranha/integer.hpp>
+#include <piranha/kronecker_monomial.hpp>
 #include <piranha/math.hpp>
 #include <piranha/math/cos.hpp>
 #include <piranha/math/sin.hpp>
 #include <piranha/monomial.hpp>
 #include <piranha/polynomial.hpp>
+#include <piranha/rational.hpp>
+#include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/type_traits.hpp>
 
@@ -297,3 +301,73 @@ BOOST_AUTO_TEST_CASE(series_evaluation_test)
                     != std::string::npos);
     }
 }
+
+// Reference term-by-term evaluation of a series.
+template <typename S, typename T>
+static auto term_by_term_evaluate(const S &s, const symbol_fmap<T> &dict) -> decltype(math::evaluate(s, dict))
+{
+    const auto &ss = s.get_symbol_set();
+    std::vector<T> values;
+    for (const auto &sym : ss) {
+        values.push_back(dict.find(sym)->second);
+    }
+    decltype(math::evaluate(s, dict)) retval(0);
+    for (const auto &t : s._container()) {
+        detail::series_eval_multadd(retval, math::evaluate(t.m_cf, dict), t.m_key.evaluate(values, ss));
+    }
+    return retval;
+}
+
+struct evaluation_plan_tester {
+    template <typename Key>
+    void operator()(const Key &) const
+    {
+        using p_type = polynomial<rational, Key>;
+        p_type x{"x"}, y{"y"}, z{"z"};
+        BOOST_CHECK((series_has_evaluation_plan<p_type, rational>::value));
+        BOOST_CHECK((series_has_evaluation_plan<p_type, double>::value));
+        const symbol_fmap<rational> qdict{{"x", 1 / 2_q}, {"y", -3 / 4_q}, {"z", 5 / 7_q}};
+        const symbol_fmap<double> ddict{{"x", .5}, {"y", -.75}, {"z", 1.25}};
+        // Empty series and constants.
+        BOOST_CHECK_EQUAL(math::evaluate(p_type{}, qdict), 0);
+        BOOST_CHECK_EQUAL(math::evaluate(p_type{3}, qdict), 3);
+        // Negative exponents and wide exponent ranges.
+        const auto p = (x * 2 / 3 + y - z + 1).pow(5) * x.pow(-2) + y.pow(-3) * z / 5 - x.pow(40) * y.pow(-40);
+        BOOST_CHECK_EQUAL(math::evaluate(p, qdict), term_by_term_evaluate(p, qdict));
+        BOOST_CHECK_EQUAL(math::evaluate(p, ddict), term_by_term_evaluate(p, ddict));
+        BOOST_CHECK_EQUAL(math::evaluate(p, qdict), math::evaluate(p, qdict));
+        BOOST_CHECK_THROW(math::evaluate(p, symbol_fmap<rational>{{"x", 1 / 2_q}, {"z", 1 / 3_q}}),
+                          std::invalid_argument);
+        // Exponents of both signs in the same table.
+        const auto p2 = x.pow(-1) + x + 1;
+        BOOST_CHECK_EQUAL(math::evaluate(p2, qdict), 2 + 1 / 2_q + 1);
+        BOOST_CHECK_EQUAL(math::evaluate(p2, ddict), term_by_term_evaluate(p2, ddict));
+        // A series large enough to be evaluated in parallel.
+        const auto q = (x + y * 2 - z / 3 + 1).pow(20) * z.pow(-3);
+        for (unsigned nt = 1u; nt <= 4u; ++nt) {
+            settings::set_n_threads(nt);
+            settings::set_min_work_per_thread(1u);
+            BOOST_CHECK_EQUAL(math::evaluate(q, qdict), term_by_term_evaluate(q, qdict));
+            // Floating-point evaluations do not depend on the number of threads.
+            BOOST_CHECK_EQUAL(math::evaluate(q, ddict), term_by_term_evaluate(q, ddict));
+            BOOST_CHECK_EQUAL(math::evaluate(q, qdict), piranha::pow(1 / 2_q - 3 / 2_q - 5 / 21_q + 1, 20)
+                                                            * piranha::pow(5 / 7_q, -3));
+        }
+        settings::reset_n_threads();
+        settings::reset_min_work_per_thread();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(series_evaluation_plan_test)
+{
+    evaluation_plan_tester{}(k_monomial{});
+    evaluation_plan_tester{}(monomial<int>{});
+    // Exponent types narrower than int.
+    evaluation_plan_tester{}(monomial<short>{});
+    evaluation_plan_tester{}(monomial<signed char>{});
+    // Keys with non-integral exponents are evaluated term by term.
+    BOOST_CHECK((!series_has_evaluation_plan<polynomial<double, monomial<rational>>, double>::value));
+    using p_type = polynomial<double, monomial<rational>>;
+    p_type x{"x"}, y{"y"};
+    BOOST_CHECK_EQUAL(math::evaluate((x + y).pow(3), symbol_fmap<double>{{"x", 4.}, {"y", 1.}}), 125.);
+}
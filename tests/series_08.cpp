@@ -40,6 +40,7 @@ see https://www.gnu.org/licenses/. */
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include <mp++/config.hpp>
 #include <mp++/exceptions.hpp>
@@ -66,6 +67,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/series_multiplier.hpp>
 #include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
+#include <piranha/tuning.hpp>
 #include <piranha/type_traits.hpp>
 
 using namespace piranha;
@@ -532,3 +534,81 @@ BOOST_AUTO_TEST_CASE(series_pow_test)
     p_type3::clear_pow_cache();
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(series_pow_cache_test)
+{
+    typedef g_series_type<integer, int> p_type;
+    // NOTE: in automatic mode, the powers of series with integer coefficients might be computed
+    // via repeated squaring, bypassing the cache.
+    tuning::set_pow_strategy(pow_strategy::cached);
+    p_type::clear_pow_cache();
+    p_type::reset_pow_cache_stats();
+    const auto orig_budget = p_type::get_pow_cache_budget();
+    p_type x{"x"}, y{"y"};
+    // Hits and misses.
+    const auto x10 = x.pow(10);
+    auto stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.hits, 0u);
+    BOOST_CHECK_EQUAL(stats.misses, 1u);
+    BOOST_CHECK_EQUAL(stats.entries, 1u);
+    BOOST_CHECK(stats.bytes > 0u);
+    BOOST_CHECK_EQUAL(x.pow(5), x.pow(2) * x.pow(3));
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.hits, 3u);
+    BOOST_CHECK_EQUAL(stats.misses, 1u);
+    // Per-entry removal.
+    const auto y10 = y.pow(10);
+    BOOST_CHECK(p_type::erase_pow_cache(x));
+    BOOST_CHECK(!p_type::erase_pow_cache(x));
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.entries, 1u);
+    const auto y_bytes = stats.bytes;
+    BOOST_CHECK(y_bytes > 0u);
+    BOOST_CHECK_EQUAL(x.pow(10), x10);
+    // LRU eviction: y is used after x, thus x is evicted first.
+    BOOST_CHECK_EQUAL(y.pow(10), y10);
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.entries, 2u);
+    p_type::set_pow_cache_budget(stats.bytes - 1u);
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.entries, 1u);
+    BOOST_CHECK_EQUAL(stats.evictions, 1u);
+    BOOST_CHECK_EQUAL(stats.bytes, y_bytes);
+    p_type::reset_pow_cache_stats();
+    BOOST_CHECK_EQUAL(y.pow(10), y10);
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.hits, 1u);
+    BOOST_CHECK_EQUAL(stats.misses, 0u);
+    // Powers larger than the budget are computed correctly, but not retained.
+    p_type::set_pow_cache_budget(1u);
+    BOOST_CHECK_EQUAL(x.pow(10), x10);
+    BOOST_CHECK_EQUAL((x + y).pow(3), (x + y) * (x + y) * (x + y));
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.entries, 0u);
+    BOOST_CHECK_EQUAL(stats.bytes, 0u);
+    p_type::set_pow_cache_budget(orig_budget);
+    BOOST_CHECK_EQUAL(p_type::get_pow_cache_budget(), orig_budget);
+    // Concurrent exponentiations of different and identical bases.
+    std::vector<p_type> bases{x, y, x + y, x - y, x + 1, y - 1, x * y + 2, x};
+    std::vector<p_type> res(bases.size());
+    std::vector<std::thread> threads;
+    for (decltype(bases.size()) i = 0u; i < bases.size(); ++i) {
+        threads.emplace_back([&bases, &res, i]() { res[i] = bases[i].pow(12); });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (decltype(bases.size()) i = 0u; i < bases.size(); ++i) {
+        p_type tmp{1};
+        for (int j = 0; j < 12; ++j) {
+            tmp *= bases[i];
+        }
+        BOOST_CHECK_EQUAL(res[i], tmp);
+    }
+    BOOST_CHECK_EQUAL(p_type::get_pow_cache_stats().entries, 7u);
+    p_type::clear_pow_cache();
+    stats = p_type::get_pow_cache_stats();
+    BOOST_CHECK_EQUAL(stats.entries, 0u);
+    BOOST_CHECK_EQUAL(stats.bytes, 0u);
+    tuning::reset_pow_strategy();
+}
@@ -40,6 +40,7 @@ see https://www.gnu.org/licenses/. */
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <utility>
 
 #include <mp++/config.hpp>
 
@@ -61,6 +62,7 @@ see https://www.gnu.org/licenses/. */
 #include <piranha/s11n.hpp>
 #include <piranha/series.hpp>
 #include <piranha/series_multiplier.hpp>
+#include <piranha/settings.hpp>
 #include <piranha/symbol_utils.hpp>
 #include <piranha/term.hpp>
 
@@ -338,6 +340,63 @@ BOOST_AUTO_TEST_CASE(subs_series_subs_test)
     }
 }
 
+// Reference implementation of the substitution, computed term by term.
+template <typename T, typename S>
+static inline decltype(std::declval<const S &>().subs(std::declval<const symbol_fmap<T> &>()))
+term_by_term_subs(const S &s, const symbol_fmap<T> &dict)
+{
+    decltype(s.subs(dict)) retval(0);
+    for (const auto &t : s._container()) {
+        S tmp;
+        tmp.set_symbol_set(s.get_symbol_set());
+        tmp.insert(t);
+        retval += tmp.subs(dict);
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(subs_series_batched_subs_test)
+{
+    // Substitution on key only.
+    using stype0 = g_series_type<rational, monomial<int>>;
+    stype0 x{"x"}, y{"y"}, z{"z"}, w{"w"};
+    stype0 p{1};
+    for (int i = 0; i < 10; ++i) {
+        p = p * (x + 2 * y - z / 3 + 1);
+    }
+    // Few groups: the products are computed serially.
+    BOOST_CHECK_EQUAL(p.subs<rational>({{"x", 3 / 7_q}}), term_by_term_subs<rational>(p, {{"x", 3 / 7_q}}));
+    BOOST_CHECK_EQUAL(p.subs<integer>({{"z", 0_z}}), term_by_term_subs<integer>(p, {{"z", 0_z}}));
+    // Many groups: the products are computed in parallel.
+    BOOST_CHECK_EQUAL(p.subs<rational>({{"x", 3 / 7_q}, {"y", -2 / 5_q}}),
+                      term_by_term_subs<rational>(p, {{"x", 3 / 7_q}, {"y", -2 / 5_q}}));
+    // Values which coincide for different exponents end up in the same group.
+    BOOST_CHECK_EQUAL(p.subs<int>({{"x", 1}, {"y", -1}}), term_by_term_subs<int>(p, {{"x", 1}, {"y", -1}}));
+    BOOST_CHECK_EQUAL(p.subs<int>({{"x", 1}, {"y", 1}, {"z", 1}}), piranha::pow(rational(11, 3), 10));
+    // Substitution with series, grouped via their hash.
+    BOOST_CHECK_EQUAL(p.subs<stype0>({{"x", w + 1}}), term_by_term_subs<stype0>(p, {{"x", w + 1}}));
+    BOOST_CHECK_EQUAL(p.subs<stype0>({{"x", w + 1}, {"y", w - z}}),
+                      term_by_term_subs<stype0>(p, {{"x", w + 1}, {"y", w - z}}));
+    BOOST_CHECK_EQUAL(stype0{}.subs<int>({{"x", 1}}), 0);
+    // Many groups with floating-point values: the result does not depend on the number of threads.
+    settings::set_n_threads(1u);
+    const auto d1 = p.subs<double>({{"x", .1}, {"y", -.3}});
+    settings::set_n_threads(4u);
+    BOOST_CHECK_EQUAL(p.subs<double>({{"x", .1}, {"y", -.3}}), d1);
+    settings::reset_n_threads();
+    // Subs on cf only.
+    using stype1 = g_series_type<stype0, new_monomial<int>>;
+    stype1 a{"a"}, b{"b"};
+    stype1 q{1};
+    for (int i = 0; i < 6; ++i) {
+        q = q * (stype1{x} * a + stype1{y} * b + stype1{x * y} * a * b + 1);
+    }
+    BOOST_CHECK_EQUAL(q.subs<rational>({{"x", 3 / 7_q}}), term_by_term_subs<rational>(q, {{"x", 3 / 7_q}}));
+    BOOST_CHECK_EQUAL(q.subs<integer>({{"x", 2_z}, {"y", -3_z}}),
+                      term_by_term_subs<integer>(q, {{"x", 2_z}, {"y", -3_z}}));
+    BOOST_CHECK_EQUAL(q.subs<stype0>({{"x", w + 1}}), term_by_term_subs<stype0>(q, {{"x", w + 1}}));
+}
+
 #if defined(PIRANHA_WITH_BOOST_S11N)
 
 BOOST_AUTO_TEST_CASE(subs_series_serialization_test)
@@ -263,7 +263,13 @@ BOOST_AUTO_TEST_CASE(thread_pool_test)
 #if !defined(__APPLE_CC__)
     BOOST_CHECK(thread_pool::enqueue(0, []() { return bound_proc(); }).get().first == false);
     thread_pool::set_binding(true);
-    BOOST_CHECK(thread_pool::enqueue(0, []() { return bound_proc(); }).get() == std::make_pair(true, 0u));
+    // The threads are bound to the processors in NUMA order.
+    const auto procs = runtime_info::get_numa_proc_order();
+    BOOST_CHECK(thread_pool::enqueue(0, []() { return bound_proc(); }).get()
+                == std::make_pair(true, procs.empty() ? 0u : procs[0]));
+    for (unsigned i = 0u; i < thread_pool::size() && i < procs.size(); ++i) {
+        BOOST_CHECK(thread_pool::enqueue(i, []() { return bound_proc(); }).get() == std::make_pair(true, procs[i]));
+    }
     BOOST_CHECK_EQUAL(thread_pool::get_binding(), true);
     thread_pool::set_binding(false);
     BOOST_CHECK_EQUAL(thread_pool::get_binding(), false);
@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_MODULE tuning_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <limits>
 #include <stdexcept>
 #include <thread>
 
@@ -60,6 +61,9 @@ BOOST_AUTO_TEST_CASE(tuning_block_size_test)
     BOOST_CHECK_EQUAL(tuning::get_multiplication_block_size(), 256u);
     tuning::set_multiplication_block_size(512u);
     BOOST_CHECK_EQUAL(tuning::get_multiplication_block_size(), 512u);
+    // An explicit block size disables automatic tiling.
+    BOOST_CHECK(!tuning::get_multiplication_auto_tiling());
+    tuning::set_multiplication_auto_tiling(true);
     std::thread t1([]() noexcept {
         while (tuning::get_multiplication_block_size() != 1024u) {
         }
@@ -67,10 +71,32 @@ BOOST_AUTO_TEST_CASE(tuning_block_size_test)
     std::thread t2([]() { tuning::set_multiplication_block_size(1024u); });
     t1.join();
     t2.join();
+    tuning::set_multiplication_auto_tiling(true);
     BOOST_CHECK_THROW(tuning::set_multiplication_block_size(8000u), std::invalid_argument);
     BOOST_CHECK_EQUAL(tuning::get_multiplication_block_size(), 1024u);
+    BOOST_CHECK(tuning::get_multiplication_auto_tiling());
+    tuning::set_multiplication_block_size(512u);
     tuning::reset_multiplication_block_size();
     BOOST_CHECK_EQUAL(tuning::get_multiplication_block_size(), 256u);
+    BOOST_CHECK(tuning::get_multiplication_auto_tiling());
+}
+
+BOOST_AUTO_TEST_CASE(tuning_auto_tiling_test)
+{
+    BOOST_CHECK(tuning::get_multiplication_auto_tiling());
+    tuning::set_multiplication_auto_tiling(false);
+    BOOST_CHECK(!tuning::get_multiplication_auto_tiling());
+    std::thread t1([]() noexcept {
+        while (!tuning::get_multiplication_auto_tiling()) {
+        }
+    });
+    std::thread t2([]() { tuning::set_multiplication_auto_tiling(true); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK(tuning::get_multiplication_auto_tiling());
+    tuning::set_multiplication_auto_tiling(false);
+    tuning::reset_multiplication_auto_tiling();
+    BOOST_CHECK(tuning::get_multiplication_auto_tiling());
 }
 
 BOOST_AUTO_TEST_CASE(tuning_estimation_threshold_test)
@@ -89,3 +115,112 @@ BOOST_AUTO_TEST_CASE(tuning_estimation_threshold_test)
     tuning::reset_estimate_threshold();
     BOOST_CHECK_EQUAL(tuning::get_estimate_threshold(), 200u);
 }
+
+BOOST_AUTO_TEST_CASE(tuning_estimate_cache_test)
+{
+    BOOST_CHECK(!tuning::get_estimate_cache());
+    tuning::set_estimate_cache(true);
+    BOOST_CHECK(tuning::get_estimate_cache());
+    std::thread t1([]() noexcept {
+        while (tuning::get_estimate_cache()) {
+        }
+    });
+    std::thread t2([]() { tuning::set_estimate_cache(false); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK(!tuning::get_estimate_cache());
+    tuning::set_estimate_cache(true);
+    tuning::reset_estimate_cache();
+    BOOST_CHECK(!tuning::get_estimate_cache());
+}
+
+BOOST_AUTO_TEST_CASE(tuning_memory_limit_test)
+{
+    BOOST_CHECK_EQUAL(tuning::get_multiplication_memory_limit(), std::numeric_limits<unsigned long long>::max());
+    tuning::set_multiplication_memory_limit(1024u);
+    BOOST_CHECK_EQUAL(tuning::get_multiplication_memory_limit(), 1024u);
+    std::thread t1([]() noexcept {
+        while (tuning::get_multiplication_memory_limit() != 4096u) {
+        }
+    });
+    std::thread t2([]() { tuning::set_multiplication_memory_limit(4096u); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK_THROW(tuning::set_multiplication_memory_limit(0u), std::invalid_argument);
+    BOOST_CHECK_EQUAL(tuning::get_multiplication_memory_limit(), 4096u);
+    tuning::reset_multiplication_memory_limit();
+    BOOST_CHECK_EQUAL(tuning::get_multiplication_memory_limit(), std::numeric_limits<unsigned long long>::max());
+}
+
+BOOST_AUTO_TEST_CASE(tuning_prefetch_distance_test)
+{
+    BOOST_CHECK_EQUAL(tuning::get_prefetch_distance(), 16u);
+    tuning::set_prefetch_distance(0u);
+    BOOST_CHECK_EQUAL(tuning::get_prefetch_distance(), 0u);
+    std::thread t1([]() noexcept {
+        while (tuning::get_prefetch_distance() != 32u) {
+        }
+    });
+    std::thread t2([]() { tuning::set_prefetch_distance(32u); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK_THROW(tuning::set_prefetch_distance(tuning::get_max_prefetch_distance() + 1u), std::invalid_argument);
+    BOOST_CHECK_EQUAL(tuning::get_prefetch_distance(), 32u);
+    tuning::set_prefetch_distance(tuning::get_max_prefetch_distance());
+    BOOST_CHECK_EQUAL(tuning::get_prefetch_distance(), tuning::get_max_prefetch_distance());
+    tuning::reset_prefetch_distance();
+    BOOST_CHECK_EQUAL(tuning::get_prefetch_distance(), 16u);
+}
+
+BOOST_AUTO_TEST_CASE(tuning_multimodular_test)
+{
+    BOOST_CHECK(!tuning::get_multimodular_multiplication());
+    tuning::set_multimodular_multiplication(true);
+    BOOST_CHECK(tuning::get_multimodular_multiplication());
+    std::thread t1([]() noexcept {
+        while (tuning::get_multimodular_multiplication()) {
+        }
+    });
+    std::thread t2([]() { tuning::set_multimodular_multiplication(false); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK(!tuning::get_multimodular_multiplication());
+    tuning::set_multimodular_multiplication(true);
+    tuning::reset_multimodular_multiplication();
+    BOOST_CHECK(!tuning::get_multimodular_multiplication());
+}
+
+BOOST_AUTO_TEST_CASE(tuning_node_arena_test)
+{
+    BOOST_CHECK(!tuning::get_node_arena());
+    tuning::set_node_arena(true);
+    BOOST_CHECK(tuning::get_node_arena());
+    std::thread t1([]() noexcept {
+        while (tuning::get_node_arena()) {
+        }
+    });
+    std::thread t2([]() { tuning::set_node_arena(false); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK(!tuning::get_node_arena());
+    tuning::set_node_arena(true);
+    tuning::reset_node_arena();
+    BOOST_CHECK(!tuning::get_node_arena());
+}
+
+BOOST_AUTO_TEST_CASE(tuning_pow_strategy_test)
+{
+    BOOST_CHECK(tuning::get_pow_strategy() == pow_strategy::cached);
+    tuning::set_pow_strategy(pow_strategy::binary);
+    BOOST_CHECK(tuning::get_pow_strategy() == pow_strategy::binary);
+    std::thread t1([]() noexcept {
+        while (tuning::get_pow_strategy() == pow_strategy::binary) {
+        }
+    });
+    std::thread t2([]() { tuning::set_pow_strategy(pow_strategy::multinomial); });
+    t1.join();
+    t2.join();
+    BOOST_CHECK(tuning::get_pow_strategy() == pow_strategy::multinomial);
+    tuning::reset_pow_strategy();
+    BOOST_CHECK(tuning::get_pow_strategy() == pow_strategy::cached);
+}